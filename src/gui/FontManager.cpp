@@ -40,6 +40,8 @@ FontManager::FontManager()
 
 FontManager::~FontManager()
 {
+    for(GlyphCaches::iterator i = glyphCaches.begin(); i != glyphCaches.end(); ++i)
+        delete i->second;
     for(Fonts::iterator i = fonts.begin(); i != fonts.end(); ++i)
         TTF_CloseFont(i->second);
 }
@@ -106,6 +108,19 @@ FontManager::getFont(Style style)
     return font;
 }
 
+GlyphCache*
+FontManager::getGlyphCache(Style style)
+{
+    TTF_Font* font = getFont(style);
+    GlyphCaches::iterator i = glyphCaches.find(font);
+    if(i != glyphCaches.end())
+        return i->second;
+
+    GlyphCache* glyphCache = new GlyphCache(font);
+    glyphCaches.insert(std::make_pair(font, glyphCache));
+    return glyphCache;
+}
+
 
 /** @file gui/FontManager.cpp */
 
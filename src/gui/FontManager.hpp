@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #define __FONTMANAGER_HPP__
 
 #include "Style.hpp"
+#include "GlyphCache.hpp"
 #include <SDL_ttf.h>
 
 /**
@@ -37,6 +38,8 @@ public:
     ~FontManager();
 
     TTF_Font* getFont(Style style);
+    /** glyphs of the font for style, don't delete it */
+    GlyphCache* getGlyphCache(Style style);
 
 private:
     struct FontInfo {
@@ -68,6 +71,8 @@ private:
 
     typedef std::map<FontInfo, TTF_Font*> Fonts;
     Fonts fonts;
+    typedef std::map<TTF_Font*, GlyphCache*> GlyphCaches;
+    GlyphCaches glyphCaches;
 };
 
 extern FontManager* fontManager;
@@ -0,0 +1,199 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file GlyphCache.cpp
+ */
+
+#include <config.h>
+
+#include "GlyphCache.hpp"
+
+#include <stdexcept>
+
+GlyphCache::GlyphCache(TTF_Font* font)
+    : font(font)
+{
+    height = TTF_FontHeight(font);
+}
+
+GlyphCache::~GlyphCache()
+{
+}
+
+void
+GlyphCache::decodeUTF8(const std::string& text, std::vector<Uint16>& chars)
+{
+    chars.clear();
+    chars.reserve(text.size());
+    for(size_t i = 0; i < text.size(); ) {
+        Uint8 c = text[i];
+        Uint32 ch;
+        int follow;
+        if(c < 0x80) {
+            ch = c;
+            follow = 0;
+        } else if((c & 0xE0) == 0xC0) {
+            ch = c & 0x1F;
+            follow = 1;
+        } else if((c & 0xF0) == 0xE0) {
+            ch = c & 0x0F;
+            follow = 2;
+        } else if((c & 0xF8) == 0xF0) {
+            ch = c & 0x07;
+            follow = 3;
+        } else {
+            // stray continuation byte
+            ++i;
+            continue;
+        }
+        ++i;
+        for( ; follow > 0 && i < text.size()
+                && (text[i] & 0xC0) == 0x80; --follow, ++i)
+            ch = (ch << 6) | (text[i] & 0x3F);
+        // SDL_ttf only knows UCS-2
+        if(ch > 0xFFFF)
+            ch = 0xFFFD;
+        chars.push_back((Uint16) ch);
+    }
+}
+
+void
+GlyphCache::loadGlyph(Uint16 ch, Glyph& glyph)
+{
+    glyph.loaded = true;
+    int minx, maxx, miny, maxy;
+    if(TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &glyph.advance) < 0)
+        return;
+
+    // render the single glyph the way SDL_ttf renders it inside a text
+    char utf8[4];
+    if(ch < 0x80) {
+        utf8[0] = (char) ch;
+        utf8[1] = 0;
+    } else if(ch < 0x800) {
+        utf8[0] = (char) (0xC0 | (ch >> 6));
+        utf8[1] = (char) (0x80 | (ch & 0x3F));
+        utf8[2] = 0;
+    } else {
+        utf8[0] = (char) (0xE0 | (ch >> 12));
+        utf8[1] = (char) (0x80 | ((ch >> 6) & 0x3F));
+        utf8[2] = (char) (0x80 | (ch & 0x3F));
+        utf8[3] = 0;
+    }
+    SDL_Color white = { 255, 255, 255, 0 };
+    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, utf8, white);
+    if(surface == 0)
+        return; // glyphs without width, like some spaces
+
+    glyph.offset = minx < 0 ? minx : 0;
+    glyph.width = surface->w;
+    glyph.pixels = atlas.size();
+    atlas.resize(atlas.size() + glyph.width * height, 0);
+
+    SDL_LockSurface(surface);
+    int rows = surface->h < height ? surface->h : height;
+    for(int y = 0; y < rows; ++y) {
+        Uint32* src = (Uint32*) ((Uint8*) surface->pixels + y * surface->pitch);
+        Uint8* dst = &atlas[glyph.pixels + y * glyph.width];
+        for(int x = 0; x < glyph.width; ++x) {
+            Uint8 r, g, b, a;
+            SDL_GetRGBA(src[x], surface->format, &r, &g, &b, &a);
+            dst[x] = a;
+        }
+    }
+    SDL_UnlockSurface(surface);
+    SDL_FreeSurface(surface);
+}
+
+const GlyphCache::Glyph&
+GlyphCache::getGlyph(Uint16 ch)
+{
+    Glyph& glyph = ch < 256 ? latin1[ch] : glyphs[ch];
+    if(!glyph.loaded)
+        loadGlyph(ch, glyph);
+    return glyph;
+}
+
+void
+GlyphCache::extent(const std::vector<Uint16>& chars, int& left, int& right)
+{
+    int pen = 0;
+    left = right = 0;
+    for(size_t i = 0; i < chars.size(); ++i) {
+        const Glyph& glyph = getGlyph(chars[i]);
+        int end = glyph.offset + glyph.width;
+        if(end < glyph.advance)
+            end = glyph.advance;
+        if(pen + glyph.offset < left)
+            left = pen + glyph.offset;
+        if(pen + end > right)
+            right = pen + end;
+        pen += glyph.advance;
+    }
+}
+
+void
+GlyphCache::size(const std::string& text, int* w, int* h)
+{
+    std::vector<Uint16> chars;
+    decodeUTF8(text, chars);
+    int left, right;
+    extent(chars, left, right);
+    *w = right - left;
+    *h = height;
+}
+
+SDL_Surface*
+GlyphCache::render(const std::string& text, SDL_Color color)
+{
+    std::vector<Uint16> chars;
+    decodeUTF8(text, chars);
+    int left, right;
+    extent(chars, left, right);
+    if(right - left <= 0)
+        return 0;
+
+    // same pixel format as TTF_RenderUTF8_Blended
+    SDL_Surface* surface = SDL_CreateRGBSurface(SDL_SWSURFACE,
+            right - left, height, 32,
+            0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000);
+    if(surface == 0)
+        throw std::runtime_error("Out of memory when rendering text");
+
+    Uint32 rgb = (color.r << 16) | (color.g << 8) | color.b;
+    SDL_LockSurface(surface);
+    int pen = -left;
+    for(size_t i = 0; i < chars.size(); ++i) {
+        const Glyph& glyph = getGlyph(chars[i]);
+        for(int y = 0; glyph.width > 0 && y < height; ++y) {
+            Uint32* dst = (Uint32*) ((Uint8*) surface->pixels + y * surface->pitch)
+                + pen + glyph.offset;
+            const Uint8* src = &atlas[glyph.pixels + y * glyph.width];
+            for(int x = 0; x < glyph.width; ++x) {
+                // overlapping glyphs keep the stronger coverage
+                if(src[x] > (dst[x] >> 24))
+                    dst[x] = rgb | (src[x] << 24);
+            }
+        }
+        pen += glyph.advance;
+    }
+    SDL_UnlockSurface(surface);
+    return surface;
+}
+
+
+/** @file gui/GlyphCache.cpp */
@@ -0,0 +1,79 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file GlyphCache.hpp
+ */
+
+#ifndef __GLYPHCACHE_HPP__
+#define __GLYPHCACHE_HPP__
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @class GlyphCache
+ * @brief Rendered glyphs and their metrics for one font, size and style.
+ *
+ * Every glyph is rasterized by SDL_ttf once, its coverage is kept in an
+ * atlas shared by all glyphs of the font. Text is then measured from the
+ * cached advances and composed from the atlas without calling SDL_ttf.
+ * Kerning is not applied.
+ */
+class GlyphCache
+{
+public:
+    GlyphCache(TTF_Font* font);
+    ~GlyphCache();
+
+    /** width and height of text, like TTF_SizeUTF8 */
+    void size(const std::string& text, int* w, int* h);
+    /**
+     * Render text in color onto a new 32 bit surface with alpha channel,
+     * like TTF_RenderUTF8_Blended. Returns 0 for text without width.
+     */
+    SDL_Surface* render(const std::string& text, SDL_Color color);
+
+private:
+    struct Glyph
+    {
+        Glyph() : loaded(false), advance(0), offset(0), width(0), pixels(0) {}
+        bool loaded;
+        int advance;
+        int offset;     //left edge of the coverage relative to the pen
+        int width;      //the coverage is width x height pixels
+        size_t pixels;  //index of the coverage in atlas
+    };
+
+    const Glyph& getGlyph(Uint16 ch);
+    void loadGlyph(Uint16 ch, Glyph& glyph);
+    //left and right edge of text relative to the starting pen position
+    void extent(const std::vector<Uint16>& chars, int& left, int& right);
+    static void decodeUTF8(const std::string& text, std::vector<Uint16>& chars);
+
+    TTF_Font* font;
+    int height;
+    Glyph latin1[256];
+    std::map<Uint16, Glyph> glyphs; //everything beyond latin1
+    std::vector<Uint8> atlas;       //8 bit coverage of all glyphs
+};
+
+#endif
+
+/** @file gui/GlyphCache.hpp */
@@ -21,6 +21,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include <SDL_opengl.h>
 
+bool TextureGL::detached = false;
+
 TextureGL::TextureGL(GLuint newhandle)
     : handle(newhandle)
 {
@@ -28,6 +30,8 @@ TextureGL::TextureGL(GLuint newhandle)
 
 TextureGL::~TextureGL()
 {
+    if(detached)
+        return;
     GLuint handles[1] = { handle };
     glDeleteTextures(1, handles);
 }
@@ -37,6 +37,12 @@ public:
         return height;
     }
 
+    /**
+     * Set in a forked process, which shares the GL context with its parent.
+     * Its textures are left alone then instead of being deleted.
+     */
+    static bool detached;
+
 private:
     friend class PainterGL;
     friend class TextureManagerGL;
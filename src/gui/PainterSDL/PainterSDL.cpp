@@ -37,17 +37,125 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #endif
 
 PainterSDL::PainterSDL(SDL_Surface* _target)
-    : target(_target)
+    : target(_target), banded(false), bandMutex(0)
 {
 }
 
 PainterSDL::PainterSDL(TextureSDL* texture)
-    : target(texture->surface)
+    : target(texture->surface), banded(false), bandMutex(0)
+{
+}
+
+PainterSDL::PainterSDL(SDL_Surface* _target, SDL_mutex* mutex,
+        const SDL_Rect& _band)
+    : target(_target), banded(true), band(_band), bandLimit(_band),
+      bandMutex(mutex)
 {
 }
 
 PainterSDL::~PainterSDL()
 {
+    if(!banded && bandMutex)
+    {   SDL_DestroyMutex(bandMutex);}
+}
+
+//intersect rect with clip, returns false if nothing is left
+static bool clipRect(SDL_Rect& rect, const SDL_Rect& clip)
+{
+    int x1 = rect.x > clip.x ? rect.x : clip.x;
+    int y1 = rect.y > clip.y ? rect.y : clip.y;
+    int x2 = rect.x + rect.w < clip.x + clip.w ? rect.x + rect.w : clip.x + clip.w;
+    int y2 = rect.y + rect.h < clip.y + clip.h ? rect.y + rect.h : clip.y + clip.h;
+    if(x2 <= x1 || y2 <= y1)
+    {   return false;}
+    rect.x = x1;
+    rect.y = y1;
+    rect.w = x2 - x1;
+    rect.h = y2 - y1;
+    return true;
+}
+
+/*
+ * SDL_LowerBlit (re)creates the blit mapping of a surface whenever it is
+ * blitted to another target. Do that once under the lock, so band painters
+ * never modify a shared surface while blitting.
+ */
+void
+PainterSDL::mapSurface(SDL_Surface* surface,
+        std::atomic<SDL_Surface*>& mappedTarget)
+{
+    if(mappedTarget == target)
+    {   return;}
+    SDL_Rect empty;
+    empty.x = 0;
+    empty.y = 0;
+    empty.w = 0;
+    empty.h = 0;
+    SDL_Rect dempty = empty;
+    SDL_LowerBlit(surface, &empty, target, &dempty);
+    mappedTarget = target;
+}
+
+void
+PainterSDL::blit(SDL_Surface* surface, std::atomic<SDL_Surface*>& mappedTarget,
+        SDL_Rect& drect)
+{
+    if(!banded)
+    {
+        SDL_BlitSurface(surface, 0, target, &drect);
+        //the mapping now belongs to target or is unchanged
+        if(mappedTarget != target)
+        {   mappedTarget = NULL;}
+        return;
+    }
+
+    drect.w = surface->w;
+    drect.h = surface->h;
+    SDL_Rect srect = drect;
+    if(!clipRect(drect, band))
+    {   return;}
+    srect.x = drect.x - srect.x;
+    srect.y = drect.y - srect.y;
+    srect.w = drect.w;
+    srect.h = drect.h;
+
+    if(mappedTarget != target || SDL_MUSTLOCK(surface))
+    {
+        SDL_LockMutex(bandMutex);
+        mapSurface(surface, mappedTarget);
+        //locking a surface isn't threadsafe either
+        if(SDL_MUSTLOCK(surface))
+        {
+            SDL_LowerBlit(surface, &srect, target, &drect);
+            SDL_UnlockMutex(bandMutex);
+            return;
+        }
+        SDL_UnlockMutex(bandMutex);
+    }
+    SDL_LowerBlit(surface, &srect, target, &drect);
+}
+
+/*
+ * SDL_gfx primitives clip against the clip rectangle of target and some
+ * of them use static buffers, so band painters draw them one at a time.
+ */
+void
+PainterSDL::lockGfx()
+{
+    if(!banded)
+    {   return;}
+    SDL_LockMutex(bandMutex);
+    SDL_GetClipRect(target, &savedClip);
+    SDL_SetClipRect(target, &band);
+}
+
+void
+PainterSDL::unlockGfx()
+{
+    if(!banded)
+    {   return;}
+    SDL_SetClipRect(target, &savedClip);
+    SDL_UnlockMutex(bandMutex);
 }
 
 //ERM  this function seems to account for SOME of the slowdown
@@ -72,7 +180,7 @@ PainterSDL::drawTexture(const Texture* texture, const Vector2& pos)
     SDL_Rect drect;
     drect.x = lrint(screenpos.x);
     drect.y = lrint(screenpos.y);
-    SDL_BlitSurface(textureSDL->surface, 0, target, &drect);
+    blit(textureSDL->surface, textureSDL->mappedTarget, drect);
 }
 
 //RectIntersection checks to see if two SDL_Rects intersect each other
@@ -135,7 +243,11 @@ PainterSDL::drawStretchTexture(Texture* texture, const Rect2D& rect)
     drect.w = lroundf(rect.getWidth()) /*+ 1*/;
     drect.h = lroundf(rect.getHeight()) /*+ 1*/;
 
-    SDL_GetClipRect(target, &cliprect);  //get the current cliprect for the target
+    //get the current cliprect for the target
+    if(banded)
+    {   cliprect = band;}
+    else
+    {   SDL_GetClipRect(target, &cliprect);}
 
     //This intersection test would not normally be necessary since SDL_BlitSurface
     //  will only blit to the cliprect and skip others.
@@ -150,11 +262,20 @@ PainterSDL::drawStretchTexture(Texture* texture, const Rect2D& rect)
     double zoomy = drect.h / textureSDL->getHeight();
 
     //This code caches zoomed surfaces so that they do not need to be zoomed each blit
+    if(banded)
+    {   SDL_LockMutex(bandMutex);}
     if(textureSDL->zoomSurface == NULL || zoomx != textureSDL->zoomx || zoomy != textureSDL->zoomy)
     {
         textureSDL->setZoomSurface(zoomSurface(textureSDL->surface, zoomx, zoomy, SMOOTHING_OFF), zoomx, zoomy);
     }
-    SDL_BlitSurface(textureSDL->zoomSurface, 0, target, &drect);
+    if(banded)
+    {
+        //all bands use the same zoom, so the cached surface stays valid
+        //until the bands are done
+        mapSurface(textureSDL->zoomSurface, textureSDL->zoomMappedTarget);
+        SDL_UnlockMutex(bandMutex);
+    }
+    blit(textureSDL->zoomSurface, textureSDL->zoomMappedTarget, drect);
 
 /*
     //This was the original code that would zoom a surface, blit it, and then free it.
@@ -177,8 +298,10 @@ PainterSDL::fillPolygon(int numberPoints, const Vector2* points)
          vx[ i ] = (int) screenpos.x;
          vy[ i ] = (int) screenpos.y;
     }
+    lockGfx();
     filledPolygonRGBA( target, vx, vy, numberPoints,
             fillColor.r, fillColor.g, fillColor.b, fillColor.a);
+    unlockGfx();
     delete[] vx;
     delete[] vy;
 }
@@ -194,8 +317,10 @@ PainterSDL::drawPolygon(int numberPoints, const Vector2* points)
          vx[ i ] = (int) screenpos.x;
          vy[ i ] = (int) screenpos.y;
     }
+    lockGfx();
     aapolygonRGBA( target, vx, vy, numberPoints,
             lineColor.r, lineColor.g, lineColor.b, lineColor.a);
+    unlockGfx();
     delete[] vx;
     delete[] vy;
 }
@@ -205,9 +330,11 @@ PainterSDL::drawLine( const Vector2 pointA, const Vector2 pointB )
 {
     Vector2 screenpos = transform.apply( pointA );
     Vector2 screenpos2 = transform.apply( pointB );
+    lockGfx();
     aalineRGBA( target, (int) screenpos.x, (int) screenpos.y,
             (int) screenpos2.x, (int) screenpos2.y,
       lineColor.r, lineColor.g, lineColor.b, lineColor.a);
+    unlockGfx();
 
 
 }
@@ -217,9 +344,11 @@ PainterSDL::fillRectangle(const Rect2D& rect)
 {
     Vector2 screenpos = transform.apply(rect.p1);
     Vector2 screenpos2 = transform.apply(rect.p2);
+    lockGfx();
     boxRGBA(target, (int) screenpos.x, (int) screenpos.y,
             (int) screenpos2.x, (int) screenpos2.y,
             fillColor.r, fillColor.g, fillColor.b, fillColor.a);
+    unlockGfx();
 }
 
 void
@@ -227,9 +356,11 @@ PainterSDL::drawRectangle(const Rect2D& rect)
 {
     Vector2 screenpos = transform.apply(rect.p1);
     Vector2 screenpos2 = transform.apply(rect.p2);
+    lockGfx();
     rectangleRGBA(target, (int) screenpos.x, (int) screenpos.y,
             (int) screenpos2.x, (int) screenpos2.y,
             lineColor.r, lineColor.g, lineColor.b, lineColor.a);
+    unlockGfx();
 }
 
 void
@@ -272,12 +403,24 @@ PainterSDL::setClipRectangle(const Rect2D& rect)
     cliprect.y = (int) screenpos.y;
     cliprect.w = (int) rect.getWidth();
     cliprect.h = (int) rect.getHeight();
+    if(banded)
+    {
+        band = bandLimit;
+        if(!clipRect(band, cliprect))
+        {   band.w = band.h = 0;}
+        return;
+    }
     SDL_SetClipRect(target, &cliprect);
 }
 
 void
 PainterSDL::clearClipRectangle()
 {
+    if(banded)
+    {
+        band = bandLimit;
+        return;
+    }
     SDL_SetClipRect(target, 0);
 }
 
@@ -290,6 +433,31 @@ PainterSDL::createTexturePainter(Texture* texture)
     return new PainterSDL(textureSDL);
 }
 
+PainterSDL*
+PainterSDL::createBandPainter(const Rect2D& rect)
+{
+    if(banded || SDL_MUSTLOCK(target))
+    {   return 0;}
+    if(!bandMutex)
+    {   bandMutex = SDL_CreateMutex();}
+
+    Vector2 screenpos = transform.apply(rect.p1);
+    SDL_Rect bandrect, cliprect;
+    bandrect.x = lroundf(screenpos.x);
+    bandrect.y = lroundf(screenpos.y);
+    bandrect.w = lroundf(rect.getWidth());
+    bandrect.h = lroundf(rect.getHeight());
+    SDL_GetClipRect(target, &cliprect);
+    if(!clipRect(bandrect, cliprect))
+    {   bandrect.w = bandrect.h = 0;}
+
+    PainterSDL* bandPainter = new PainterSDL(target, bandMutex, bandrect);
+    bandPainter->transform = transform;
+    bandPainter->fillColor = fillColor;
+    bandPainter->lineColor = lineColor;
+    return bandPainter;
+}
+
 
 /** @file gui/PainterSDL/PainterSDL.cpp */
 
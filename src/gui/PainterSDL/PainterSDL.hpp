@@ -19,6 +19,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #define __PAINTERSDL_HPP__
 
 #include <SDL.h>
+#include <SDL_thread.h>
+#include <atomic>
 #include <vector>
 #include "gui/Rect2D.hpp"
 #include "gui/TextureManager.hpp"
@@ -58,8 +60,25 @@ public:
 
     Painter* createTexturePainter(Texture* texture);
 
+    /**
+     * Create a painter that only draws into rect (in current coordinates)
+     * of the target. Band painters of one parent may draw from different
+     * threads at the same time as long as their rects don't overlap.
+     * Returns 0 if the target has to be locked for blitting. Band painters
+     * have to be deleted before their parent.
+     */
+    PainterSDL* createBandPainter(const Rect2D& rect);
+
 private:
     PainterSDL(TextureSDL* texture);
+    PainterSDL(SDL_Surface* target, SDL_mutex* mutex, const SDL_Rect& band);
+
+    void blit(SDL_Surface* surface, std::atomic<SDL_Surface*>& mappedTarget,
+            SDL_Rect& drect);
+    void mapSurface(SDL_Surface* surface,
+            std::atomic<SDL_Surface*>& mappedTarget);
+    void lockGfx();
+    void unlockGfx();
 
     class Transform
     {
@@ -79,6 +98,14 @@ private:
 
     SDL_Surface* target;
     Color fillColor,lineColor;
+
+    // band painters clip on their own, because the clip rectangle of the
+    // target is shared. bandMutex serializes everything that touches
+    // shared state of target or the textures.
+    bool banded;
+    SDL_Rect band, bandLimit;
+    SDL_mutex* bandMutex;
+    SDL_Rect savedClip;
 };
 
 #endif
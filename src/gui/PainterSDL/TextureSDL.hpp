@@ -20,6 +20,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 #include "gui/Texture.hpp"
 #include <SDL.h>
+#include <atomic>
 
 /**
  * Wrapper around a pixmap. Texture have to be created by the TextureManager
@@ -47,6 +48,7 @@ public:
         zoomSurface = zs;
         zoomx = zx;
         zoomy = zy;
+        zoomMappedTarget = NULL;
     }
 private:
     friend class PainterSDL;
@@ -55,11 +57,16 @@ private:
         : surface(_surface)
     {
         zoomSurface = NULL;
+        mappedTarget = NULL;
+        zoomMappedTarget = NULL;
     }
 
     SDL_Surface* surface;
     SDL_Surface* zoomSurface;
     double zoomx,zoomy;
+    // targets SDL has set up blit mappings for, see PainterSDL::mapSurface
+    mutable std::atomic<SDL_Surface*> mappedTarget;
+    mutable std::atomic<SDL_Surface*> zoomMappedTarget;
 };
 
 #endif
@@ -269,6 +269,7 @@ Paragraph::resize(float width, float height)
     const TextSpan* span = *i;
     const std::string* text = &(span->text);
     TTF_Font* font = fontManager->getFont(span->style);
+    GlyphCache* glyphs = fontManager->getGlyphCache(span->style);
     std::string::size_type p = 0;
     std::string::size_type linestart = 0;
     lineheight = TTF_FontHeight(font);
@@ -298,7 +299,7 @@ Paragraph::resize(float width, float height)
 
         // check line size...
         int render_width, render_height;
-        TTF_SizeUTF8(font, line.c_str(), &render_width, &render_height);
+        glyphs->size(line, &render_width, &render_height);
 
         bool render = false;
         bool linefeed = false;
@@ -337,8 +338,8 @@ Paragraph::resize(float width, float height)
 
             // render span
             //printf("Rendering: '%s'.\n", line.c_str());
-            SDL_Surface* spansurface = TTF_RenderUTF8_Blended(font,
-                    line.c_str(), span->style.text_color.getSDLColor());
+            SDL_Surface* spansurface = glyphs->render(line,
+                    span->style.text_color.getSDLColor());
             if(spansurface == 0) {
                 std::stringstream msg;
                 msg << "Error rendering text: " << SDL_GetError();
@@ -456,6 +457,7 @@ Paragraph::resize(float width, float height)
             span = *i;
             text = &(span->text);
             font = fontManager->getFont(span->style);
+            glyphs = fontManager->getGlyphCache(span->style);
             linestart = p = 0;
             line = "";
         }
@@ -543,9 +545,13 @@ Paragraph::event(const Event& event)
 void
 Paragraph::setText(const std::string& newtext)
 {
+    // many labels are set to the same text every day
+    if(!textspans.empty() && newtext == currentText)
+        return;
     Style spanStyle = style;
     spanStyle.toSpan();
     setText(newtext, spanStyle);
+    currentText = newtext;
 }
 
 std::string Paragraph::getText() const
@@ -564,6 +570,7 @@ Paragraph::setText(const std::string& newtext, const Style& style)
         delete *i;
 */
     textspans.clear();
+    currentText.clear();
 
     size_t span_end = newtext.find_first_of('\t',0);
     if(span_end != newtext.npos) // we have a tab
@@ -110,6 +110,8 @@ private:
     //TODO distinct Styles for paragraphs and styles
 
     Texture* texture;
+    // text of the last setText(text), it is not rendered again
+    std::string currentText;
 
     typedef std::vector<LinkRectangle> LinkRectangles;
     LinkRectangles linkrectangles;
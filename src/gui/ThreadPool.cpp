@@ -0,0 +1,166 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file ThreadPool.cpp
+ */
+
+#include <config.h>
+
+#include "ThreadPool.hpp"
+
+#include <iostream>
+#include <thread>
+
+ThreadPool::ThreadPool(int threads)
+{
+    job = 0;
+    jobData = 0;
+    jobCount = 0;
+    nextJob = 0;
+    pendingJobs = 0;
+    batch = 0;
+    stop = false;
+
+    mutex = SDL_CreateMutex();
+    wakeup = SDL_CreateCond();
+    finished = SDL_CreateCond();
+
+    if(threads <= 0)
+    {   threads = defaultThreadCount();}
+    //the calling thread takes part in every batch
+    for(int i = 1; i < threads; ++i)
+    {
+        SDL_Thread* thread = SDL_CreateThread(workerThread, this);
+        if(!thread)
+        {
+            std::cerr << "ThreadPool# Could not create worker thread: "
+                << SDL_GetError() << "\n";
+            break;
+        }
+        workers.push_back(thread);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    SDL_LockMutex(mutex);
+    stop = true;
+    SDL_CondBroadcast(wakeup);
+    SDL_UnlockMutex(mutex);
+
+    for(size_t i = 0; i < workers.size(); ++i)
+    {   SDL_WaitThread(workers[i], NULL);}
+
+    SDL_DestroyCond(finished);
+    SDL_DestroyCond(wakeup);
+    SDL_DestroyMutex(mutex);
+}
+
+int ThreadPool::defaultThreadCount()
+{
+    int cpus = std::thread::hardware_concurrency();
+    return cpus > 0 ? cpus : 1;
+}
+
+void ThreadPool::run(Job job, void** data, int count)
+{
+    if(count <= 0)
+    {   return;}
+    //no point in waking anybody up for a single job
+    if(workers.empty() || count == 1)
+    {
+        for(int i = 0; i < count; ++i)
+        {   job(data[i]);}
+        return;
+    }
+
+    SDL_LockMutex(mutex);
+    this->job = job;
+    jobData = data;
+    jobCount = count;
+    nextJob = 0;
+    pendingJobs = count;
+    ++batch;
+    SDL_CondBroadcast(wakeup);
+    SDL_UnlockMutex(mutex);
+
+    work();
+
+    SDL_LockMutex(mutex);
+    while(pendingJobs > 0)
+    {   SDL_CondWait(finished, mutex);}
+    this->job = 0;
+    jobData = 0;
+    jobCount = 0;
+    SDL_UnlockMutex(mutex);
+}
+
+void ThreadPool::work()
+{
+    SDL_LockMutex(mutex);
+    while(nextJob < jobCount)
+    {
+        int current = nextJob++;
+        Job currentJob = job;
+        void* currentData = jobData[current];
+        SDL_UnlockMutex(mutex);
+
+        currentJob(currentData);
+
+        SDL_LockMutex(mutex);
+        if(--pendingJobs == 0)
+        {   SDL_CondSignal(finished);}
+    }
+    SDL_UnlockMutex(mutex);
+}
+
+void ThreadPool::pause()
+{
+    //idle workers wait on wakeup, none of them can hold the mutex now
+    SDL_LockMutex(mutex);
+}
+
+void ThreadPool::resume()
+{
+    SDL_UnlockMutex(mutex);
+}
+
+//Static function to use with SDL_CreateThread
+int ThreadPool::workerThread(void* data)
+{
+    ThreadPool* pool = (ThreadPool*) data;
+    unsigned int seenBatch = 0;
+
+    SDL_LockMutex(pool->mutex);
+    while(!pool->stop)
+    {
+        if(pool->batch == seenBatch)
+        {
+            SDL_CondWait(pool->wakeup, pool->mutex);
+            continue;
+        }
+        seenBatch = pool->batch;
+        SDL_UnlockMutex(pool->mutex);
+        pool->work();
+        SDL_LockMutex(pool->mutex);
+    }
+    SDL_UnlockMutex(pool->mutex);
+    return 0;
+}
+
+
+/** @file gui/ThreadPool.cpp */
@@ -0,0 +1,80 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+/**
+ * @file ThreadPool.hpp
+ */
+
+#ifndef __THREADPOOL_HPP__
+#define __THREADPOOL_HPP__
+
+#include <SDL.h>
+#include <SDL_thread.h>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief A fixed set of SDL worker threads that process batches of jobs.
+ *
+ * run() hands out the jobs of one batch to the workers and to the calling
+ * thread and returns once all of them are done. Only one batch can be in
+ * flight at a time, so run() must not be called from inside a job.
+ */
+class ThreadPool
+{
+public:
+    typedef void (*Job)(void* data);
+
+    /** threads <= 0 selects defaultThreadCount() */
+    ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    /** number of threads working on a batch, including the caller */
+    int getThreadCount() const
+    {   return workers.size() + 1;}
+
+    /** call job(data[i]) for i in [0, count) and wait for completion */
+    void run(Job job, void** data, int count);
+
+    /** hold the workers while no batch runs, e.g. around fork() */
+    void pause();
+    void resume();
+
+    /** number of online CPUs, at least 1 */
+    static int defaultThreadCount();
+
+private:
+    static int workerThread(void* data);
+    //process jobs of the current batch until none are left
+    void work();
+
+    std::vector<SDL_Thread*> workers;
+    SDL_mutex* mutex;
+    SDL_cond* wakeup;   //signalled when a new batch starts or on shutdown
+    SDL_cond* finished; //signalled when the last job of a batch is done
+
+    Job job;
+    void** jobData;
+    int jobCount;
+    int nextJob;
+    int pendingJobs;
+    unsigned int batch; //counts batches so workers notice new ones
+    bool stop;
+};
+
+#endif
+
+/** @file gui/ThreadPool.hpp */
@@ -22,8 +22,10 @@ static const int MPS_PARAGRAPH_COUNT = 13;
 #define MPS_GLOBAL_FINANCE 0 /* Overall financial information */
 #define MPS_GLOBAL_OTHER_COSTS 1 /* More detailed financials */
 #define MPS_GLOBAL_HOUSING 2 /* Citywide population information */
+#define MPS_GLOBAL_TIME_COSTS 3 /* Simulation time per kind of construction */
+#define MPS_GLOBAL_MEMORY_COSTS 4 /* Memory per kind of construction */
 
-#define MPS_GLOBAL_STYLES 3 /* Number of global styles */
+#define MPS_GLOBAL_STYLES 5 /* Number of global styles */
 #define MPS_MAP_PAGES 2
 
 
@@ -67,6 +69,8 @@ extern int mps_map_page;
 void mps_global_finance(void);
 void mps_global_other_costs(void);
 void mps_global_housing(void);
+void mps_global_time_costs(void);
+void mps_global_memory_costs(void);
 void mps_right (int x, int y);
 
 
@@ -14,6 +14,7 @@ void refresh_population_text (void);
 
 void update_pbar (int pbar_num, int value, int month_flag);
 void update_pbars_monthly(void);
+int pbar_value (int pbar_num, int i); /* i-th value kept, oldest first */
 
 #define NUM_PBARS 15
 #define OLD_NUM_PBARS 9
@@ -49,7 +50,8 @@ struct pbar_st
     int diff;
 
     int data_size;
-    int data[PBAR_DATA_SIZE];
+    int data[PBAR_DATA_SIZE];   /* ring, a new month replaces the oldest */
+    int first;                  /* slot of the oldest value */
 };
 
 extern struct pbar_st pbars[NUM_PBARS];
@@ -48,12 +48,24 @@ Config::Config()
     useFullScreen = true;
     videoX = 1024;
     videoY = 768;
+    renderThreads = 0;
+    spriteCache = false;
+    textureMemory = 0;
 
     soundVolume = 100;
     musicVolume = 50;
     soundEnabled = true;
     musicEnabled = true;
     carsEnabled = true;
+    powerGrid = false;
+    tradeGraph = true;
+    sleeping = false;   //off until --compare shows no divergence
+    denseTrade = true;
+    groupCosts = false;
+    rewindMonths = 3;
+    rewindSnapshots = 16;
+    autosaveMonths = 1;
+    autosaveCompact = 24;
     restartOnChangeScreen = true;
 
     //#define MONTHGRAPH_W 120
@@ -143,6 +155,12 @@ void Config::load( const std::string& filename ){
                         useFullScreen = parseBool(value, false);
                     } else if(strcmp(name, "restartOnChangeScreen") == 0) {
                         restartOnChangeScreen = parseBool(value, true);
+                    } else if(strcmp(name, "renderThreads") == 0) {
+                        renderThreads = parseInt(value, 0, 0, 64);
+                    } else if(strcmp(name, "spriteCache") == 0) {
+                        spriteCache = parseBool(value, false);
+                    } else if(strcmp(name, "textureMemory") == 0) {
+                        textureMemory = parseInt(value, 0, 0, 65536);
                     } else if(strcmp(name, "WorldSideLen") == 0) {
                         world.len(parseInt(value, WORLD_SIDE_LEN, 50, 10000));
                     }else {
@@ -193,6 +211,24 @@ void Config::load( const std::string& filename ){
                         seed_compression = parseBool(value, true);
                     } else if(strcmp(name, "carsEnabled") == 0) {
                         carsEnabled = parseBool(value, true);
+                    } else if(strcmp(name, "powerGrid") == 0) {
+                        powerGrid = parseBool(value, false);
+                    } else if(strcmp(name, "tradeGraph") == 0) {
+                        tradeGraph = parseBool(value, true);
+                    } else if(strcmp(name, "sleeping") == 0) {
+                        sleeping = parseBool(value, false);
+                    } else if(strcmp(name, "denseTrade") == 0) {
+                        denseTrade = parseBool(value, true);
+                    } else if(strcmp(name, "groupCosts") == 0) {
+                        groupCosts = parseBool(value, false);
+                    } else if(strcmp(name, "rewindMonths") == 0) {
+                        rewindMonths = parseInt(value, 3, 0, 1200);
+                    } else if(strcmp(name, "rewindSnapshots") == 0) {
+                        rewindSnapshots = parseInt(value, 16, 1, 1000);
+                    } else if(strcmp(name, "autosaveMonths") == 0) {
+                        autosaveMonths = parseInt(value, 1, 0, 1200);
+                    } else if(strcmp(name, "autosaveCompact") == 0) {
+                        autosaveCompact = parseInt(value, 24, 1, 10000);
                     }else {
                         std::cerr << "Config::load# Unknown attribute '" << name;
                         std::cerr << "' in element '" << element << "' from " << filename << ".\n";
@@ -234,6 +270,9 @@ Config::save(){
     userconfig << "    <video x=\"" << videoX << "\" y=\"" << videoY << "\" useOpenGL=\""
         << (useOpenGL?"yes":"no") << "\" fullscreen=\"" << (useFullScreen?"yes":"no")
         << "\" restartOnChangeScreen=\"" << (restartOnChangeScreen?"yes":"no")
+        << "\" renderThreads=\"" << renderThreads
+        << "\" spriteCache=\"" << (spriteCache?"yes":"no")
+        << "\" textureMemory=\"" << textureMemory
         << "\" />\n";
     userconfig << "    <audio soundEnabled=\"" << (soundEnabled?"yes":"no")
         << "\" soundVolume=\"" << soundVolume << "\" \n";
@@ -246,6 +285,15 @@ Config::save(){
         << "\" binarySaveGames=\"" << (binary_mode?"yes":"no")
         << "\" seed_compression=\"" << (seed_compression?"yes":"no")
         << "\" carsEnabled=\"" << (carsEnabled?"yes":"no")
+        << "\" powerGrid=\"" << (powerGrid?"yes":"no")
+        << "\" tradeGraph=\"" << (tradeGraph?"yes":"no")
+        << "\" sleeping=\"" << (sleeping?"yes":"no")
+        << "\" denseTrade=\"" << (denseTrade?"yes":"no")
+        << "\" groupCosts=\"" << (groupCosts?"yes":"no")
+        << "\" rewindMonths=\"" << rewindMonths
+        << "\" rewindSnapshots=\"" << rewindSnapshots
+        << "\" autosaveMonths=\"" << autosaveMonths
+        << "\" autosaveCompact=\"" << autosaveCompact
         << "\" />\n";
     userconfig << "</configuration>\n";
 }
@@ -32,6 +32,12 @@ public:
     bool useFullScreen;
     bool restartOnChangeScreen;
     int videoX, videoY;
+    // threads drawing the map with SDL (0=one per cpu, 1=no threads)
+    int renderThreads;
+    // keep decoded sprites in the write directory for faster startup
+    bool spriteCache;
+    // MB of map textures to keep, textures are loaded when needed (0=all)
+    int textureMemory;
     int monthgraphW, monthgraphH;
 
     // sound volume 0..100 (0=silent)
@@ -41,6 +47,22 @@ public:
     bool soundEnabled;
     bool musicEnabled;
     bool carsEnabled;
+    // balance power per connected grid instead of trading it tile by tile
+    bool powerGrid;
+    // trade through the packed TradeGraph, let steady constructions skip
+    // trading (off by default) and keep dense commodity views, see
+    // replay --compare
+    bool tradeGraph;
+    bool sleeping;
+    bool denseTrade;
+    // account simulation time per kind of construction, see GroupCosts
+    bool groupCosts;
+    // months between snapshots to rewind to (0=none) and how many are kept
+    int rewindMonths;
+    int rewindSnapshots;
+    // months between autosaves (0=none) and autosaves before a full one
+    int autosaveMonths;
+    int autosaveCompact;
     //std::string lincityHome;
     int skipMonthsFast;
     // how fast is fast_time_for_year
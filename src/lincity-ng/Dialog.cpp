@@ -622,7 +622,7 @@ void Dialog::editMarket(){
     std::stringstream title;
     title << _("Market") << " ( " << pointX <<" , " << pointY << " )";
     p->setText( title.str() );
-    Market * market = static_cast <Market *> (world(pointX, pointY)->reportingConstruction);
+    Market * market = static_cast <Market *> (world(pointX, pointY)->reportingConstruction());
     CheckButton* cb;
     cb = getCheckButton( *myDialogComponent, "BuyJobs" );
     if( market->commodityRuleCount[Construction::STUFF_JOBS].take ) cb->check(); else cb->uncheck();
@@ -678,7 +678,7 @@ void Dialog::editPort(){
     }
     // set Dialog to Port-Data
     //int port_flags = world(pointX, pointY)->reportingConstruction->flags;
-    Port *port = dynamic_cast<Port *>(world(pointX, pointY)->reportingConstruction);
+    Port *port = dynamic_cast<Port *>(world(pointX, pointY)->reportingConstruction());
     Paragraph* p = getParagraph( *myDialogComponent, "DialogTitle" );
     std::stringstream title;
     title << _("Port") << " ( " << pointX <<" , " << pointY << " )";
@@ -714,7 +714,7 @@ void Dialog::editPort(){
 
 void Dialog::applyMarketButtonClicked( Button* ){
     CheckButton* cb;
-    Market * market = static_cast <Market *> (world(pointX, pointY)->construction);
+    Market * market = static_cast <Market *> (world(pointX, pointY)->construction());
     cb = getCheckButton( *myDialogComponent, "BuyJobs" );
     if( cb->state == CheckButton::STATE_CHECKED ){
         market->commodityRuleCount[Construction::STUFF_JOBS].take = true;
@@ -799,6 +799,7 @@ void Dialog::applyMarketButtonClicked( Button* ){
     } else {
         market->commodityRuleCount[Construction::STUFF_WASTE].give = false;
     }
+    journal.recordRules(market);
     mps_refresh();
     desktop->remove( myDialogComponent );
     blockingDialogIsOpen = false;
@@ -806,7 +807,7 @@ void Dialog::applyMarketButtonClicked( Button* ){
 }
 
 void Dialog::applyPortButtonClicked( Button* ){
-    Port *port = dynamic_cast<Port *>(world(pointX, pointY)->reportingConstruction);
+    Port *port = dynamic_cast<Port *>(world(pointX, pointY)->reportingConstruction());
     CheckButton* cb;
 
     cb = getCheckButton( *myDialogComponent, "BuyFood" );
@@ -903,6 +904,7 @@ void Dialog::applyPortButtonClicked( Button* ){
         port->commodityRuleCount[Construction::STUFF_STEEL].take = false;
         port->commodityRuleCount[Construction::STUFF_STEEL].give = false;
     }
+    journal.recordRules(port);
 
     desktop->remove( myDialogComponent );
     blockingDialogIsOpen = false;
@@ -911,7 +913,7 @@ void Dialog::applyPortButtonClicked( Button* ){
 
 void Dialog::okayLaunchRocketButtonClicked( Button* )
 {
-    static_cast<RocketPad*> (world(pointX, pointY)->reportingConstruction)-> launch_rocket();
+    static_cast<RocketPad*> (world(pointX, pointY)->reportingConstruction())-> launch_rocket();
     desktop->remove( myDialogComponent );
     blockingDialogIsOpen = false;
     unRegisterDialog();
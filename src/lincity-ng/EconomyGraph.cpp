@@ -17,6 +17,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 */
 #include <config.h>
 #include <iostream>
+#include <algorithm>
+#include <climits>
+#include <stdio.h>
 
 #include "EconomyGraph.hpp"
 
@@ -46,6 +49,17 @@ extern void ok_dial_box(const char *, int, const char *);
 
 EconomyGraph* economyGraphPtr = 0;
 
+static const char* phaseColors[ Profiler::PHASE_COUNT ] = {
+    "#FF8C00FF", //trade
+    "#228B22FF", //update
+    "#000000FF", //vehicles
+    "#8B4513FF", //ecology
+    "#FFFF00FF", //pollution
+    "#FF0000FF", //cover
+    "#800080FF", //pending requests
+    "#0000FFFF"  //render
+};
+
 EconomyGraph* getEconomyGraph()
 {
     return economyGraphPtr;
@@ -57,6 +71,15 @@ EconomyGraph::EconomyGraph(){
     for ( int i = 0; i < getConfig()->monthgraphW; i++) {
         fps[i] = 0;
     }
+    timingPage = false;
+    phaseTimes.assign( getConfig()->monthgraphW * Profiler::PHASE_COUNT, 0 );
+    phaseDays = 0;
+    for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+        labelTexturePhase[ i ] = 0;
+    }
+    labelTextureTiming = 0;
+    labelTexturePhaseStats = 0;
+    phaseStatsDirty = true;
     labelTextureMIN = 0;
     labelTexturePRT = 0;
     labelTextureMNY = 0;
@@ -85,6 +108,11 @@ EconomyGraph::~EconomyGraph(){
     delete labelTextureEconomy;
     delete labelTextureSustainability;
     delete labelTextureFPS;
+    for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+        delete labelTexturePhase[ i ];
+    }
+    delete labelTextureTiming;
+    delete labelTexturePhaseStats;
 }
 
 void EconomyGraph::parse( XmlReader& reader ){
@@ -143,54 +171,57 @@ void EconomyGraph::parse( XmlReader& reader ){
 
     labelXXX = TTF_RenderUTF8_Blended( font, _("Frames per Second:"), labelStyle.text_color.getSDLColor() );
     labelTextureFPS = texture_manager->create( labelXXX );
-}
 
-//see do_history_linegraph in oldgui/screen.cpp
-void EconomyGraph::updateData(){
-    int i;
-    float f;
-    int w = getConfig()->monthgraphW;
-    //thats the value oldgui uses, so saved data has same scale as new.
-    int h = 64; //MONTHGRAPH_H;
-
-    for (i = w - 1; i > 0; i--) {
-	    monthgraph_pop[i] = monthgraph_pop[i-1];
-	    monthgraph_ppool[i] = monthgraph_ppool[i-1];
-	    monthgraph_nojobs[i] = monthgraph_nojobs[i-1];
-	    monthgraph_starve[i] = monthgraph_starve[i-1];
+    //Labels for the timing page, in the order of Profiler::Phase
+    const char* phaseNames[ Profiler::PHASE_COUNT ] = {
+        _("Trade"), _("Update"), _("Vehicles"), _("Ecology"),
+        _("Pollution"), _("Cover"), _("Requests"), _("Render")
+    };
+    for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+        labelXXX = TTF_RenderUTF8_Blended( font, phaseNames[ i ], labelStyle.text_color.getSDLColor() );
+        labelTexturePhase[ i ] = texture_manager->create( labelXXX );
     }
-    if (tpopulation > 0) {
-        /* log scale 0 -> 200 000 = 10^5.3 */
-        float scale = h / (5.3 * log(10.));
-        float t = (total_time %NUMOF_DAYS_IN_MONTH + 1.f);
-
-        monthgraph_pop[0] = (int) (log (tpopulation / t) * scale);
-        if (monthgraph_pop[0] < 0)
-            monthgraph_pop[0] = 0;
-        if (monthgraph_pop[0] >= h)
-            monthgraph_pop[0] = h - 1;
-
-        monthgraph_starve[0] = (int) (log( tstarving_population  /  t) * scale);
-        if (monthgraph_starve[0] < 0)
-            monthgraph_starve[0] = 0;
-        if (monthgraph_starve[0] >= h)
-            monthgraph_starve[0] = h - 1;
-
-        monthgraph_nojobs[0] = (int) (log( tunemployed_population  / t) * scale);
-        if (monthgraph_nojobs[0] < 0)
-            monthgraph_nojobs[0] = 0;
-        if (monthgraph_nojobs[0] >= h)
-            monthgraph_nojobs[0] = h - 1;
-
-        /* percentage scale */
-        f = (float) people_pool / (float) (tpopulation / t + people_pool) * (float) h;
-        monthgraph_ppool[0] = (int) f;
-        if (monthgraph_ppool[0] < 0)
-            monthgraph_ppool[0] = 0;
-        if (monthgraph_ppool[0] >= h)
-            monthgraph_ppool[0] = h - 1;
+    labelXXX = TTF_RenderUTF8_Blended( font, _("Milliseconds per Day:"), labelStyle.text_color.getSDLColor() );
+    labelTextureTiming = texture_manager->create( labelXXX );
+}
+
+//values of the history graph, 64 is the height oldgui uses
+#define HISTORY_GRAPH_H 64
+
+//log scale 0 -> 200 000 = 10^5.3
+static int historyLogScale( int value ){
+    if( value <= 0 )
+        return 0;
+    int y = (int) ( log( (float) value ) * HISTORY_GRAPH_H / ( 5.3 * log( 10. ) ) );
+    return std::max( 0, std::min( y, HISTORY_GRAPH_H - 1 ) );
+}
+
+//monthly mean of column, months ago, 0 before the history starts
+//like the old monthgraph, a month in progress shows its running mean first
+static int historyMonth( StatsHistory::Column column, int age ){
+    if( statsHistory.monthDays > 0 ){
+        if( age == 0 )
+            return statsHistory.monthSoFar( column );
+        age--;
     }
+    if( age >= statsHistory.count( StatsHistory::MONTHLY ) )
+        return 0;
+    return statsHistory.value( StatsHistory::MONTHLY, column, age );
+}
+
+//percentage scale
+static int historyPoolShare( int age ){
+    int pool = historyMonth( StatsHistory::PEOPLE_POOL, age );
+    int total = historyMonth( StatsHistory::HOUSED, age ) + pool;
+    if( total <= 0 )
+        return 0;
+    int y = (int) ( (float) pool / total * HISTORY_GRAPH_H );
+    return std::max( 0, std::min( y, HISTORY_GRAPH_H - 1 ) );
+}
 
+//see do_history_linegraph in oldgui/screen.cpp
+//the months are kept by statsHistory
+void EconomyGraph::updateData(){
     //sustainability check from do_sust_barchart
     if (sust_dig_ore_coal_count >= SUST_ORE_COAL_YEARS_NEEDED
         && sust_port_count >= SUST_PORT_YEARS_NEEDED
@@ -250,9 +281,9 @@ void EconomyGraph::updateData(){
 
     // set tab Button colour
     if( switchEconomyGraphParagraph ){
-        if( monthgraph_starve[0] > 0 ){ // people are starving: RED
+        if( historyLogScale( historyMonth( StatsHistory::STARVING, 0 ) ) > 0 ){ // people are starving: RED
             switchEconomyGraphParagraph->setText(switchEconomyGraphText, redStyle);
-        } else if( monthgraph_nojobs[0] > 0 ){ // people are unemployed: YELLOW
+        } else if( historyLogScale( historyMonth( StatsHistory::UNEMPLOYED, 0 ) ) > 0 ){ // people are unemployed: YELLOW
             switchEconomyGraphParagraph->setText(switchEconomyGraphText, yellowStyle);
         } else {
             switchEconomyGraphParagraph->setText(switchEconomyGraphText, normalStyle);
@@ -274,6 +305,64 @@ void EconomyGraph::newFPS( int frame ){
     setDirty();
 }
 
+void EconomyGraph::newPhaseTimes(){
+    long long times[ Profiler::PHASE_COUNT ];
+    Profiler::takePhaseTimes( times );
+
+    //shift by one day, the oldest falls off
+    std::copy_backward( phaseTimes.begin(), phaseTimes.end() - Profiler::PHASE_COUNT,
+        phaseTimes.end() );
+    for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+        phaseTimes[ i ] = times[ i ] > INT_MAX ? INT_MAX : (int) times[ i ];
+    }
+    if( phaseDays < getConfig()->monthgraphW ){
+        phaseDays++;
+    }
+    phaseStatsDirty = true;
+    if( timingPage ){
+        setDirty();
+    }
+}
+
+void EconomyGraph::scrollPage( bool ){
+    //two pages, so both directions lead to the other one
+    timingPage = !timingPage;
+    setDirty();
+}
+
+void EconomyGraph::updatePhaseStats(){
+    std::vector<int> totals( phaseDays, 0 );
+    for( int day = 0; day < phaseDays; day++ ){
+        for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+            totals[ day ] += phaseTimes[ day * Profiler::PHASE_COUNT + i ];
+        }
+    }
+    double min = 0, avg = 0, p99 = 0, max = 0;
+    if( phaseDays > 0 ){
+        std::sort( totals.begin(), totals.end() );
+        long long sum = 0;
+        for( int day = 0; day < phaseDays; day++ ){
+            sum += totals[ day ];
+        }
+        min = totals.front() / 1000.;
+        max = totals.back() / 1000.;
+        avg = sum / 1000. / phaseDays;
+        p99 = totals[ (phaseDays * 99 + 99) / 100 - 1 ] / 1000.;
+    }
+    char text[ 128 ];
+    snprintf( text, sizeof(text), "%s %.1f %s %.1f %s %.1f %s %.1f",
+        _("min"), min, _("avg"), avg, _("p99"), p99, _("max"), max );
+
+    Style labelStyle;
+    labelStyle.font_family = "sans";
+    labelStyle.font_size = 10;
+    TTF_Font* font = fontManager->getFont( labelStyle );
+    delete labelTexturePhaseStats;
+    labelTexturePhaseStats = texture_manager->create(
+        TTF_RenderUTF8_Blended( font, text, labelStyle.text_color.getSDLColor() ) );
+    phaseStatsDirty = false;
+}
+
 void EconomyGraph::drawHistoryLineGraph( Painter& painter, Rect2D mg ){
     // see oldgui/screen.cpp do_history_linegraph
     Vector2 a;
@@ -294,29 +383,29 @@ void EconomyGraph::drawHistoryLineGraph( Painter& painter, Rect2D mg ){
     int mgW = (int) mg.getWidth();
     int mgH = (int) mg.getHeight();
 
-    float scale = (float) mgH / 64; //MONTHGRAPH_H  ;
+    float scale = (float) mgH / HISTORY_GRAPH_H;
 
     b.y = mgY + mgH;
     for( int i = mgW - 1; i >= 0; i-- ){
         painter.setLineColor( yellow );
         a.x = mgX + mgW - i;
-        a.y = mgY + mgH - scale * monthgraph_nojobs[i];
+        a.y = mgY + mgH - scale * historyLogScale( historyMonth( StatsHistory::UNEMPLOYED, i ) );
 
         b.x = mgX + mgW - i;
         painter.drawLine( a, b );
         painter.setLineColor( red );
-        a.y = mgY + mgH - scale * monthgraph_starve[i];
+        a.y = mgY + mgH - scale * historyLogScale( historyMonth( StatsHistory::STARVING, i ) );
         painter.drawLine( a, b );
     }
     for( int i = mgW - 1; i > 0; i-- ){
         painter.setLineColor( brown );
         a.x = mgX + mgW - i;
-        a.y = mgY + mgH - scale * monthgraph_pop[ i ];
+        a.y = mgY + mgH - scale * historyLogScale( historyMonth( StatsHistory::HOUSED, i ) );
         b.x = mgX + mgW - i-1;
-        b.y = mgY + mgH - scale * monthgraph_pop[ i-1 ];
+        b.y = mgY + mgH - scale * historyLogScale( historyMonth( StatsHistory::HOUSED, i-1 ) );
         painter.drawLine( a, b );
-        a.y = mgY + mgH - scale * monthgraph_ppool[ i ];
-        b.y = mgY + mgH - scale * monthgraph_ppool[ i-1 ];
+        a.y = mgY + mgH - scale * historyPoolShare( i );
+        b.y = mgY + mgH - scale * historyPoolShare( i-1 );
         painter.setLineColor( blue );
         painter.drawLine( a, b );
     }
@@ -446,7 +535,7 @@ void EconomyGraph::drawFPSGraph( Painter& painter, Rect2D fpsRect ){
     Vector2 b;
     painter.setLineColor( blue );
 
-    float scale = (float) mgH / 64; //MONTHGRAPH_H  ;
+    float scale = (float) mgH / HISTORY_GRAPH_H;
 
     b.y = mgY + mgH;
     for( int i = mgW - 1; i >= 0; i-- ){
@@ -459,20 +548,109 @@ void EconomyGraph::drawFPSGraph( Painter& painter, Rect2D fpsRect ){
     painter.clearClipRectangle();
 }
 
+void EconomyGraph::drawPhaseGraph( Painter& painter, Rect2D phaseRect ){
+    Color grey;
+    grey.parse("#A9A9A9FF");
+    Color colors[ Profiler::PHASE_COUNT ];
+    for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+        colors[ i ].parse( phaseColors[ i ] );
+    }
+    int mgX = (int) phaseRect.p1.x;
+    int mgY = (int) phaseRect.p1.y;
+    int mgW = (int) phaseRect.getWidth();
+    int mgH = (int) phaseRect.getHeight();
+
+    painter.setFillColor( grey );
+    painter.fillRectangle( phaseRect );
+
+    painter.setClipRectangle( phaseRect );
+
+    //the slowest day shown fills the height
+    int top = 1;
+    for( int day = 0; day < phaseDays && day < mgW; day++ ){
+        int total = 0;
+        for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+            total += phaseTimes[ day * Profiler::PHASE_COUNT + i ];
+        }
+        if( total > top ){
+            top = total;
+        }
+    }
+    float scale = (float) mgH / top;
+
+    Vector2 a;
+    Vector2 b;
+    for( int day = 0; day < phaseDays && day < mgW; day++ ){
+        a.x = b.x = mgX + mgW - day;
+        b.y = mgY + mgH;
+        int total = 0;
+        for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+            total += phaseTimes[ day * Profiler::PHASE_COUNT + i ];
+            a.y = mgY + mgH - scale * total;
+            if( a.y < b.y ){
+                painter.setLineColor( colors[ i ] );
+                painter.drawLine( a, b );
+            }
+            b.y = a.y;
+        }
+    }
+    painter.clearClipRectangle();
+}
+
+void EconomyGraph::drawTimingPage( Painter& painter ){
+    int mgX = border;
+    int mgY = 3*border;
+    int mgW = getConfig()->monthgraphW;
+    int mgH = getConfig()->monthgraphH * 3 / 2;
+
+    Vector2 labelPos( 2 * border, border-1 );
+    painter.drawTexture( labelTextureTiming, labelPos );
+    Rect2D currentGraph( mgX, mgY, mgX + mgW, mgY + mgH );
+    drawPhaseGraph( painter, currentGraph );
+
+    if( phaseStatsDirty ){
+        updatePhaseStats();
+    }
+    labelPos.y += 2 * border + mgH;
+    painter.drawTexture( labelTexturePhaseStats, labelPos );
+
+    //legend in two columns
+    Color color;
+    Rect2D swatch;
+    for( int i = 0; i < Profiler::PHASE_COUNT; i++ ){
+        Vector2 pos( mgX + ( i % 2 ) * mgW / 2,
+            labelPos.y + 3 * border + ( i / 2 ) * 3 * border );
+        color.parse( phaseColors[ i ] );
+        painter.setFillColor( color );
+        swatch = Rect2D( pos.x, pos.y + 3, pos.x + 8, pos.y + 11 );
+        painter.fillRectangle( swatch );
+        pos.x += 2 * border + 2;
+        painter.drawTexture( labelTexturePhase[ i ], pos );
+    }
+}
+
 void EconomyGraph::draw( Painter& painter ){
 
     Color white;
     white.parse( "white" );
 
     Rect2D background( 0, 0, getWidth(), getHeight() );
+    painter.setFillColor( white );
+    painter.fillRectangle( background );
+
+    if( timingPage ){
+        drawTimingPage( painter );
+    } else {
+        drawEconomyPage( painter );
+    }
+}
+
+void EconomyGraph::drawEconomyPage( Painter& painter ){
     int mgX = border;
     int mgY = 3*border;
     int mgW = getConfig()->monthgraphW;
     int mgH = getConfig()->monthgraphH;
 
-    painter.setFillColor( white );
-    painter.fillRectangle( background );
-
     Vector2 labelPos( 2 * border, border-1 );
 
     //Draw HistoryLineGraph
@@ -25,6 +25,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "gui/Style.hpp"
 
 #include "CheckButton.hpp"
+#include "lincity/Profiler.h"
+
+#include <vector>
 
 class EconomyGraph : public Component {
 public:
@@ -35,13 +38,29 @@ public:
     void draw(Painter& painter);
     void updateData();    
     void newFPS( int frame );
+    /** take the phase times of the day just simulated from the Profiler */
+    void newPhaseTimes();
+    /** switch between the economy and the timing page */
+    void scrollPage( bool down );
 private:
     static const int border = 5;
     void drawHistoryLineGraph( Painter& painter, Rect2D mg );
     void drawSustBarGraph( Painter& painter, Rect2D mg );
     void drawFPSGraph( Painter& painter, Rect2D fpsRect );
+    void drawEconomyPage( Painter& painter );
+    void drawTimingPage( Painter& painter );
+    void drawPhaseGraph( Painter& painter, Rect2D phaseRect );
+    void updatePhaseStats();
  
     int* fps;
+    bool timingPage;
+    //microseconds per phase, Profiler::PHASE_COUNT values per day, newest first
+    std::vector<int> phaseTimes;
+    int phaseDays; //days in phaseTimes that were measured
+    Texture* labelTexturePhase[ Profiler::PHASE_COUNT ];
+    Texture* labelTextureTiming;
+    Texture* labelTexturePhaseStats; //min/avg/p99 of the days shown
+    bool phaseStatsDirty;
     Texture* labelTextureMIN;
     Texture* labelTexturePRT;
     Texture* labelTextureMNY;
@@ -20,6 +20,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Game.hpp"
 
 #include "gui/TextureManager.hpp"
+#include "gui/PainterSDL/TextureManagerSDL.hpp"
+#include "gui/PainterGL/TextureGL.hpp"
 #include "gui/ComponentLoader.hpp"
 #include "gui/Component.hpp"
 #include "gui/Desktop.hpp"
@@ -28,11 +30,17 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "gui/callback/Callback.hpp"
 #include "lincity/fileutil.h"
 #include "lincity/init_game.h"
+#include "lincity/engglobs.h"
+#include "lincity/Profiler.h"
+#include "lincity/lclib.h"
 #include "gui_interface/shared_globals.h"
 #include "gui_interface/mps.h"
 
 #include "MainLincity.hpp"
 #include <iostream>
+#include <sstream>
+#include <stdlib.h>
+#include <time.h>
 #include <physfs.h>
 #include "Util.hpp"
 #include "GameView.hpp"
@@ -41,8 +49,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Dialog.hpp"
 #include "EconomyGraph.hpp"
 #include "Config.hpp"
+#include "Sound.hpp"
 
 extern int lincitySpeed;
+
+#define FORECAST_YEARS 5
 extern void execute_timestep(void);
 
 Game* gameptr = 0;
@@ -69,6 +80,16 @@ Game::Game()
     if(desktop == 0)
         throw std::runtime_error("Game UI is not a Desktop Component");
     helpWindow.reset(new HelpWindow(desktop));
+
+    //the newest snapshot doubles as the game to continue after a crash
+    rewindBuffer.interval = getConfig()->rewindMonths * NUMOF_DAYS_IN_MONTH;
+    rewindBuffer.capacity = getConfig()->rewindSnapshots;
+    rewindBuffer.recoveryFile = std::string( PHYSFS_getWriteDir() )
+        + PHYSFS_getDirSeparator() + "9_currentGameNG.scn.gz";
+    deltaSave.interval = getConfig()->autosaveMonths * NUMOF_DAYS_IN_MONTH;
+    deltaSave.compactAfter = getConfig()->autosaveCompact;
+    deltaSave.filename = std::string( PHYSFS_getWriteDir() )
+        + PHYSFS_getDirSeparator() + "autosave.delta";
     gameptr = this;
 }
 
@@ -120,12 +141,164 @@ void Game::quickLoad(){
     }
 }
 
+void Game::loadAutosave(){
+    closeAllDialogs();
+    getGameView()->printStatusMessage( "loading autosave...");
+    if( loadCityNG( "autosave.delta" ) ){
+          getGameView()->printStatusMessage( "autosave loaded.");
+    } else {
+          getGameView()->printStatusMessage( "loading autosave failed!");
+    }
+}
+
 void Game::quickSave(){
     //save file
     getGameView()->printStatusMessage( "quick save...");
     saveCityNG( "quicksave.scn" );
 }
 
+void Game::toggleRecording(){
+    if( journal.isRecording() ){
+        journal.stopRecording();
+        getGameView()->printStatusMessage( "recording stopped." );
+        return;
+    }
+    //the recording starts from a loaded game, just like its replay
+    closeAllDialogs();
+    saveCityNG( "replay.scn.gz" );
+    if( !loadCityNG( "replay.scn.gz" ) ){
+        getGameView()->printStatusMessage( "recording failed!" );
+        return;
+    }
+    unsigned int seed = time( 0 );
+    srand( seed );
+    Journal::Settings settings;
+    settings.speed = lincitySpeed;
+    settings.carsEnabled = getConfig()->carsEnabled;
+    settings.powerGrid = getConfig()->powerGrid;
+    settings.tradeGraph = getConfig()->tradeGraph;
+    settings.sleeping = getConfig()->sleeping;
+    settings.denseTrade = getConfig()->denseTrade;
+    if( journal.startRecording( "replay.journal", "replay.scn.gz", seed, settings ) ){
+        getGameView()->printStatusMessage( "recording to replay.journal..." );
+    } else {
+        getGameView()->printStatusMessage( "recording failed!" );
+    }
+}
+
+//no other thread of the game may hold a lock while it is forked
+static bool pauseForecast(){
+    if( !getGameView()->pauseThreads() )
+        return false;
+    if( getSound() )
+        getSound()->pauseThreads();
+    return true;
+}
+
+static void resumeForecast(){
+    if( getSound() )
+        getSound()->resumeThreads();
+    getGameView()->resumeThreads();
+}
+
+//the forecast must keep its hands off the display and the sound of the game
+static void detachForecast(){
+    TextureGL::detached = true;
+    texture_manager = new TextureManagerSDL();
+    getConfig()->soundEnabled = false;
+    getConfig()->musicEnabled = false;
+    getGameView()->remaining_images = 0;
+}
+
+void Game::forecast(){
+    if( whatIf.isRunning() ){
+        whatIf.cancel();
+        getGameView()->printStatusMessage( "forecast cancelled." );
+        return;
+    }
+    //what if the selected building was built under the mouse?
+    Journal::Entry build;
+    Journal::Entry* op = 0;
+    MapPoint tile;
+    if( userOperation->action == UserOperation::ACTION_BUILD
+            && getGameView()->getTileUnderMouse( tile )
+            && userOperation->is_allowed_here( tile.x, tile.y, false ) ){
+        build.day = total_time;
+        build.op = Journal::OP_BUILD;
+        build.x = tile.x;
+        build.y = tile.y;
+        build.arg1 = userOperation->constructionGroup->group;
+        build.arg2 = 0;
+        op = &build;
+    }
+    WhatIfHooks hooks = { pauseForecast, resumeForecast, detachForecast };
+    if( !whatIf.start( op, FORECAST_YEARS * NUMOF_DAYS_IN_YEAR, hooks ) ){
+        getGameView()->printStatusMessage( "forecast failed!" );
+        return;
+    }
+    std::ostringstream message;
+    message << "forecasting " << FORECAST_YEARS << " years";
+    if( op ){
+        message << " with " << userOperation->constructionGroup->name
+            << " at " << tile.x << ", " << tile.y;
+    }
+    message << "...";
+    getGameView()->printStatusMessage( message.str() );
+}
+
+static void showForecast( const WhatIfSummary& after ){
+    const WhatIfSummary& before = whatIf.before;
+    std::ostringstream message;
+    message << "in " << FORECAST_YEARS << " years: population " << after.population
+        << " (" << std::showpos << after.population - before.population
+        << std::noshowpos << "), money " << after.money
+        << " (" << std::showpos << after.money - before.money
+        << std::noshowpos << "), starving " << after.starving
+        << ", pollution " << after.pollution
+        << " (" << after.wallMs << " ms)";
+    getGameView()->printStatusMessage( message.str() );
+}
+
+//steps back (-1) or forward (+1) through the snapshots of the rewind buffer
+void Game::rewind( int step ){
+    int count = rewindBuffer.count();
+    int target = -1;
+    if( step < 0 ){
+        for( int i = 0; i < count; i++ ){
+            if( rewindBuffer.snapshot( i ).day < total_time ){
+                target = i;
+            }
+        }
+    } else {
+        for( int i = count - 1; i >= 0; i-- ){
+            if( rewindBuffer.snapshot( i ).day > total_time ){
+                target = i;
+            }
+        }
+    }
+    if( target < 0 ){
+        getGameView()->printStatusMessage( step < 0 ?
+                "nothing to rewind to." : "no later snapshot." );
+        return;
+    }
+    closeAllDialogs();
+    long long start = Profiler::now();
+    if( !rewindBuffer.restore( target ) ){
+        getGameView()->printStatusMessage( "rewind failed!" );
+        return;
+    }
+    //a timeline of the snapshots with the restored one marked
+    std::ostringstream message;
+    message << "rewound to " << current_month( total_time ) << " "
+        << current_year( total_time ) << " [";
+    for( int i = 0; i < count; i++ ){
+        message << ( i == target ? '|' : '-' );
+    }
+    message << "] F3 earlier, F4 later ("
+        << ( Profiler::now() - start ) / 1000 << " ms)";
+    getGameView()->printStatusMessage( message.str() );
+}
+
 void Game::testAllHelpFiles(){
     getGameView()->printStatusMessage( "Testing Help Files...");
 
@@ -227,6 +400,32 @@ Game::run()
                          quickLoad();
                          break;
                      }
+                     if( gui_event.keysym.sym == SDLK_F3 ){
+                         rewind( -1 );
+                         break;
+                     }
+                     if( gui_event.keysym.sym == SDLK_F4 ){
+                         rewind( 1 );
+                         break;
+                     }
+                     if( gui_event.keysym.sym == SDLK_F10 ){
+                         loadAutosave();
+                         break;
+                     }
+                     if( gui_event.keysym.sym == SDLK_F6 ){
+                         forecast();
+                         break;
+                     }
+                     if( gui_event.keysym.sym == SDLK_F7 ){
+                         toggleRecording();
+                         break;
+                     }
+#ifdef ENABLE_ZONES
+                     if( gui_event.keysym.sym == SDLK_F8 ){
+                         Profiler::dump("profile.json");
+                         break;
+                     }
+#endif
 #ifdef DEBUG
                      if( gui_event.keysym.sym == SDLK_F5 ){
                          testAllHelpFiles();
@@ -288,6 +487,7 @@ Game::run()
         helpWindow->update();
         if(desktop->needsRedraw())
         {
+            PROFILE_PHASE(PHASE_RENDER, "Desktop::draw");
             desktop->draw(*painter);
             flipScreenBuffer();
         }
@@ -307,6 +507,11 @@ Game::run()
         {   frame = 0;}
         /* SDL_Delay is done in execute_timestep */
         execute_timestep ();
+
+        WhatIfSummary forecasted;
+        if( whatIf.isRunning() && whatIf.poll( forecasted ) ){
+            showForecast( forecasted );
+        }
     }
     return quitState;
 }
@@ -46,6 +46,10 @@ private:
     void testAllHelpFiles();
     void quickLoad();
     void quickSave();
+    void loadAutosave();
+    void toggleRecording();
+    void forecast();
+    void rewind( int step );
     std::unique_ptr<HelpWindow> helpWindow;
 };
 
@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "gui_interface/mps.h"
 #include "gui/TextureManager.hpp"
 #include "gui/Painter.hpp"
+#include "gui/PainterSDL/PainterSDL.hpp"
 #include "gui/Rect2D.hpp"
 #include "gui/Color.hpp"
 #include "gui/ComponentFactory.hpp"
@@ -37,6 +38,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "lincity/modules/all_modules.h"
 #include "lincity/engine.h"
 #include "lincity/lin-city.h"
+#include "lincity/Profiler.h"
 
 #include "Mps.hpp"
 #include "MapEdit.hpp"
@@ -46,10 +48,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "ScreenInterface.hpp"
 #include "Util.hpp"
 #include "Debug.hpp"
+#include "SpriteCache.hpp"
 
 #include <SDL_keysym.h>
 #include <math.h>
 #include <sstream>
+#include <set>
 #include <physfs.h>
 
 #include "gui_interface/shared_globals.h"
@@ -80,6 +84,8 @@ GameView::GameView()
     assert(gameViewPtr == 0);
     gameViewPtr = this;
     loaderThread = 0;
+    renderPool = 0;
+    residency = 0;
     keyScrollState = 0;
     mouseScrollState = 0;
     remaining_images = 0;
@@ -90,6 +96,8 @@ GameView::~GameView()
 {
     stopThread = true;
     SDL_WaitThread( loaderThread, NULL );
+    delete renderPool;
+    delete residency;
     if(gameViewPtr == this)
     {   gameViewPtr = 0;}
 }
@@ -100,6 +108,16 @@ int GameView::gameViewThread( void* data )
     GameView* gv = (GameView*) data;
     gv->preReadImages();
     gv->textures_ready = true;
+    //decode groups that will soon be visible
+    if(gv->residency)
+    {
+        while(!gv->stopThread)
+        {
+            if(!gv->residency->decodeQueued())
+            {   SDL_Delay(20);}
+        }
+        return 0;
+    }
     //keep thread alive as long as there are SDL_Surfaces
     while(!gv->stopThread && gv->remaining_images!=0)
     {   SDL_Delay(100);}
@@ -126,6 +144,8 @@ void GameView::parse(XmlReader& reader)
     blankGraphicsInfo.x = blankGraphicsInfo.texture->getWidth() / 2;
     blankGraphicsInfo.y = blankGraphicsInfo.texture->getHeight();
 
+    if( getConfig()->textureMemory > 0 )
+    {   residency = new TextureResidency( size_t(getConfig()->textureMemory) * 1024 * 1024 );}
     stopThread = false;
     loaderThread = SDL_CreateThread( gameViewThread, this );
 
@@ -307,6 +327,11 @@ MapPoint GameView::getCenter(){
     return getTile( center );
 }
 
+bool GameView::getTileUnderMouse( MapPoint& tile ){
+    tile = tileUnderMouse;
+    return mouseInGameView && inCity( tile );
+}
+
 /*
  * Adjust the Zoomlevel.
  */
@@ -429,10 +454,36 @@ SDL_Surface* GameView::readImage(const std::string& filename)
  *  Some of the Image to Texture Conversion seems not to be threadsave
  *  in OpenGL, so load just Images and convert them to Textures on
  *  demand in the main Tread.
+ *
+ *  The images are decoded by a thread pool or taken from the sprite
+ *  cache, and handed to their ResourceGroups once all are done. With a
+ *  texture budget only the file names are kept, see updateResidency.
  */
 
+struct PendingImage
+{
+    ResourceGroup* resourceGroup;
+    std::string file;
+    int x, y;
+    bool x_set, y_set;
+    SDL_Surface* image;
+};
+
+//Static function to use with ThreadPool::run
+void GameView::decodeImage(void* data)
+{
+    PendingImage* pending = (PendingImage*) data;
+    try {
+        pending->image = readImage( pending->file );
+    } catch(std::exception& err) {
+        std::cerr << "GameView::decodeImage# " << pending->file << ": " << err.what() << "\n";
+        pending->image = 0;
+    }
+}
+
 void GameView::preReadImages(void)
 {
+    PROFILE_ZONE("GameView::preReadImages");
     std::string dirsep = PHYSFS_getDirSeparator();
 
     std::ostringstream os;
@@ -444,6 +495,8 @@ void GameView::preReadImages(void)
     ResourceGroup *resourceGroup = 0;
     int resourceID_level = 0;
     std::string key;
+    std::vector<PendingImage> pending;
+    std::set<ResourceGroup*> seenGroups;
 
     while( reader.read() )
     {
@@ -460,14 +513,11 @@ void GameView::preReadImages(void)
                     const char* value = (const char*) iter.getValue();
                     if( strcmp(name, "name" ) == 0 )
                     {
-                        if(resourceGroup)
-                        {   resourceGroup->images_loaded = true;}
-
                         if(ResourceGroup::resMap.count(value))
                         {
                             resourceGroup = ResourceGroup::resMap[value];
                             resourceID_level = reader.getDepth();
-                            if(resourceGroup->images_loaded)
+                            if(resourceGroup->images_loaded || !seenGroups.insert(resourceGroup).second)
                             {
                                 std::cout << "Duplicate resourceID in images.xml: " << value << std::endl;
                                 assert(false);
@@ -485,7 +535,6 @@ void GameView::preReadImages(void)
             //check if we are still inside context of last resorceID
             if(reader.getDepth() < resourceID_level-1)
             {
-                resourceGroup->images_loaded = true;
                 resourceGroup = 0;
                 resourceID_level = 0;
             }
@@ -524,25 +573,98 @@ void GameView::preReadImages(void)
 
                 if (resourceID_level && resourceGroup)
                 {
-                    resourceGroup->growGraphicsInfoVector();
-                    GraphicsInfo *graphicsInfo = &(resourceGroup->graphicsInfoVector.back());
-                    graphicsInfo->image = readImage( key );
-                    if(!graphicsInfo->image)
-                    {
-                        std::cout << "image error: " << key << std::endl;
-                    }
-                    if(!xmlX_set)
-                    {   xmlX = int(graphicsInfo->image->w/2);}
-                    if(!xmlY_set)
-                    {   xmlY = int(graphicsInfo->image->h);}
-                    graphicsInfo->x = xmlX;
-                    graphicsInfo->y = xmlY;
-                    ++remaining_images;
+                    PendingImage image;
+                    image.resourceGroup = resourceGroup;
+                    image.file = key;
+                    image.x = xmlX;
+                    image.y = xmlY;
+                    image.x_set = xmlX_set;
+                    image.y_set = xmlY_set;
+                    image.image = 0;
+                    pending.push_back(image);
                 }
                 key.clear();
             }
         }
     }
+
+    //try the sprite cache before decoding anything
+    std::vector<SDL_Surface*> cached;
+    SpriteCache* cache = 0;
+    if( getConfig()->spriteCache && !residency )
+    {
+        cache = new SpriteCache( "spritecache.bin" );
+        cache->addSource( xmlfile );
+        for(size_t i = 0; i < pending.size(); ++i)
+        {
+            std::ostringstream filename;
+            filename << "images" << dirsep << "tiles" << dirsep << pending[i].file;
+            cache->addSource( filename.str() );
+        }
+    }
+    if( cache && cache->read( cached ) && cached.size() == pending.size() )
+    {
+        for(size_t i = 0; i < pending.size(); ++i)
+        {   pending[i].image = cached[i];}
+    }
+    else if( !residency )
+    {
+        for(size_t i = 0; i < cached.size(); ++i)
+        {
+            if( cached[i] )
+            {   SDL_FreeSurface( cached[i] );}
+        }
+        std::vector<void*> jobs;
+        for(size_t i = 0; i < pending.size(); ++i)
+        {   jobs.push_back( &pending[i] );}
+        //SDL_image loads its codecs on first use, so do that one alone
+        if( !jobs.empty() )
+        {   decodeImage( jobs[0] );}
+        if( jobs.size() > 1 )
+        {
+            ThreadPool decoders;
+            decoders.run( decodeImage, &jobs[1], jobs.size() - 1 );
+        }
+        if( cache )
+        {
+            std::vector<SDL_Surface*> images;
+            for(size_t i = 0; i < pending.size(); ++i)
+            {   images.push_back( pending[i].image );}
+            cache->write( images );
+        }
+    }
+    delete cache;
+
+    //hand the images over to their ResourceGroups
+    resourceGroup = 0;
+    for(size_t i = 0; i < pending.size(); ++i)
+    {
+        if(resourceGroup && resourceGroup != pending[i].resourceGroup)
+        {   resourceGroup->images_loaded = true;}
+        resourceGroup = pending[i].resourceGroup;
+        resourceGroup->growGraphicsInfoVector();
+        GraphicsInfo *graphicsInfo = &(resourceGroup->graphicsInfoVector.back());
+        graphicsInfo->image = pending[i].image;
+        graphicsInfo->x = pending[i].x;
+        graphicsInfo->y = pending[i].y;
+        if(residency)
+        {
+            graphicsInfo->file = pending[i].file;
+            graphicsInfo->x_default = !pending[i].x_set;
+            graphicsInfo->y_default = !pending[i].y_set;
+            continue;
+        }
+        if(!graphicsInfo->image)
+        {
+            std::cout << "image error: " << pending[i].file << std::endl;
+            continue;
+        }
+        if(!pending[i].x_set)
+        {   graphicsInfo->x = int(graphicsInfo->image->w/2);}
+        if(!pending[i].y_set)
+        {   graphicsInfo->y = int(graphicsInfo->image->h);}
+        ++remaining_images;
+    }
     if(resourceGroup)
     {
         resourceGroup->images_loaded = true;
@@ -982,6 +1104,25 @@ void GameView::resize(float newwidth , float newheight )
 /*
  *  We should draw the whole City again.
  */
+bool GameView::pauseThreads()
+{
+    if( !textures_ready )
+    {   return false;}
+    if( residency )
+    {   residency->pause();}
+    if( renderPool )
+    {   renderPool->pause();}
+    return true;
+}
+
+void GameView::resumeThreads()
+{
+    if( renderPool )
+    {   renderPool->resume();}
+    if( residency )
+    {   residency->resume();}
+}
+
 void GameView::requestRedraw()
 {
     if( !getMiniMap() ){ //initialization not completed
@@ -1037,7 +1178,7 @@ Vector2 GameView::getScreenPoint(MapPoint map)
 
     if ((showTerrainHeight) && (inCity(map))){
         // shift the tile upward to show altitude
-        point.y -= (float) ( (world(map.x, map.y)->ground.altitude) * scale3d) * zoom  / (float) alt_step ;
+        point.y -= (float) ( (world.ground(map.x, map.y)->altitude) * scale3d) * zoom  / (float) alt_step ;
     }
 
     //on Screen
@@ -1143,10 +1284,10 @@ MapPoint GameView::realTile( MapPoint tile )
     MapPoint real = tile;
     if( ! inCity( tile ) )
         return real;
-    if(world(tile.x, tile.y)->reportingConstruction)
+    if(world(tile.x, tile.y)->reportingConstruction())
     {
-        real.x = world(tile.x, tile.y)->reportingConstruction->x;
-        real.y = world(tile.x, tile.y)->reportingConstruction->y;
+        real.x = world(tile.x, tile.y)->reportingConstruction()->x;
+        real.y = world(tile.x, tile.y)->reportingConstruction()->y;
         return real;
     }
     return real;
@@ -1175,7 +1316,8 @@ void GameView::fetchTextures()
 
 
 
-void GameView::drawTexture(Painter& painter, const MapPoint &tile, GraphicsInfo *graphicsInfo)
+void GameView::drawTexture(Painter& painter, const MapPoint &tile, GraphicsInfo *graphicsInfo,
+    int move_x /*= 0*/, int move_y /*= 0*/)
 {
     Rect2D tilerect( 0, 0, tileWidth, tileHeight );
     Vector2 tileOnScreenPoint = getScreenPoint( tile );
@@ -1192,8 +1334,8 @@ void GameView::drawTexture(Painter& painter, const MapPoint &tile, GraphicsInfo
     }
     if (graphicsInfo->texture)
     {
-        tileOnScreenPoint.x -= graphicsInfo->x * zoom;
-        tileOnScreenPoint.y -= graphicsInfo->y * zoom;
+        tileOnScreenPoint.x -= (graphicsInfo->x - move_x) * zoom;
+        tileOnScreenPoint.y -= (graphicsInfo->y - move_y) * zoom;
         tilerect.move( tileOnScreenPoint );
         tilerect.setSize(graphicsInfo->texture->getWidth() * zoom,
             graphicsInfo->texture->getHeight() * zoom);
@@ -1238,11 +1380,11 @@ void GameView::drawTile(Painter& painter, const MapPoint &tile)
          || cstgrp == &tree3ConstructionGroup ))
         {
             cstgrp = &bareConstructionGroup;
-            resgrp = ResourceGroup::resMap["Green"];
+            resgrp = ResourceGroup::resMap.find("Green")->second;
         }
         GraphicsInfo *graphicsInfo = 0;
         //draw visible tiles underneath constructions
-        if( (world(x, y)->reportingConstruction || world(x,y)->framesptr) && !(world(x,y)->flags & FLAG_INVISIBLE) )
+        if( (world(x, y)->reportingConstruction() || world(x,y)->framesptr()) && !(world(x,y)->flags() & FLAG_INVISIBLE) )
         {
             if (resgrp->images_loaded)
             {
@@ -1250,7 +1392,7 @@ void GameView::drawTile(Painter& painter, const MapPoint &tile)
                 if (s)
                 {
                     graphicsInfo = &resgrp->graphicsInfoVector
-                        [ world(x, y)->type  % s];
+                        [ world(x, y)->type()  % s];
                     drawTexture(painter, lowerRightTile, graphicsInfo);
                 }
             }
@@ -1260,10 +1402,10 @@ void GameView::drawTile(Painter& painter, const MapPoint &tile)
         if( (size==1 || !hideHigh) )
         {
             draw_colored_site = false;
-            if (world(x,y)->framesptr)
+            if (world(x,y)->framesptr())
             {
-                for(std::list<ExtraFrame>::iterator frit = world(x, y)->framesptr->begin();
-                    frit != world(x,y)->framesptr->end(); std::advance(frit, 1))
+                for(ExtraFrameList::iterator frit = world(x, y)->framesptr()->begin();
+                    frit != world(x,y)->framesptr()->end(); std::advance(frit, 1))
                 {
                     if(frit->resourceGroup && frit->resourceGroup->images_loaded)
                     {
@@ -1271,10 +1413,6 @@ void GameView::drawTile(Painter& painter, const MapPoint &tile)
                         if((frit->frame >= 0) && s2)
                         {
                             graphicsInfo = &frit->resourceGroup->graphicsInfoVector[ frit->frame % s2 ]; //needed
-                            int old_x = graphicsInfo->x;
-                            int old_y = graphicsInfo->y;
-                            graphicsInfo->x = old_x - frit->move_x;
-                            graphicsInfo->y = old_y - frit->move_y;
                             if( frit->resourceGroup->is_vehicle)
                             {
                                 //only draw vehicles on top of...
@@ -1295,7 +1433,8 @@ void GameView::drawTile(Painter& painter, const MapPoint &tile)
                                     case GROUP_CRICKET:
                                     case GROUP_SUBSTATION:
                                     //add anything else with low northen corner
-                                        drawTexture(painter, upperLeft, graphicsInfo);
+                                        drawTexture(painter, upperLeft, graphicsInfo,
+                                            frit->move_x, frit->move_y);
                                     break;
                                     default:
                                     break;
@@ -1304,9 +1443,10 @@ void GameView::drawTile(Painter& painter, const MapPoint &tile)
 
                             }
                             else
-                            {   drawTexture(painter, lowerRightTile, graphicsInfo);}
-                            graphicsInfo->x = old_x;
-                            graphicsInfo->y = old_y;
+                            {
+                                drawTexture(painter, lowerRightTile, graphicsInfo,
+                                    frit->move_x, frit->move_y);
+                            }
                         }
                     }
                     else
@@ -1336,14 +1476,14 @@ void GameView::drawTile(Painter& painter, const MapPoint &tile)
         }
         //last draw suspended power cables on top
         //only works for size == 1
-        if (world(x, y)->flags & (FLAG_POWER_CABLES_0 | FLAG_POWER_CABLES_90))
+        if (world(x, y)->flags() & (FLAG_POWER_CABLES_0 | FLAG_POWER_CABLES_90))
         {
-            resgrp = ResourceGroup::resMap["PowerLine"];
+            resgrp = ResourceGroup::resMap.find("PowerLine")->second;
             if(resgrp->images_loaded)
             {
-                if (world(x, y)->flags & FLAG_POWER_CABLES_0)
+                if (world(x, y)->flags() & FLAG_POWER_CABLES_0)
                 {   drawTexture(painter, upperLeft, &resgrp->graphicsInfoVector[23]);}
-                if (world(x, y)->flags & FLAG_POWER_CABLES_90)
+                if (world(x, y)->flags() & FLAG_POWER_CABLES_90)
                 {   drawTexture(painter, upperLeft, &resgrp->graphicsInfoVector[22]);}
             }
         }
@@ -1364,9 +1504,9 @@ void GameView::markTile( Painter& painter, const MapPoint &tile )
         MapPoint upperLeft = realTile(tile);
         if(upperLeft.x == mps_x && upperLeft.y == mps_y && userOperation->action == UserOperation::ACTION_QUERY)
         {
-            if(world(x,y)->reportingConstruction)
+            if(world(x,y)->reportingConstruction())
             {
-                ConstructionGroup *constructionGroup = world(x,y)->reportingConstruction->constructionGroup;
+                ConstructionGroup *constructionGroup = world(x,y)->reportingConstruction()->constructionGroup;
                 int range = constructionGroup->range;
                 int edgelen = 2 * range + constructionGroup->size ;
                 painter.setFillColor( Color( 0, 255, 0, 64 ) );
@@ -1428,11 +1568,184 @@ void GameView::markTile( Painter& painter, const MapPoint &tile )
     }//endelse ACTION_QUERY
 }
 
+/*
+ * Draw all tiles which may be visible inside of area, back to front.
+ */
+void GameView::drawTiles(Painter& painter, const Rect2D& area)
+{
+    MapPoint upperLeftTile  = getTile( area.p1 );
+    MapPoint upperRightTile = getTile( Vector2( area.p2.x, area.p1.y ) );
+    MapPoint lowerLeftTile  = getTile( Vector2( area.p1.x, area.p2.y ) );
+
+    //Draw some extra tiles depending on the maximal size of a building.
+    int extratiles = 7;
+    upperLeftTile.x -= extratiles;
+    upperRightTile.y -= extratiles;
+    upperRightTile.x += extratiles;
+    lowerLeftTile.y +=  extratiles;
+
+    MapPoint currentTile;
+    for(int k = 0; k <= 2 * ( lowerLeftTile.y - upperLeftTile.y ); k++ )
+    {
+        for(int i = 0; i <= upperRightTile.x - upperLeftTile.x; i++ )
+        {
+            currentTile.x = upperLeftTile.x + i + k / 2 + k % 2;
+            currentTile.y = upperLeftTile.y - i + k / 2;
+            drawTile( painter, currentTile );
+        }
+    }
+}
+
+/*
+ * Collect the ResourceGroups drawTile needs for the tiles in area.
+ */
+void GameView::collectGroups(const Rect2D& area, std::set<ResourceGroup*>& groups)
+{
+    MapPoint upperLeftTile  = getTile( area.p1 );
+    MapPoint upperRightTile = getTile( Vector2( area.p2.x, area.p1.y ) );
+    MapPoint lowerLeftTile  = getTile( Vector2( area.p1.x, area.p2.y ) );
+
+    int extratiles = 7;
+    upperLeftTile.x -= extratiles;
+    upperRightTile.y -= extratiles;
+    upperRightTile.x += extratiles;
+    lowerLeftTile.y +=  extratiles;
+
+    MapPoint currentTile;
+    for(int k = 0; k <= 2 * ( lowerLeftTile.y - upperLeftTile.y ); k++ )
+    {
+        for(int i = 0; i <= upperRightTile.x - upperLeftTile.x; i++ )
+        {
+            currentTile.x = upperLeftTile.x + i + k / 2 + k % 2;
+            currentTile.y = upperLeftTile.y - i + k / 2;
+            if( !inCity( currentTile ) )
+            {   continue;}
+            MapPoint upperLeft = realTile( currentTile );
+            MapTile mapTile = world(upperLeft.x, upperLeft.y);
+            groups.insert( mapTile->getTileResourceGroup() );
+            if( mapTile->framesptr() )
+            {
+                for(ExtraFrameList::iterator frit = mapTile->framesptr()->begin();
+                    frit != mapTile->framesptr()->end(); std::advance(frit, 1))
+                {
+                    if( frit->resourceGroup )
+                    {   groups.insert( frit->resourceGroup );}
+                }
+            }
+            if( mapTile->flags() & (FLAG_POWER_CABLES_0 | FLAG_POWER_CABLES_90) )
+            {   groups.insert( ResourceGroup::resMap.find("PowerLine")->second );}
+        }
+    }
+}
+
+/*
+ * Create the textures for the visible tiles, queue those around the
+ * screen for the loader thread and evict unused ones over the budget.
+ * Only the main thread may call this.
+ */
+void GameView::updateResidency(const Rect2D& area)
+{
+    residency->beginFrame();
+
+    std::set<ResourceGroup*> visible;
+    collectGroups( area, visible );
+    if( hideHigh )
+    {   visible.insert( ResourceGroup::resMap.find("Green")->second );}
+    for(std::set<ResourceGroup*>::iterator it = visible.begin(); it != visible.end(); ++it)
+    {   residency->require( *it );}
+
+    //prefetch a quarter screen in every direction
+    float marginX = area.getWidth() / 4;
+    float marginY = area.getHeight() / 4;
+    std::set<ResourceGroup*> nearby;
+    collectGroups( Rect2D( area.p1.x - marginX, area.p1.y - marginY,
+        area.p2.x + marginX, area.p2.y + marginY ), nearby );
+    for(std::set<ResourceGroup*>::iterator it = nearby.begin(); it != nearby.end(); ++it)
+    {
+        if( !visible.count( *it ) )
+        {   residency->prefetch( *it );}
+    }
+
+    residency->evict();
+}
+
+struct TileBand
+{
+    GameView* view;
+    PainterSDL* painter;
+    Rect2D area;
+};
+
+//Static function to use with ThreadPool::run
+void GameView::drawBand(void* data)
+{
+    PROFILE_ZONE("GameView::drawBand");
+    TileBand* band = (TileBand*) data;
+    band->view->drawTiles( *band->painter, band->area );
+}
+
+/*
+ * Let the render threads draw the tiles of area in horizontal bands. Every
+ * band is drawn back to front and clipped to itself, so the result is the
+ * same as drawTiles( painter, area ). Only the SDL painter supports this.
+ * Returns false if the tiles have to be drawn serially.
+ */
+bool GameView::drawTilesParallel(Painter& painter, const Rect2D& area)
+{
+    if( getConfig()->renderThreads == 1 || !textures_ready )
+    {   return false;}
+    PainterSDL* painterSDL = dynamic_cast<PainterSDL*> (&painter);
+    if( !painterSDL )
+    {   return false;}
+    //images must not be converted to textures outside the main thread
+    if( remaining_images )
+    {   fetchTextures();}
+    if( remaining_images )
+    {   return false;}
+
+    if( !renderPool )
+    {   renderPool = new ThreadPool( getConfig()->renderThreads );}
+    if( renderPool->getThreadCount() < 2 )
+    {   return false;}
+
+    //more bands than threads even out crowded and empty parts of the screen
+    int bands = 2 * renderPool->getThreadCount();
+    float bandHeight = area.getHeight() / bands;
+    if( bandHeight < tileHeight )
+    {   bandHeight = tileHeight;}
+
+    std::vector<TileBand> jobs;
+    for(float y = area.p1.y; y < area.p2.y; y += bandHeight )
+    {
+        TileBand band;
+        band.view = this;
+        band.area = Rect2D( area.p1.x, y, area.p2.x,
+            ( y + bandHeight < area.p2.y ) ? y + bandHeight : area.p2.y );
+        band.painter = painterSDL->createBandPainter( band.area );
+        if( !band.painter )
+        {   break;}
+        jobs.push_back( band );
+    }
+
+    bool complete = !jobs.empty() && jobs.back().area.p2.y >= area.p2.y;
+    if( complete )
+    {
+        std::vector<void*> data;
+        for(size_t i = 0; i < jobs.size(); ++i)
+        {   data.push_back( &jobs[i] );}
+        renderPool->run( drawBand, &data[0], data.size() );
+    }
+    for(size_t i = 0; i < jobs.size(); ++i)
+    {   delete jobs[i].painter;}
+    return complete;
+}
+
 /*
  *  Paint an isometric View of the City in the component.
  */
 void GameView::draw(Painter& painter)
 {
+    PROFILE_ZONE("GameView::draw");
     //If the centre of the Screen is not Part of the city
     //adjust viewport so it is.
     MapPoint centerTile = getCenter();
@@ -1499,17 +1812,12 @@ void GameView::draw(Painter& painter)
     upperRightTile.x += extratiles;
     lowerLeftTile.y +=  extratiles;
 
+    if( residency && textures_ready )
+    {   updateResidency( background );}
     if (mapOverlay != overlayOnly)
     {
-        for(int k = 0; k <= 2 * ( lowerLeftTile.y - upperLeftTile.y ); k++ )
-        {
-            for(int i = 0; i <= upperRightTile.x - upperLeftTile.x; i++ )
-            {
-                currentTile.x = upperLeftTile.x + i + k / 2 + k % 2;
-                currentTile.y = upperLeftTile.y - i + k / 2;
-                drawTile( painter, currentTile );
-            }
-        }
+        if( !drawTilesParallel( painter, background ) )
+        {   drawTiles( painter, background );}
     }
     if( mapOverlay != overlayNone )
     {
@@ -1608,8 +1916,7 @@ void GameView::draw(Painter& painter)
         }
         else if( userOperation->action == UserOperation::ACTION_BUILD)
         {
-            std::string buildingName =  userOperation->constructionGroup->name;
-            prize << dictionaryManager->get_dictionary().translate( buildingName );
+            prize << dictionaryManager->get_dictionary().translate( userOperation->constructionGroup->name );
             prize << _(": Cost to build ");
             if( cost > 0 ) {
                 prize << cost << _("$");
@@ -1692,7 +1999,7 @@ int GameView::bulldozeCost( MapPoint tile ){
 
     if (!world.is_visible(tile.x, tile.y))
     {   return 0;}
-    Construction *reportingConstruction = world(tile.x, tile.y)->reportingConstruction;
+    Construction *reportingConstruction = world(tile.x, tile.y)->reportingConstruction();
     if (reportingConstruction)
     {   return reportingConstruction->constructionGroup->bul_cost;}
     else
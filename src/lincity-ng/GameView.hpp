@@ -22,10 +22,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "gui/XmlReader.hpp"
 #include "gui/Vector2.hpp"
 #include "gui/Texture.hpp"
+#include "gui/ThreadPool.hpp"
+#include "TextureResidency.hpp"
 #include <time.h>
 #include <SDL.h>
 #include <SDL_thread.h>
 #include <SDL_image.h>
+#include <set>
 
 #include "lincity/engglobs.h"
 #include "MapPoint.hpp"
@@ -48,6 +51,8 @@ public:
     //Show City Tile(x/y) by centering the screen
     void show(MapPoint point, bool redraw = true );
     MapPoint getCenter();
+    //tile under the mouse, false if the mouse is not over the city
+    bool getTileUnderMouse( MapPoint& tile );
 
     //Set Zoomlevel to default
     void resetZoom();
@@ -75,6 +80,11 @@ public:
 
     void printStatusMessage( std::string message );
 
+    //hold the loader and render threads where they hold no lock, e.g. around
+    //fork(), false while the images are still read
+    bool pauseThreads();
+    void resumeThreads();
+
     void fetchTextures(void);
     //convert all remaining images in ConstructionGroup::reourceMap to textures
 
@@ -82,6 +92,8 @@ public:
     bool inCity( MapPoint tile );
 
     int gameAreaMax();
+    //load an image from images/tiles, may be called from any thread
+    static SDL_Surface* readImage(const std::string& filename);
     bool textures_ready;
     //bool economyGraph_open;
     int remaining_images;
@@ -92,14 +104,20 @@ private:
     void recenter(const Vector2& pos);
     Vector2 getScreenPoint(MapPoint point);
     MapPoint getTile(const Vector2& point);
+    void drawTiles(Painter& painter, const Rect2D& area);
+    bool drawTilesParallel(Painter& painter, const Rect2D& area);
+    void updateResidency(const Rect2D& area);
+    void collectGroups(const Rect2D& area, std::set<ResourceGroup*>& groups);
+    static void drawBand(void* data);
     void drawTile(Painter& painter, const MapPoint &point);
-    void drawTexture(Painter& painter, const MapPoint &point, GraphicsInfo *graphicsInfo);
+    void drawTexture(Painter& painter, const MapPoint &point, GraphicsInfo *graphicsInfo,
+        int move_x = 0, int move_y = 0);
     void drawOverlay(Painter& painter, const MapPoint &point);
     void fillDiamond( Painter& painter, const Rect2D& rect );
     void drawDiamond( Painter& painter, const Rect2D& rect );
     static int gameViewThread(void* data);
     void setZoom(float newzoom);
-    SDL_Surface* readImage(const std::string& filename);
+    static void decodeImage(void* data);
     void preReadImages(void);
     Texture* readTexture(const std::string& filename);
     //void loadTextures();
@@ -136,6 +154,10 @@ private:
     //SDL_mutex* mThreadRunning;
     SDL_Thread* loaderThread;
     bool stopThread;
+    //render threads for the SDL painter
+    ThreadPool* renderPool;
+    //creates and evicts textures on demand, 0 if all are kept
+    TextureResidency* residency;
 
     MapPoint tileUnderMouse;
     Vector2 dragStart;
@@ -32,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "lincity/lc_locale.h"
 #include "lincity/fileutil.h"
 #include "lincity/loadsave.h"
+#include "lincity/engglobs.h"
 #include "lincity/modules/all_modules.h"
 
 #include "gui_interface/screen_interface.h"
@@ -46,6 +47,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "ScreenInterface.hpp"
 #include "Dialog.hpp"
 #include "Config.hpp"
+#include "EconomyGraph.hpp"
 
 extern void print_total_money(void);
 extern void init_types(void);
@@ -56,6 +58,9 @@ int lincitySpeed = MED_TIME_FOR_YEAR;
 
 void setLincitySpeed( int speed )
 {
+    //cars draw random numbers depending on the speed, so replays need it
+    if( speed != lincitySpeed )
+        journal.record( Journal::OP_SPEED, 0, 0, speed );
     lincitySpeed = speed;
 }
 
@@ -67,12 +72,18 @@ void execute_timestep ()
     get_real_time();
 
     if( lincitySpeed == 0 || blockingDialogIsOpen ) {
+        //frames drawn while paused belong to no day
+        long long idle[ Profiler::PHASE_COUNT ];
+        Profiler::takePhaseTimes( idle );
         SDL_Delay(10); //don't burn cpu in active loop
         return;
     }
 
     // Do the simulation. Remember 1 month = 100 days, only the display fits real life :)
     do_time_step();
+    getEconomyGraph()->newPhaseTimes();
+    rewindBuffer.update();
+    deltaSave.update();
 
     //draw the updated city
     if ( lincitySpeed != fast_time_for_year) {
@@ -132,8 +143,17 @@ bool loadCityNG( std::string filename ){
         filename = dir + PHYSFS_getDirSeparator() + filename;
         if( file_exists( const_cast<char*>( filename.c_str()) ) )
         {
-            load_city_2(const_cast<char*>(filename.c_str()));
-            update_avail_modules(0);
+            //an autosave journal
+            std::string delta = ".delta";
+            if( filename.length() > delta.length() && filename.compare(
+                    filename.length() - delta.length(), delta.length(), delta ) == 0 ){
+                if( !DeltaSave::restore( filename ) ){
+                    return false;
+                }
+            } else {
+                load_city_2(const_cast<char*>(filename.c_str()));
+                update_avail_modules(0);
+            }
             GameView* gv = getGameView();
             if( gv ){ gv->readOrigin(); }
             return true;
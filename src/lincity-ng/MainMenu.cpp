@@ -149,7 +149,7 @@ void MainMenu::fillNewGameMenu()
       // save real name
       fileMap.insert(std::pair<std::string, std::string>(buttonNames[i], f ));
       // use translated name for caption
-      button->setCaptionText(_(f.c_str()));
+      button->setCaptionText(translated(f.c_str()));
       fptr++;
     }
     else
@@ -45,8 +45,8 @@ int last_message_group = 0;
 /* #ifdef DEBUG
     void DBG_TileInfo(int x, int y) {
     fprintf(stderr, "%u,%u:Type=%d, Group=%s(%d), Flags= %08X, Alt.=%d\n", x, y,
-        world(x, y)->type, _(main_groups[world(x, y)->group].name), world(x, y)->group,
-        world(x, y)->flags, world(x, y)->ground.altitude);
+        world(x, y)->type, translated(main_groups[world(x, y)->group].name), world(x, y)->group,
+        world(x, y)->flags, world.ground(x, y)->altitude);
     }
     #endif
 */
@@ -62,10 +62,10 @@ void check_bulldoze_area (int x, int y)
     //no need to bulldoze desert
     if( g == GROUP_DESERT )
     {    return;}
-    if (world(x,y)->reportingConstruction)
+    if (world(x,y)->reportingConstruction())
     {
-        xx = world(x,y)->reportingConstruction->x;
-        yy = world(x,y)->reportingConstruction->y;
+        xx = world(x,y)->reportingConstruction()->x;
+        yy = world(x,y)->reportingConstruction()->y;
     }
     else
     {
@@ -75,7 +75,7 @@ void check_bulldoze_area (int x, int y)
 
     if (g == GROUP_MONUMENT && monument_bul_flag == 0)
     {
-        if( (world(x,y)->reportingConstruction->flags & FLAG_EVACUATE)
+        if( (world(x,y)->reportingConstruction()->flags & FLAG_EVACUATE)
         && (last_message_group != GROUP_MONUMENT) )
         {
             new Dialog( BULLDOZE_MONUMENT, xx, yy ); // deletes itself
@@ -101,7 +101,7 @@ void check_bulldoze_area (int x, int y)
     }
     // only empty landfills may be bulldozed
     else if ( g == GROUP_TIP
-    && static_cast<Tip *>(world(x,y)->reportingConstruction)->total_waste > 0 )
+    && static_cast<Tip *>(world(x,y)->reportingConstruction())->total_waste > 0 )
     {
       if( last_message_group != GROUP_TIP )
     {
@@ -130,10 +130,10 @@ void editMap (MapPoint point, int button)
     int mod_x, mod_y; // upper left coords of module clicked on
     int mps_result;
 
-    if(world(x,y)->reportingConstruction)
+    if(world(x,y)->reportingConstruction())
     {
-        mod_x = world(x,y)->reportingConstruction->x;
-        mod_y = world(x,y)->reportingConstruction->y;
+        mod_x = world(x,y)->reportingConstruction()->x;
+        mod_y = world(x,y)->reportingConstruction()->y;
     }
     else
     {
@@ -152,7 +152,7 @@ void editMap (MapPoint point, int button)
         return;
     }
     // show info on any click, but dont do double for query
-    if ((!world(mod_x,mod_y)->reportingConstruction) || (userOperation->action != UserOperation::ACTION_QUERY))
+    if ((!world(mod_x,mod_y)->reportingConstruction()) || (userOperation->action != UserOperation::ACTION_QUERY))
     {
         mps_set(mod_x, mod_y, MPS_MAP); //fake Query action
         if(userOperation->action == UserOperation::ACTION_QUERY)
@@ -167,12 +167,7 @@ void editMap (MapPoint point, int button)
     //from here on everything should be allowed
     if (userOperation->action == UserOperation::ACTION_FLOOD && button != SDL_BUTTON_RIGHT)
     {
-        world(x, y)->setTerrain(GROUP_WATER);
-        world(x, y)->flags |= FLAG_ALTERED;
-        adjust_money(-selected_module_cost);
-        connect_transport(x - 2, y - 2, x + 1 + 1, y + 1 + 1);
-        desert_water_frontiers(x - 1, y - 1, 1 + 2, 1 + 2);
-        connect_rivers(x, y);
+        flood_tile(x, y, selected_module_cost);
         return;
     }
 
@@ -220,15 +215,7 @@ void editMap (MapPoint point, int button)
     //Handle Evacuation of Commodities
     if (userOperation->action == UserOperation::ACTION_EVACUATE && button != SDL_BUTTON_RIGHT)
     {
-        if(world(x,y)->reportingConstruction->constructionGroup->group == GROUP_MARKET)
-        {
-            (dynamic_cast<Market*>(world(x,y)->reportingConstruction))->toggleEvacuation();
-            return;
-        }
-        if(world(x,y)->reportingConstruction->flags & FLAG_EVACUATE)
-        {   world(x,y)->reportingConstruction->flags &= ~FLAG_EVACUATE;}
-        else
-        {   world(x,y)->reportingConstruction->flags |= FLAG_EVACUATE;}
+        toggle_evacuation(x, y);
         mps_result = mps_set( mod_x, mod_y, MPS_MAP ); // Update mps on evacuate
         return;
     }
@@ -38,6 +38,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "lincity/all_buildings.h"
 #include "lincity/transport.h"
 #include "lincity/modules/all_modules.h"
+#include "lincity/Profiler.h"
 
 #include "gui/callback/Callback.hpp"
 
@@ -54,6 +55,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "Dialog.hpp"
 #include "Game.hpp"
 #include "HelpWindow.hpp"
+#include "EconomyGraph.hpp"
 
 
 /** List of mapview buttons. The "" entries separate mapview buttons that are
@@ -659,11 +661,9 @@ MiniMap::scrollPageDown(bool down)
         mps_global_style = (mps_global_style + (down?1:(MPS_GLOBAL_STYLES-1))) % MPS_GLOBAL_STYLES;
         mps_set(mps_x, mps_y, MPS_GLOBAL);
     }
-#ifdef DEBUG
     else if(viewname == "EconomyGraph")
-    {
-        //has only one page for now
-    }
+    {   getEconomyGraph()->scrollPage(down);}
+#ifdef DEBUG
     else if(viewname == "EnvMPS")
     {
         //has only one page for now
@@ -699,6 +699,7 @@ void MiniMap::setGameViewCorners(
 
 void MiniMap::draw(Painter &painter)
 {
+    PROFILE_ZONE("MiniMap::draw");
     attachButtons();
     int x, y;
     unsigned short size;
@@ -725,13 +726,13 @@ void MiniMap::draw(Painter &painter)
                 {
                     if (world.is_visible(left+x, top+y)) /*left + x > 0 && top + y > 0 && left + x < world.len()-1 && top + y < world.len()-1)*/
                     {
-                        if( (world(left + x, top + y)->construction)) {
-                            size = world(left + x, top + y)->construction->constructionGroup->size;
+                        if( (world(left + x, top + y)->construction())) {
+                            size = world(left + x, top + y)->construction()->constructionGroup->size;
                             mc = getColor(left + x,top + y);
                             painter.setFillColor(mc);
                             painter.fillRectangle(Rect2D((x)*tilesize,y*tilesize,(x+size)*tilesize+1,(y+size)*tilesize));
                         }
-                        else if( !world(left + x, top + y)->reportingConstruction)
+                        else if( !world(left + x, top + y)->reportingConstruction())
                         {
                             size = world(left + x, top + y)->getTileConstructionGroup()->size;
                             mc=getColor(left + x,top + y);
@@ -768,13 +769,13 @@ void MiniMap::draw(Painter &painter)
             {
                 if (world.is_visible(left+x, top+y))
                 {
-                    if( (world(left + x, top + y)->construction)) {
-                        size = world(left + x, top + y)->construction->constructionGroup->size;
+                    if( (world(left + x, top + y)->construction())) {
+                        size = world(left + x, top + y)->construction()->constructionGroup->size;
                         mc = getColor(left + x,top + y);
                         mpainter->setFillColor(mc);
                         mpainter->fillRectangle(Rect2D((x)*tilesize,(y)*tilesize,(x+size)*tilesize+1,(y+size)*tilesize));
                     }
-                    else if ( (!world(left + x, top + y)->reportingConstruction) )
+                    else if ( (!world(left + x, top + y)->reportingConstruction()) )
                     {
                         size = world(left + x, top + y)->getTileConstructionGroup()->size;
                         mc = getColor(left + x, top + y);
@@ -833,14 +834,14 @@ Color MiniMap::getColor(int x,int y) const
     unsigned short g = world(x,y)->getGroup();
 
     // only needed to look up xx,yy for old style flags
-    if (world(x,y)->reportingConstruction)
+    if (world(x,y)->reportingConstruction())
     {
-        xx = world(x,y)->reportingConstruction->x;
-        yy = world(x,y)->reportingConstruction->y;
-        conflags = world(x,y)->reportingConstruction->flags;
+        xx = world(x,y)->reportingConstruction()->x;
+        yy = world(x,y)->reportingConstruction()->y;
+        conflags = world(x,y)->reportingConstruction()->flags;
     }
 
-    mapflags = world(xx,yy)->flags;
+    mapflags = world(xx,yy)->flags();
     switch(mMode)
     {
         case NORMAL:
@@ -850,7 +851,7 @@ Color MiniMap::getColor(int x,int y) const
             if (world(xx,yy)->is_bare())
                 {
                 // show ground altitude
-                int alt = world(xx,yy)->ground.altitude;
+                int alt = world.ground(xx,yy)->altitude;
                 if (alt > alt_min + 9 * alt_step)
                     return Color(255,255,255);          // white
                 else if ( alt > alt_min + 8 * alt_step )
@@ -878,7 +879,7 @@ Color MiniMap::getColor(int x,int y) const
             {   return getColorNormal(xx,yy);}
         case POLLUTION:
         {
-            short p = world(x,y)->pollution;
+            short p = world(x,y)->pollution();
             float v = p/600.0;
             if(v < 0)
                 v = 0;
@@ -891,7 +892,7 @@ Color MiniMap::getColor(int x,int y) const
         case FIRE:
             if( world(xx,yy)->getGroup() == GROUP_FIRE )
             {
-                if( ! static_cast<Fire*>(world(xx,yy)->reportingConstruction)->smoking_days )
+                if( ! static_cast<Fire*>(world(xx,yy)->reportingConstruction())->smoking_days )
                 {
                     return Color(0xFF,0,0); //still burning (red)
                 } else  {
@@ -905,19 +906,19 @@ Color MiniMap::getColor(int x,int y) const
                 return Color(0xFF,0xFF,0); //(yellow)
             }
 */
-            if( world(xx,yy)->reportingConstruction && world(xx,yy)->reportingConstruction->constructionGroup == &fireStationConstructionGroup)
+            if( world(xx,yy)->reportingConstruction() && world(xx,yy)->reportingConstruction()->constructionGroup == &fireStationConstructionGroup)
             {
                 return Color(0,0xFF,0); //green
             }
             //fall through
         case CRICKET:
-            if( (world(xx,yy)->reportingConstruction && world(xx,yy)->reportingConstruction->constructionGroup == &cricketConstructionGroup)  && mMode==CRICKET )
+            if( (world(xx,yy)->reportingConstruction() && world(xx,yy)->reportingConstruction()->constructionGroup == &cricketConstructionGroup)  && mMode==CRICKET )
             {
                 return Color(0,0xFF,0); //green
             }
             //fall through
         case HEALTH:
-            if( (world(xx,yy)->reportingConstruction && world(xx,yy)->reportingConstruction->constructionGroup == &healthCentreConstructionGroup)  && mMode==HEALTH )
+            if( (world(xx,yy)->reportingConstruction() && world(xx,yy)->reportingConstruction()->constructionGroup == &healthCentreConstructionGroup)  && mMode==HEALTH )
             {
                 return Color(0,0xFF,0); //green
             }
@@ -933,8 +934,8 @@ Color MiniMap::getColor(int x,int y) const
                 return makeGrey(getColorNormal(xx,yy));
         case UB40: {
             /* Display residence with un/employed people (red / green) == too many people here */
-            int job_level = world(xx,yy)->reportingConstruction?
-            world(xx,yy)->reportingConstruction->tellstuff(Construction::STUFF_JOBS, -1):-1;
+            int job_level = world(xx,yy)->reportingConstruction()?
+            world(xx,yy)->reportingConstruction()->tellstuff(Construction::STUFF_JOBS, -1):-1;
             if (job_level == -1) // Not a "jobby" place at all
             {
                 return makeGrey(getColorNormal(xx,yy));
@@ -970,21 +971,21 @@ Color MiniMap::getColor(int x,int y) const
             {
                 return Color(0,0,0);
             }
-            if(world(x,y)->coal_reserve==0)
+            if(world(x,y)->coal_reserve()==0)
                 return makeGrey(getColorNormal(x,y));
-            else if (world(x,y)->coal_reserve >= COAL_RESERVE_SIZE / 2)
+            else if (world(x,y)->coal_reserve() >= COAL_RESERVE_SIZE / 2)
                 return Color(0,0xFF,0);
-            else if (world(x,y)->coal_reserve < COAL_RESERVE_SIZE / 2)
+            else if (world(x,y)->coal_reserve() < COAL_RESERVE_SIZE / 2)
                 return Color(0xFF,0,0);
 
             return c;
         }
         case STARVE:
         {
-            int food_level = world(xx,yy)->reportingConstruction?
-            world(xx,yy)->reportingConstruction->tellstuff(Construction::STUFF_FOOD, -1):1;
-            int water_level = world(xx,yy)->reportingConstruction?
-            world(xx,yy)->reportingConstruction->tellstuff(Construction::STUFF_WATER, -1):1;
+            int food_level = world(xx,yy)->reportingConstruction()?
+            world(xx,yy)->reportingConstruction()->tellstuff(Construction::STUFF_FOOD, -1):1;
+            int water_level = world(xx,yy)->reportingConstruction()?
+            world(xx,yy)->reportingConstruction()->tellstuff(Construction::STUFF_WATER, -1):1;
             int crit_level = water_level<food_level?water_level:food_level;
             //dont care about other eaters or drinkers
             if ( world(xx,yy)->is_residence() )
@@ -1005,10 +1006,10 @@ Color MiniMap::getColor(int x,int y) const
             /* default color = grey */
             //mc = Color(0x3F,0x3F,0x3F);
             mc = makeGrey(getColorNormal(xx,yy));
-            int kwh_level = world(xx,yy)->reportingConstruction?
-            world(xx,yy)->reportingConstruction->tellstuff(Construction::STUFF_KWH, -1):-1;
-            int mwh_level = world(xx,yy)->reportingConstruction?
-            world(xx,yy)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -1):-1;
+            int kwh_level = world(xx,yy)->reportingConstruction()?
+            world(xx,yy)->reportingConstruction()->tellstuff(Construction::STUFF_KWH, -1):-1;
+            int mwh_level = world(xx,yy)->reportingConstruction()?
+            world(xx,yy)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -1):-1;
             if (kwh_level > -1 || mwh_level > -1)
             {
                 /* not enough power */
@@ -1032,14 +1033,14 @@ Color MiniMap::getColor(int x,int y) const
                 if (conflags & FLAG_IS_TRANSPORT)
                 {
                     Transport *transport;
-                    transport = static_cast<Transport *>(world(xx,yy)->reportingConstruction);
+                    transport = static_cast<Transport *>(world(xx,yy)->reportingConstruction());
                     if(transport->trafficCount.count(stuff_ID))
                     {   loc_lvl = transport->trafficCount[stuff_ID];}
                 }
                 else if (g == GROUP_POWER_LINE)
                 {
                     Powerline *powerline;
-                    powerline = static_cast<Powerline *>(world(xx,yy)->reportingConstruction);
+                    powerline = static_cast<Powerline *>(world(xx,yy)->reportingConstruction());
                     if(powerline->trafficCount.count(stuff_ID))
                     {   loc_lvl = powerline->trafficCount[stuff_ID];}
                 }
@@ -1071,8 +1072,8 @@ Color MiniMap::getColor(int x,int y) const
             if (conflags & FLAG_IS_TRANSPORT)
                 return makeGrey(getColorNormal(xx,yy));
 */
-            float loc_lvl = world(xx,yy)->reportingConstruction?
-                 world(xx,yy)->reportingConstruction->tellstuff(stuff_ID, -1):-1;
+            float loc_lvl = world(xx,yy)->reportingConstruction()?
+                 world(xx,yy)->reportingConstruction()->tellstuff(stuff_ID, -1):-1;
             float red, green, blue;
 
             if (loc_lvl < 0)
@@ -1082,11 +1083,11 @@ Color MiniMap::getColor(int x,int y) const
             {   loc_lvl = 1 - loc_lvl;}
             red = 1 - 2.25 * loc_lvl;
             if (red < 0) red = 0;
-            if (!world(xx,yy)->reportingConstruction->constructionGroup->commodityRuleCount[stuff_ID].take)
+            if (!world(xx,yy)->reportingConstruction()->constructionGroup->commodityRuleCount[stuff_ID].take)
             {   red = 0;}
             blue = 1 - 2.25 * (1 - loc_lvl);
             if (blue < 0) blue = 0;
-            if (!world(xx,yy)->reportingConstruction->constructionGroup->commodityRuleCount[stuff_ID].give)
+            if (!world(xx,yy)->reportingConstruction()->constructionGroup->commodityRuleCount[stuff_ID].give)
             {   blue = 0;}
             green = 1 - red - blue;
             Color mc(static_cast<int>(0xFF*red), static_cast<int>(0xFF*green),static_cast<int>(0xFF*blue));
@@ -104,7 +104,7 @@ Mps::setView(MapPoint point, int style /* = MPS_MAP */ )
     int x = point.x;
     int y = point.y;
     if( !world.is_inside(x, y)) {return;}
-    Construction *reportingConstruction = world(x,y)->reportingConstruction;
+    Construction *reportingConstruction = world(x,y)->reportingConstruction();
     if (reportingConstruction) {
         x = reportingConstruction->x;
         y = reportingConstruction->y;
@@ -118,20 +118,20 @@ Mps::setView(MapPoint point, int style /* = MPS_MAP */ )
 void
 Mps::playBuildingSound(int mps_x, int mps_y)
 {
-    if(world(mps_x, mps_y)->reportingConstruction)
+    if(world(mps_x, mps_y)->reportingConstruction())
     {
-        unsigned short group = world(mps_x, mps_y)->reportingConstruction->constructionGroup->group;
+        unsigned short group = world(mps_x, mps_y)->reportingConstruction()->constructionGroup->group;
         if( group == GROUP_ROAD || group == GROUP_ROAD_BRIDGE)
-        {   dynamic_cast<Transport *>(world(mps_x, mps_y)->reportingConstruction)->playSound();}
+        {   dynamic_cast<Transport *>(world(mps_x, mps_y)->reportingConstruction())->playSound();}
         else
-        {   world(mps_x, mps_y)->reportingConstruction->playSound();}
+        {   world(mps_x, mps_y)->reportingConstruction()->playSound();}
     }
     else
     {
         ResourceGroup* resourceGroup = world(mps_x, mps_y)->getTileResourceGroup();
         int s = resourceGroup->chunks.size();
         if(s)
-        {   getSound()->playASound( resourceGroup->chunks[ rand()%s ] );}
+        {   getSound()->playASound( resourceGroup->chunks[ getSound()->random(s) ] );}
     }
     std::cout.flush();
 }
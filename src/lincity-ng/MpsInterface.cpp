@@ -114,9 +114,9 @@ void mps_refresh() /* refresh the information display's contents */
     {
         case MPS_MAP:
             currentMPS = mapMPS;
-            if (world(mps_x, mps_y)->reportingConstruction)
+            if (world(mps_x, mps_y)->reportingConstruction())
             {
-                world(mps_x, mps_y)->reportingConstruction->report();
+                world(mps_x, mps_y)->reportingConstruction()->report();
             }
             else
                {
@@ -140,9 +140,9 @@ void mps_refresh() /* refresh the information display's contents */
  /*#ifdef DEBUG
                     mps_store_sd(10, "x", mps_x);
                     mps_store_sd(11, "y", mps_y);
-                    mps_store_sd(12, "altitude", world(mps_x, mps_y)->ground.altitude);
+                    mps_store_sd(12, "altitude", world.ground(mps_x, mps_y)->altitude);
 
-                    fprintf(stderr, "x %i, y %i, Alt %i\n", mps_x, mps_y, world(mps_x, mps_y)->ground.altitude);
+                    fprintf(stderr, "x %i, y %i, Alt %i\n", mps_x, mps_y, world.ground(mps_x, mps_y)->altitude);
  #endif
  */
              } //endswitch groups
@@ -168,6 +168,12 @@ void mps_refresh() /* refresh the information display's contents */
                 case MPS_GLOBAL_HOUSING:
                     mps_global_housing();
                     break;
+                case MPS_GLOBAL_TIME_COSTS:
+                    mps_global_time_costs();
+                    break;
+                case MPS_GLOBAL_MEMORY_COSTS:
+                    mps_global_memory_costs();
+                    break;
                 default:
                     printf("MPS unimplemented for global display\n");
                     break;
@@ -198,7 +204,7 @@ void mps_store_title(int i, const std::string &t)
     if(!currentMPS)
         return;
 
-    currentMPS->setText(i,_(t.c_str()));
+    currentMPS->setText(i,translated(t.c_str()));
 }
 
 void mps_store_fp(int i, double f)
@@ -229,7 +235,7 @@ void mps_store_sf(int i, const std::string &s, double fl)
 
     std::ostringstream os;
     os<<std::setprecision(1)<<std::fixed;
-    os<<_(s.c_str())<<"\t"<<fl;
+    os<<translated(s.c_str())<<"\t"<<fl;
     currentMPS->setText(i,os.str());
 }
 
@@ -250,7 +256,7 @@ void mps_store_ss(int i, const std::string &s1, const std::string &s2)
         return;
 
     std::ostringstream os;
-    os<<_(s1.c_str())<<"\t"<<_(s2.c_str());
+    os<<translated(s1.c_str())<<"\t"<<translated(s2.c_str());
     currentMPS->setText(i,os.str());
 }
 
@@ -260,7 +266,7 @@ void mps_store_sd(int i, const std::string &s, int d)
         return;
 
     std::ostringstream os;
-    os<<_(s.c_str())<<"\t"<<d;
+    os<<translated(s.c_str())<<"\t"<<d;
     currentMPS->setText(i,os.str());
 }
 
@@ -270,7 +276,7 @@ void mps_store_ssd(int i, const std::string &s1, const std::string &s2, int d)
         return;
 
     std::ostringstream os;
-    os<<_(s1.c_str())<<"\t"<<_(s2.c_str())<<"\t"<<d;
+    os<<translated(s1.c_str())<<"\t"<<translated(s2.c_str())<<"\t"<<d;
     currentMPS->setText(i,os.str());
 }
 
@@ -281,7 +287,7 @@ void mps_store_sfp(int i, const std::string &s, double fl)
 
     std::ostringstream os;
     os<<std::setprecision(1)<<std::fixed;
-    os<<_(s.c_str())<<"\t"<<fl<<"%";
+    os<<translated(s.c_str())<<"\t"<<fl<<"%";
     currentMPS->setText(i,os.str());
 }
 
@@ -291,7 +297,7 @@ void mps_store_sdd(int i, const std::string &s, int d1, int d2)
         return;
 
     std::ostringstream os;
-    os<<_(s.c_str())<<"\t"<<d1<<"\t"<<d2;
+    os<<translated(s.c_str())<<"\t"<<d1<<"\t"<<d2;
     currentMPS->setText(i,os.str());
 }
 
@@ -302,7 +308,7 @@ void mps_store_sddp(int i, const std::string &s, int d, int max)
 
     std::ostringstream os;
     os<<std::setprecision(1)<<std::fixed;
-    os<<_(s.c_str())<<"\t"<<d<<"\t"<<(d*100.0/max)<<"%";
+    os<<translated(s.c_str())<<"\t"<<d<<"\t"<<(d*100.0/max)<<"%";
     currentMPS->setText(i,os.str());
 }
 
@@ -313,7 +319,7 @@ void mps_store_ssddp(int i, const std::string &ascii, const std::string &s2, int
 
     std::ostringstream os;
     os<<std::setprecision(1)<<std::fixed;
-    os<<ascii<<_(s2.c_str())<<"\t"<<d<<"\t"<<(d*100.0/max)<<"%";
+    os<<ascii<<translated(s2.c_str())<<"\t"<<d<<"\t"<<(d*100.0/max)<<"%";
     currentMPS->setText(i,os.str());
 }
 
@@ -336,8 +342,8 @@ void mps_right (int x, int y)
 {
     int i = 0;
     const char* p;
-    unsigned short group = world(x,y)->group;
-    int pol = world(x,y)->pollution;
+    unsigned short group = world(x,y)->group();
+    int pol = world(x,y)->pollution();
     currentMPS = envMPS;
 
     Uint8 *keystate = SDL_GetKeyState(NULL);
@@ -345,13 +351,13 @@ void mps_right (int x, int y)
     {   world(x,y)->saveMembers(&std::cout);}
     mps_store_sdd(i++, world(x, y)->getTileConstructionGroup()->name, x, y);
 
-    p = ((world(x,y)->flags & FLAG_HAS_UNDERGROUND_WATER) != 0) ? N_("Yes") : N_("No");
+    p = ((world(x,y)->flags() & FLAG_HAS_UNDERGROUND_WATER) != 0) ? N_("Yes") : N_("No");
     mps_store_ss(i++, N_("Fertile"), p);
     if( group == GROUP_WATER)
     {
-        if ( world(x,y)->flags & FLAG_IS_LAKE )
+        if ( world(x,y)->flags() & FLAG_IS_LAKE )
         {   p = N_("Lake");}
-        else if ( world(x,y)->flags & FLAG_IS_RIVER )
+        else if ( world(x,y)->flags() & FLAG_IS_RIVER )
         {   p = N_("River");}
         else
         {   p = N_("Pond");}
@@ -361,16 +367,16 @@ void mps_right (int x, int y)
     {
         i++;
     }
-    p = (world(x,y)->flags & FLAG_FIRE_COVER) ? N_("Yes") : N_("No");
+    p = (world(x,y)->flags() & FLAG_FIRE_COVER) ? N_("Yes") : N_("No");
     mps_store_ss(i++, N_("Fire Protection"), p);
 
-    p = (world(x,y)->flags & FLAG_HEALTH_COVER) ? N_("Yes") : N_("No");
+    p = (world(x,y)->flags() & FLAG_HEALTH_COVER) ? N_("Yes") : N_("No");
     mps_store_ss(i++, N_("Health Care"), p);
 
-    p = (world(x,y)->flags & FLAG_CRICKET_COVER) ? N_("Yes") : N_("No");
+    p = (world(x,y)->flags() & FLAG_CRICKET_COVER) ? N_("Yes") : N_("No");
     mps_store_ss(i++, N_("Public Sports"), p);
 
-    p = (world(x,y)->flags & FLAG_MARKET_COVER) ? N_("Yes") : N_("No");
+    p = (world(x,y)->flags() & FLAG_MARKET_COVER) ? N_("Yes") : N_("No");
     mps_store_ss(i++, N_("Market Range"), p);
 
     if (pol < 10)
@@ -394,9 +400,9 @@ void mps_right (int x, int y)
 
     mps_store_ssd(i++, N_("Air Pollution"), p, pol);
 
-    if (world(x,y)->reportingConstruction)
+    if (world(x,y)->reportingConstruction())
     {
-        mps_store_sd(i++, N_("Bull. Cost"), world(x,y)->reportingConstruction->constructionGroup->bul_cost);
+        mps_store_sd(i++, N_("Bull. Cost"), world(x,y)->reportingConstruction()->constructionGroup->bul_cost);
     }
     else
     {
@@ -405,13 +411,13 @@ void mps_right (int x, int y)
         else
         {   mps_store_sd(i++, N_("Bull. Cost"), world(x, y)->getTileConstructionGroup()->bul_cost);}
     }
-    mps_store_sd(i++, N_("Ore Reserve"), world(x,y)->ore_reserve);
-    mps_store_sd(i++, N_("Coal Reserve"), world(x,y)->coal_reserve);
-    mps_store_sd(i++, N_("ground level"), world(x,y)->ground.altitude);
+    mps_store_sd(i++, N_("Ore Reserve"), world(x,y)->ore_reserve());
+    mps_store_sd(i++, N_("Coal Reserve"), world(x,y)->coal_reserve());
+    mps_store_sd(i++, N_("ground level"), world.ground(x,y)->altitude);
 /*  //Not needed if altitude == flooding level
     if(world(x,y)->is_water())
     {
-        mps_store_sd(i++, N_("water level"), world(x,y)->ground.water_alt);
+        mps_store_sd(i++, N_("water level"), world.ground(x,y)->water_alt);
 
     }
 */
@@ -547,6 +553,63 @@ void mps_global_housing()
     currentMPS = 0;
 }
 
+void mps_global_time_costs()
+{
+    int i = 0;
+    std::vector<GroupCost> costs;
+    groupCosts.collect(costs, GroupCosts::BY_TIME);
+    int days = groupCosts.days ? groupCosts.days : 1;
+    long long total = 0;
+    for (size_t k = 0; k < costs.size(); ++k)
+    {   total += costs[k].tradeTime + costs[k].updateTime;}
+
+    currentMPS = globalMPS;
+
+    mps_store_title(i++, N_("Time per Type") );
+    if (!groupCosts.enabled)
+    {   mps_store_title(i++, N_("set groupCosts in the config") );}
+    else
+    {   mps_store_sd(i++, N_("Days"), groupCosts.days);}
+    mps_store_sss(i++, "", _("us/day"), "");
+    for (size_t k = 0; k < costs.size() && i < MPS_PARAGRAPH_COUNT; ++k)
+    {
+        long long time = costs[k].tradeTime + costs[k].updateTime;
+        mps_store_sddp(i++, costs[k].constructionGroup->name, time / days, total ? total / days : 1);
+    }
+    //groups may have gone since the last refresh
+    while (i < MPS_PARAGRAPH_COUNT)
+    {   mps_store_title(i++, "");}
+    currentMPS = 0;
+}
+
+void mps_global_memory_costs()
+{
+    int i = 0;
+    std::vector<GroupCost> costs;
+    groupCosts.collect(costs, GroupCosts::BY_MEMORY);
+    size_t total = 0;
+    int count = 0;
+    for (size_t k = 0; k < costs.size(); ++k)
+    {
+        total += costs[k].memory;
+        count += costs[k].count;
+    }
+
+    currentMPS = globalMPS;
+
+    mps_store_title(i++, N_("Memory per Type") );
+    mps_store_sd(i++, N_("Constructions"), count);
+    mps_store_sss(i++, "", _("KiB"), "");
+    for (size_t k = 0; k < costs.size() && i < MPS_PARAGRAPH_COUNT; ++k)
+    {
+        mps_store_sddp(i++, costs[k].constructionGroup->name, costs[k].memory / 1024,
+            total >= 1024 ? total / 1024 : 1);
+    }
+    while (i < MPS_PARAGRAPH_COUNT)
+    {   mps_store_title(i++, "");}
+    currentMPS = 0;
+}
+
 
 /** @file lincity-ng/MpsInterface.cpp */
 
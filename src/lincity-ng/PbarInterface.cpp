@@ -25,6 +25,17 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 
 struct pbar_st pbars[NUM_PBARS];
 
+static int newest_slot (struct pbar_st * pbar)
+{
+    return (pbar->first + pbar->data_size - 1 + PBAR_DATA_SIZE) % PBAR_DATA_SIZE;
+}
+
+int pbar_value (int pbar_num, int i)
+{
+    struct pbar_st * pbar = &pbars[pbar_num];
+    return pbar->data[(pbar->first + i) % PBAR_DATA_SIZE];
+}
+
 void update_pbar (int pbar_num, int value, int month_flag)
 {
     // copy of update_pbar from src/oldgui/pbar.cpp
@@ -35,25 +46,21 @@ void update_pbar (int pbar_num, int value, int month_flag)
     if (month_flag) {
          pbar->oldtot = pbar->tot;
 
-        /* If the dataset isn't full, just add it and forget month_flag */
+        /* If the dataset isn't full, just add it */
         if (pbar->data_size < PBAR_DATA_SIZE)
         {
-            pbar->oldtot += pbar->data[0];// new total has one additional value
+            pbar->oldtot += pbar->data[pbar->first];// new total has one additional value
             pbar->data_size++;
-            month_flag = 0;
         }
+        else
+        {   pbar->first = (pbar->first + 1) % PBAR_DATA_SIZE;}
     }
+    // the oldest slot has become the newest, nothing is moved
+    pbar->data[newest_slot(pbar)] = value;
 
     pbar->tot = 0;
-
-    for (i = 0; i < (pbar->data_size - 1); i++)
-    {
-        if (month_flag)
-        {   pbar->tot += (pbar->data[i] = pbar->data[i+1]);}
-        else
-        {   pbar->tot += pbar->data[i];}
-    }
-    pbar->tot += pbar->data[i] = value;
+    for (i = 0; i < pbar->data_size; i++)
+    {   pbar->tot += pbar->data[i];}
     pbar->diff = pbar->tot - pbar->oldtot;
 
     // new: update bars
@@ -71,9 +78,9 @@ void refresh_pbars (void)
         {
             struct pbar_st * pbar = &pbars[p];
             if (pbarGlobalStyle == 0)
-            {   LCPBarPage1->setValue(p,pbar->data[pbar->data_size - 1],pbar->diff);}
+            {   LCPBarPage1->setValue(p,pbar->data[newest_slot(pbar)],pbar->diff);}
             else if (pbarGlobalStyle == 1)
-            {   LCPBarPage2->setValue(p,pbar->data[pbar->data_size - 1],pbar->diff);}
+            {   LCPBarPage2->setValue(p,pbar->data[newest_slot(pbar)],pbar->diff);}
         }
 }
 
@@ -86,6 +93,7 @@ void init_pbars (void)
         pbars[p].oldtot = 0;
         pbars[p].tot = 0;
         pbars[p].diff = 1;
+        pbars[p].first = 0;
         for (i = 0; i < PBAR_DATA_SIZE; i++)
         {   pbars[p].data[i] = 0;}
     }
@@ -0,0 +1,260 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+#include <config.h>
+
+#include "Replay.hpp"
+
+#include "Game.hpp"
+#include "MainLincity.hpp"
+#include "PBar.hpp"
+#include "Config.hpp"
+#include "lincity/engglobs.h"
+#include "lincity/simulate.h"
+#include "lincity/MetricsSink.h"
+#include "lincity/Profiler.h"
+#include "lincity/WorldHash.h"
+
+#include <iostream>
+#include <iomanip>
+#include <physfs.h>
+#include <stdlib.h>
+#include <SDL.h>
+
+//load the savegame of the journal, the first time also create the GUI
+static bool restart(Journal& replay, std::unique_ptr<Game>& game)
+{
+    if(!game.get())
+    {
+        //the simulation reports to the user interface, so there has to be one
+        game.reset(new Game());
+        while(!LCPBarPage1 || !LCPBarPage2)
+        {   SDL_Delay(100);}
+    }
+    if(!loadCityNG(replay.getSavegame()))
+    {
+        std::cerr << "replay# could not load " << replay.getSavegame() << "\n";
+        return false;
+    }
+    srand(replay.getSeed());
+    //cars spawn depending on the speed, which the journal changes as recorded
+    if(replay.hasSettings())
+    {   setLincitySpeed(replay.getSettings().speed);}
+    return true;
+}
+
+static bool loadJournal(const std::string& filename, Journal& replay)
+{
+    if(!replay.load(filename))
+    {   return false;}
+    //the engine settings of the recording, --compare switches one of them later
+    if(replay.hasSettings())
+    {
+        const Journal::Settings& settings = replay.getSettings();
+        getConfig()->carsEnabled = settings.carsEnabled;
+        getConfig()->powerGrid = settings.powerGrid;
+        getConfig()->tradeGraph = settings.tradeGraph;
+        getConfig()->sleeping = settings.sleeping;
+        getConfig()->denseTrade = settings.denseTrade;
+    }
+    //the savegame is looked up next to the journal first
+    std::string directory = ".";
+    size_t slash = filename.find_last_of("/\\");
+    if(slash != std::string::npos)
+    {   directory = filename.substr(0, slash);}
+    PHYSFS_addToSearchPath(directory.c_str(), 0);
+    return true;
+}
+
+/*
+ * Simulate until lastDay, operations of a day are applied after the step
+ * that reached it and before the next one, so those of lastDay are not.
+ * Stops early and returns false once hashes are given and the hash of a
+ * day differs from them, otherwise the hash of every day is added to them.
+ */
+static bool simulate(Journal& replay, int lastDay, WorldHash* hash,
+    std::vector<WorldHash::Hash>* hashes, int firstDay)
+{
+    const std::vector<Journal::Entry>& entries = replay.getEntries();
+    size_t next = 0;
+    while(total_time < lastDay)
+    {
+        while(next < entries.size() && entries[next].day <= total_time)
+        {   Journal::apply(entries[next++]);}
+        do_time_step();
+        if(!hash)
+        {   continue;}
+        hash->update();
+        size_t day = total_time - firstDay - 1;
+        if(day < hashes->size())
+        {
+            if((*hashes)[day] != hash->total)
+            {   return false;}
+        }
+        else
+        {   hashes->push_back(hash->total);}
+    }
+    return true;
+}
+
+static void writeHash(std::ostream& os, WorldHash::Hash hash)
+{
+    os << "\"" << std::hex << std::setw(16) << std::setfill('0') << hash
+        << std::dec << std::setfill(' ') << "\"";
+}
+
+int replayJournal(const std::string& filename)
+{
+    Journal replay;
+    std::unique_ptr<Game> game;
+    if(!loadJournal(filename, replay) || !restart(replay, game))
+    {   return 1;}
+
+    int firstDay = total_time;
+    long long start = Profiler::now();
+    simulate(replay, replay.getEndDay(), 0, 0, firstDay);
+    long long wallTime = Profiler::now() - start;
+
+    WorldHash hash;
+    hash.update();
+    int days = total_time - firstDay;
+    std::cout << "{\"days\":" << days
+        << ",\"operations\":" << replay.getEntries().size()
+        << ",\"wall_us\":" << wallTime
+        << ",\"us_per_day\":" << (days ? wallTime / days : 0)
+        << ",\"total_money\":" << total_money
+        << ",\"hash\":";
+    writeHash(std::cout, hash.total);
+    if(getConfig()->groupCosts)
+    {
+        std::cout << ",\"costs\":";
+        groupCosts.writeJSON(std::cout);
+    }
+    //oldest first, including the months the savegame came with
+    std::cout << ",\n\"history\":{\"daily\":";
+    statsHistory.writeJSON(std::cout, StatsHistory::DAILY);
+    std::cout << ",\n\"monthly\":";
+    statsHistory.writeJSON(std::cout, StatsHistory::MONTHLY);
+    std::cout << ",\n\"yearly\":";
+    statsHistory.writeJSON(std::cout, StatsHistory::YEARLY);
+    std::cout << "}}" << std::endl;
+    return 0;
+}
+
+//the settings that change how the engine computes the city
+static bool* engineSetting(const std::string& name)
+{
+    if(name == "powerGrid")
+    {   return &getConfig()->powerGrid;}
+    if(name == "carsEnabled")
+    {   return &getConfig()->carsEnabled;}
+    if(name == "tradeGraph")
+    {   return &getConfig()->tradeGraph;}
+    if(name == "sleeping")
+    {   return &getConfig()->sleeping;}
+    if(name == "denseTrade")
+    {   return &getConfig()->denseTrade;}
+    return 0;
+}
+
+//the metrics of the runs go to one file, each row names its run
+static void startRun(const std::string& setting, bool value, const char* pass)
+{
+    if(metricsSink)
+    {   metricsSink->startRun(setting + (value ? "=true " : "=false ") + pass);}
+}
+
+//hashes of the day the two runs diverged on, one run after the other
+static bool hashDay(Journal& replay, std::unique_ptr<Game>& game, int day, WorldHash& hash)
+{
+    if(!restart(replay, game))
+    {   return false;}
+    simulate(replay, day, 0, 0, 0);
+    hash.detailed = true;
+    hash.update();
+    return true;
+}
+
+int compareJournal(const std::string& filename, const std::string& setting)
+{
+    bool* value = engineSetting(setting);
+    if(!value)
+    {
+        std::cerr << "compareJournal# " << setting << " is no engine setting\n";
+        return 1;
+    }
+    Journal replay;
+    std::unique_ptr<Game> game;
+    if(!loadJournal(filename, replay))
+    {   return 1;}
+
+    bool first = *value;
+    std::vector<WorldHash::Hash> hashes;
+    long long wallTime[2];
+    bool same = true;
+    int firstDay = 0;
+    for(int run = 0; run < 2 && same; ++run)
+    {
+        *value = run ? !first : first;
+        startRun(setting, *value, "compare");
+        if(!restart(replay, game))
+        {   return 1;}
+        firstDay = total_time;
+        WorldHash hash;
+        long long start = Profiler::now();
+        same = simulate(replay, replay.getEndDay(), &hash, &hashes, firstDay);
+        wallTime[run] = Profiler::now() - start;
+    }
+    int lastDay = total_time;
+
+    std::cout << "{\"setting\":\"" << setting << "\",\"days\":" << lastDay - firstDay;
+    if(same)
+    {
+        std::cout << ",\"wall_us\":[" << wallTime[0] << "," << wallTime[1] << "]"
+            << ",\"diverged\":false}" << std::endl;
+        *value = first;
+        return 0;
+    }
+
+    //run both again up to that day and compare every part of it
+    WorldHash hash[2];
+    for(int run = 0; run < 2; ++run)
+    {
+        *value = run ? !first : first;
+        startRun(setting, *value, "detail");
+        if(!hashDay(replay, game, lastDay, hash[run]))
+        {   return 1;}
+    }
+    *value = first;
+    std::cout << ",\"diverged\":true,\"day\":" << lastDay;
+    int i = WorldHash::firstDifference(hash[0].globalHashes, hash[1].globalHashes);
+    if(i >= 0)
+    {   std::cout << ",\"global\":\"" << WorldHash::globalName(i) << "\"";}
+    i = WorldHash::firstDifference(hash[0].tileHashes, hash[1].tileHashes);
+    if(i >= 0)
+    {   std::cout << ",\"tile\":[" << i % world.len() << "," << i / world.len() << "]";}
+    i = WorldHash::firstDifference(hash[0].constructionHashes, hash[1].constructionHashes);
+    if(i >= 0)
+    {
+        std::cout << ",\"construction\":[" << i % world.len() << "," << i / world.len() << "]";
+        Construction* cst = world(i)->construction();
+        if(cst)
+        {   std::cout << ",\"group\":\"" << cst->constructionGroup->name << "\"";}
+    }
+    std::cout << "}" << std::endl;
+    return 2;
+}
+
+/** @file lincity-ng/Replay.cpp */
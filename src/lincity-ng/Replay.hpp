@@ -0,0 +1,37 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+#ifndef __REPLAY_HPP__
+#define __REPLAY_HPP__
+
+#include <string>
+
+/**
+ * Replay a journal recorded with F7 without a player and print how long
+ * the simulation took as JSON. The savegame of the journal is looked up
+ * next to it. Returns the exit code for main.
+ */
+int replayJournal(const std::string& filename);
+
+/**
+ * Replay a journal twice, with an engine setting as configured and
+ * flipped, and print the first day, global, tile and construction the two
+ * cities differ in. Returns 0 if they never do.
+ */
+int compareJournal(const std::string& filename, const std::string& setting);
+
+#endif
+
+/** @file lincity-ng/Replay.hpp */
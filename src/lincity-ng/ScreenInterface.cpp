@@ -334,7 +334,11 @@ void print_stats ()
     }
 
     if (total_time % (NUMOF_DAYS_IN_MONTH/5) == NUMOF_DAYS_IN_MONTH / 5 - 1)
-    {   mps_refresh();}
+    {
+        mps_refresh();
+        //the history graph shows the running mean of the month
+        getEconomyGraph()->updateData();
+    }
 
     //check for new tech
     update_avail_modules (1);
@@ -318,6 +318,23 @@ Sound::Sound()
     playMusic();
 }
 
+void
+Sound::pauseThreads()
+{
+    SDL_WaitThread( loaderThread, NULL );
+    loaderThread = 0;
+    //the audio callback is not running while the audio is locked
+    if( audioOpen )
+    {   SDL_LockAudio();}
+}
+
+void
+Sound::resumeThreads()
+{
+    if( audioOpen )
+    {   SDL_UnlockAudio();}
+}
+
 Sound::~Sound()
 {
     //SDL_KillThread( loaderThread );
@@ -361,7 +378,7 @@ Sound::playSound(const std::string& name) {
     }
 
     chunks_t::iterator it = waves.find(name);
-    for (int i = rand() % count; i > 0; i--) {
+    for (int i = random(count); i > 0; i--) {
         it++;
     }
 
@@ -379,6 +396,13 @@ void Sound::playASound(Mix_Chunk *chunk)
     Mix_PlayChannel( 0, chunk, 0 );
 }
 
+int Sound::random(int n)
+{
+    if( n <= 0 )
+    {   return 0;}
+    return randomGenerator() % n;
+}
+
 
 /*
  * Get ID-String for a given Filename.
@@ -19,6 +19,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #define __SOUND_HPP__
 
 #include <map>
+#include <random>
 #include <string>
 #include <vector>
 #include <SDL_mixer.h>
@@ -49,8 +50,14 @@ public:
     Sound();
     ~Sound();
 
+    /** wait for the sounds to load and hold the audio thread, e.g. around fork() */
+    void pauseThreads();
+    void resumeThreads();
+
     void playSound(const std::string& name);
     void playASound(Mix_Chunk *chunk);
+    /** random number 0..n-1 for choosing sounds, leaves rand() to the simulation */
+    int random(int n);
     void playMusic();
     void changeTrack(MusicTransport command);
     void enableMusic(bool enabled);
@@ -76,6 +83,7 @@ private:
     Mix_Music* currentMusic;
     int totalTracks;
     std::vector<song> playlist;
+    std::minstd_rand randomGenerator;
 };
 
 Sound* getSound();
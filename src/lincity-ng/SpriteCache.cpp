@@ -0,0 +1,223 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+#include <config.h>
+
+#include "SpriteCache.hpp"
+
+#include <physfs.h>
+#include <iostream>
+#include <string.h>
+
+static const char cacheMagic[8] = { 'L', 'C', 'S', 'P', 'R', 'I', 'T', 'E' };
+static const Uint32 cacheVersion = 1;
+// tells if the cache was written on a machine with the same byte order
+static const Uint32 byteOrderMark = 0x01020304;
+
+//surface flags worth restoring, everything else is up to SDL
+static const Uint32 cachedFlags = SDL_SRCCOLORKEY | SDL_SRCALPHA;
+
+SpriteCache::SpriteCache(const std::string& filename)
+    : filename(filename), key(2166136261u)
+{
+}
+
+static void hash(Uint32& key, const void* data, size_t len)
+{
+    const Uint8* p = (const Uint8*) data;
+    for(size_t i = 0; i < len; ++i)
+    {
+        key ^= p[i];
+        key *= 16777619u;
+    }
+}
+
+void SpriteCache::addSource(const std::string& source)
+{
+    PHYSFS_sint64 mtime = PHYSFS_getLastModTime(source.c_str());
+    hash(key, source.c_str(), source.size() + 1);
+    hash(key, &mtime, sizeof(mtime));
+}
+
+static bool readValue(PHYSFS_file* file, void* value, PHYSFS_uint32 size)
+{
+    return PHYSFS_read(file, value, size, 1) == 1;
+}
+
+static bool writeValue(PHYSFS_file* file, const void* value, PHYSFS_uint32 size)
+{
+    return PHYSFS_write(file, value, size, 1) == 1;
+}
+
+static SDL_Surface* readSurface(PHYSFS_file* file, bool& ok)
+{
+    Uint32 w, h, flags, colorkey, ncolors;
+    Uint32 rmask, gmask, bmask, amask;
+    Uint8 bpp, alpha;
+    ok = readValue(file, &w, sizeof(w)) && readValue(file, &h, sizeof(h));
+    if(!ok || w == 0 || h == 0)
+    {   return 0;}
+    ok = readValue(file, &bpp, sizeof(bpp))
+        && readValue(file, &rmask, sizeof(rmask))
+        && readValue(file, &gmask, sizeof(gmask))
+        && readValue(file, &bmask, sizeof(bmask))
+        && readValue(file, &amask, sizeof(amask))
+        && readValue(file, &flags, sizeof(flags))
+        && readValue(file, &colorkey, sizeof(colorkey))
+        && readValue(file, &alpha, sizeof(alpha))
+        && readValue(file, &ncolors, sizeof(ncolors));
+    if(!ok)
+    {   return 0;}
+
+    SDL_Surface* surface = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, bpp,
+            rmask, gmask, bmask, amask);
+    if(!surface)
+    {
+        ok = false;
+        return 0;
+    }
+    if(ncolors)
+    {
+        SDL_Palette* palette = surface->format->palette;
+        if(!palette || ncolors > (Uint32) palette->ncolors
+            || !readValue(file, palette->colors, ncolors * sizeof(SDL_Color)))
+        {
+            ok = false;
+            SDL_FreeSurface(surface);
+            return 0;
+        }
+    }
+    //rows are read one by one, in case SDL chose another pitch
+    Uint32 rowlen = w * surface->format->BytesPerPixel;
+    Uint8* row = (Uint8*) surface->pixels;
+    for(Uint32 y = 0; y < h && ok; ++y, row += surface->pitch)
+    {   ok = readValue(file, row, rowlen);}
+    if(!ok)
+    {
+        SDL_FreeSurface(surface);
+        return 0;
+    }
+    if(flags & SDL_SRCCOLORKEY)
+    {   SDL_SetColorKey(surface, SDL_SRCCOLORKEY, colorkey);}
+    SDL_SetAlpha(surface, flags & SDL_SRCALPHA, alpha);
+    return surface;
+}
+
+static bool writeSurface(PHYSFS_file* file, SDL_Surface* surface)
+{
+    Uint32 w = surface ? surface->w : 0;
+    Uint32 h = surface ? surface->h : 0;
+    if(!writeValue(file, &w, sizeof(w)) || !writeValue(file, &h, sizeof(h)))
+    {   return false;}
+    if(w == 0 || h == 0)
+    {   return true;}
+
+    SDL_PixelFormat* format = surface->format;
+    Uint32 flags = surface->flags & cachedFlags;
+    Uint32 ncolors = format->palette ? format->palette->ncolors : 0;
+    bool ok = writeValue(file, &format->BitsPerPixel, sizeof(format->BitsPerPixel))
+        && writeValue(file, &format->Rmask, sizeof(format->Rmask))
+        && writeValue(file, &format->Gmask, sizeof(format->Gmask))
+        && writeValue(file, &format->Bmask, sizeof(format->Bmask))
+        && writeValue(file, &format->Amask, sizeof(format->Amask))
+        && writeValue(file, &flags, sizeof(flags))
+        && writeValue(file, &format->colorkey, sizeof(format->colorkey))
+        && writeValue(file, &format->alpha, sizeof(format->alpha))
+        && writeValue(file, &ncolors, sizeof(ncolors));
+    if(ok && ncolors)
+    {   ok = writeValue(file, format->palette->colors, ncolors * sizeof(SDL_Color));}
+
+    if(SDL_MUSTLOCK(surface))
+    {   SDL_LockSurface(surface);}
+    Uint32 rowlen = w * format->BytesPerPixel;
+    Uint8* row = (Uint8*) surface->pixels;
+    for(Uint32 y = 0; y < h && ok; ++y, row += surface->pitch)
+    {   ok = writeValue(file, row, rowlen);}
+    if(SDL_MUSTLOCK(surface))
+    {   SDL_UnlockSurface(surface);}
+    return ok;
+}
+
+bool SpriteCache::read(std::vector<SDL_Surface*>& images)
+{
+    if(!PHYSFS_exists(filename.c_str()))
+    {   return false;}
+    PHYSFS_file* file = PHYSFS_openRead(filename.c_str());
+    if(!file)
+    {   return false;}
+
+    char magic[sizeof(cacheMagic)];
+    Uint32 version, bom, cachedKey, count;
+    bool ok = readValue(file, magic, sizeof(magic))
+        && memcmp(magic, cacheMagic, sizeof(magic)) == 0
+        && readValue(file, &version, sizeof(version)) && version == cacheVersion
+        && readValue(file, &bom, sizeof(bom)) && bom == byteOrderMark
+        && readValue(file, &cachedKey, sizeof(cachedKey)) && cachedKey == key
+        && readValue(file, &count, sizeof(count));
+
+    images.clear();
+    if(ok)
+    {   images.reserve(count);}
+    for(Uint32 i = 0; ok && i < count; ++i)
+    {   images.push_back(readSurface(file, ok));}
+    PHYSFS_close(file);
+
+    if(!ok)
+    {
+        for(size_t i = 0; i < images.size(); ++i)
+        {
+            if(images[i])
+            {   SDL_FreeSurface(images[i]);}
+        }
+        images.clear();
+        std::cerr << "SpriteCache::read# " << filename << " is stale.\n";
+    }
+    return ok;
+}
+
+void SpriteCache::write(const std::vector<SDL_Surface*>& images)
+{
+    PHYSFS_file* file = PHYSFS_openWrite(filename.c_str());
+    if(!file)
+    {
+        std::cerr << "SpriteCache::write# Could not open " << filename
+            << ": " << PHYSFS_getLastError() << "\n";
+        return;
+    }
+    //the key is written last, so an interrupted write leaves a stale cache
+    Uint32 noKey = ~key;
+    Uint32 count = images.size();
+    bool ok = writeValue(file, cacheMagic, sizeof(cacheMagic))
+        && writeValue(file, &cacheVersion, sizeof(cacheVersion))
+        && writeValue(file, &byteOrderMark, sizeof(byteOrderMark))
+        && writeValue(file, &noKey, sizeof(noKey))
+        && writeValue(file, &count, sizeof(count));
+    for(size_t i = 0; ok && i < images.size(); ++i)
+    {   ok = writeSurface(file, images[i]);}
+    if(ok)
+    {
+        ok = PHYSFS_seek(file, sizeof(cacheMagic) + 2 * sizeof(Uint32))
+            && writeValue(file, &key, sizeof(key));
+    }
+    if(!ok)
+    {
+        std::cerr << "SpriteCache::write# Could not write " << filename
+            << ": " << PHYSFS_getLastError() << "\n";
+    }
+    PHYSFS_close(file);
+}
+
+
+/** @file lincity-ng/SpriteCache.cpp */
@@ -0,0 +1,54 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+#ifndef __SPRITECACHE_HPP__
+#define __SPRITECACHE_HPP__
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * Keeps decoded sprites in one file of the write directory, so later starts
+ * can skip decoding the PNGs. The cache is keyed by the modification times
+ * of all source files, any change invalidates it.
+ *
+ * Pixels are stored as SDL had them after decoding (format, palette,
+ * colorkey and all), so cached surfaces are identical to decoded ones.
+ */
+class SpriteCache
+{
+public:
+    SpriteCache(const std::string& filename);
+
+    /** add a file the cached images depend on to the key */
+    void addSource(const std::string& filename);
+
+    /**
+     * Read one surface per source image in the order they were cached.
+     * Returns false (and no surfaces) if the cache is missing or stale.
+     */
+    bool read(std::vector<SDL_Surface*>& images);
+    /** replace the cache, 0 entries stand for images that failed to load */
+    void write(const std::vector<SDL_Surface*>& images);
+
+private:
+    std::string filename;
+    Uint32 key; //FNV-1a over names and modification times of the sources
+};
+
+#endif
+
+/** @file lincity-ng/SpriteCache.hpp */
@@ -0,0 +1,231 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+#include <config.h>
+
+#include "TextureResidency.hpp"
+
+#include "GameView.hpp"
+#include "gui/TextureManager.hpp"
+#include "lincity/lintypes.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+TextureResidency::TextureResidency(size_t budget)
+    : loading(false), budget(budget), residentBytes(0), frame(0)
+{
+    mutex = SDL_CreateMutex();
+    decoded = SDL_CreateCond();
+}
+
+TextureResidency::~TextureResidency()
+{
+    std::map<ResourceGroup*, Entry>::iterator it;
+    for(it = entries.begin(); it != entries.end(); ++it)
+    {
+        for(size_t i = 0; i < it->second.images.size(); ++i)
+        {
+            if(it->second.images[i])
+            {   SDL_FreeSurface(it->second.images[i]);}
+        }
+    }
+    SDL_DestroyCond(decoded);
+    SDL_DestroyMutex(mutex);
+}
+
+void TextureResidency::decode(ResourceGroup* group, std::vector<SDL_Surface*>& images)
+{
+    images.resize(group->graphicsInfoVector.size(), 0);
+    for(size_t i = 0; i < images.size(); ++i)
+    {
+        const std::string& file = group->graphicsInfoVector[i].file;
+        if(file.empty())
+        {   continue;}
+        try {
+            images[i] = GameView::readImage(file);
+        } catch(std::exception& err) {
+            std::cerr << "TextureResidency::decode# " << file << ": " << err.what() << "\n";
+        }
+    }
+}
+
+//called from the main thread with the mutex held
+void TextureResidency::upload(ResourceGroup* group, Entry& entry)
+{
+    entry.bytes = 0;
+    for(size_t i = 0; i < entry.images.size(); ++i)
+    {
+        SDL_Surface* image = entry.images[i];
+        if(!image)
+        {   continue;}
+        GraphicsInfo& graphicsInfo = group->graphicsInfoVector[i];
+        if(graphicsInfo.x_default)
+        {   graphicsInfo.x = image->w / 2;}
+        if(graphicsInfo.y_default)
+        {   graphicsInfo.y = image->h;}
+        entry.bytes += image->w * image->h * 4;
+        //takes ownership of the image
+        graphicsInfo.texture = texture_manager->create(image);
+    }
+    entry.images.clear();
+    entry.state = RESIDENT;
+    residentBytes += entry.bytes;
+}
+
+void TextureResidency::unload(ResourceGroup* group, Entry& entry)
+{
+    std::vector<GraphicsInfo>& graphicsInfos = group->graphicsInfoVector;
+    for(size_t i = 0; i < graphicsInfos.size(); ++i)
+    {
+        if(graphicsInfos[i].file.empty())
+        {   continue;}
+        delete graphicsInfos[i].texture;
+        graphicsInfos[i].texture = 0;
+    }
+    residentBytes -= entry.bytes;
+    entry.bytes = 0;
+    entry.state = UNLOADED;
+}
+
+void TextureResidency::beginFrame()
+{
+    ++frame;
+    SDL_LockMutex(mutex);
+    std::map<ResourceGroup*, Entry>::iterator it;
+    for(it = entries.begin(); it != entries.end(); ++it)
+    {
+        if(it->second.state == DECODED)
+        {   upload(it->first, it->second);}
+    }
+    SDL_UnlockMutex(mutex);
+}
+
+void TextureResidency::require(ResourceGroup* group)
+{
+    SDL_LockMutex(mutex);
+    Entry& entry = entries[group];
+    entry.lastUsed = frame;
+    if(entry.state == RESIDENT)
+    {
+        SDL_UnlockMutex(mutex);
+        return;
+    }
+    //nobody is working on it yet, so don't wait for the loader
+    if(entry.state == UNLOADED || entry.state == QUEUED)
+    {
+        entry.state = DECODING;
+        SDL_UnlockMutex(mutex);
+        std::vector<SDL_Surface*> images;
+        decode(group, images);
+        SDL_LockMutex(mutex);
+        entry.images.swap(images);
+        entry.state = DECODED;
+    }
+    while(entry.state == DECODING)
+    {   SDL_CondWait(decoded, mutex);}
+    if(entry.state == DECODED)
+    {   upload(group, entry);}
+    SDL_UnlockMutex(mutex);
+}
+
+void TextureResidency::prefetch(ResourceGroup* group)
+{
+    //prefetching into a full budget would only evict something else
+    if(residentBytes >= budget)
+    {   return;}
+    SDL_LockMutex(mutex);
+    Entry& entry = entries[group];
+    if(entry.state == UNLOADED)
+    {
+        entry.state = QUEUED;
+        queue.push_back(group);
+    }
+    SDL_UnlockMutex(mutex);
+}
+
+static bool olderThan(const std::pair<unsigned int, ResourceGroup*>& a,
+    const std::pair<unsigned int, ResourceGroup*>& b)
+{
+    return a.first < b.first;
+}
+
+void TextureResidency::evict()
+{
+    if(residentBytes <= budget)
+    {   return;}
+    SDL_LockMutex(mutex);
+    std::vector<std::pair<unsigned int, ResourceGroup*> > candidates;
+    std::map<ResourceGroup*, Entry>::iterator it;
+    for(it = entries.begin(); it != entries.end(); ++it)
+    {
+        if(it->second.state == RESIDENT && it->second.lastUsed != frame)
+        {   candidates.push_back(std::make_pair(it->second.lastUsed, it->first));}
+    }
+    std::sort(candidates.begin(), candidates.end(), olderThan);
+    for(size_t i = 0; i < candidates.size() && residentBytes > budget; ++i)
+    {   unload(candidates[i].second, entries[candidates[i].second]);}
+    SDL_UnlockMutex(mutex);
+}
+
+bool TextureResidency::decodeQueued()
+{
+    SDL_LockMutex(mutex);
+    ResourceGroup* group = 0;
+    while(!queue.empty() && !group)
+    {
+        //entries required meanwhile are no longer QUEUED
+        if(entries[queue.front()].state == QUEUED)
+        {   group = queue.front();}
+        queue.pop_front();
+    }
+    if(!group)
+    {
+        SDL_UnlockMutex(mutex);
+        return false;
+    }
+    Entry& entry = entries[group];
+    entry.state = DECODING;
+    loading = true;
+    SDL_UnlockMutex(mutex);
+
+    std::vector<SDL_Surface*> images;
+    decode(group, images);
+
+    SDL_LockMutex(mutex);
+    entry.images.swap(images);
+    entry.state = DECODED;
+    loading = false;
+    SDL_CondBroadcast(decoded);
+    SDL_UnlockMutex(mutex);
+    return true;
+}
+
+void TextureResidency::pause()
+{
+    //the loader needs the mutex to start on the next group
+    SDL_LockMutex(mutex);
+    while(loading)
+    {   SDL_CondWait(decoded, mutex);}
+}
+
+void TextureResidency::resume()
+{
+    SDL_UnlockMutex(mutex);
+}
+
+
+/** @file lincity-ng/TextureResidency.cpp */
@@ -0,0 +1,90 @@
+/*
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+#ifndef __TEXTURERESIDENCY_HPP__
+#define __TEXTURERESIDENCY_HPP__
+
+#include <SDL.h>
+#include <SDL_thread.h>
+#include <deque>
+#include <map>
+#include <vector>
+
+class ResourceGroup;
+
+/**
+ * Keeps the textures of ResourceGroups in memory only while they are used.
+ *
+ * Textures of a group are created when it first shows up on screen and
+ * deleted again, least recently drawn first, once all textures together
+ * exceed the budget. Groups near the viewport can be queued, the loader
+ * thread then decodes their images ahead of time.
+ *
+ * Only groups whose GraphicsInfos have a file set are handled here.
+ */
+class TextureResidency
+{
+public:
+    TextureResidency(size_t budget);
+    ~TextureResidency();
+
+    /** start a new frame and create textures for finished prefetches */
+    void beginFrame();
+    /** make sure group has its textures, called from the main thread */
+    void require(ResourceGroup* group);
+    /** let the loader thread decode group if there is room for it */
+    void prefetch(ResourceGroup* group);
+    /** delete textures of groups not drawn this frame while over budget */
+    void evict();
+
+    /** decode one queued group, returns false if there was none */
+    bool decodeQueued();
+
+    /** wait for the loader to finish its group and hold it, e.g. around fork() */
+    void pause();
+    void resume();
+
+    size_t getResidentBytes() const
+    {   return residentBytes;}
+
+private:
+    enum State { UNLOADED, QUEUED, DECODING, DECODED, RESIDENT };
+    struct Entry
+    {
+        Entry() : state(UNLOADED), bytes(0), lastUsed(0) {}
+        State state;
+        size_t bytes;
+        unsigned int lastUsed; //frame the group was last required in
+        std::vector<SDL_Surface*> images;
+    };
+
+    static void decode(ResourceGroup* group, std::vector<SDL_Surface*>& images);
+    void upload(ResourceGroup* group, Entry& entry);
+    void unload(ResourceGroup* group, Entry& entry);
+
+    std::map<ResourceGroup*, Entry> entries;
+    std::deque<ResourceGroup*> queue;
+    SDL_mutex* mutex;   //guards states, images and queue
+    SDL_cond* decoded;  //signalled when the loader finished a group
+    bool loading;       //the loader thread decodes a group
+
+    size_t budget;
+    size_t residentBytes;
+    unsigned int frame;
+};
+
+#endif
+
+/** @file lincity-ng/TextureResidency.hpp */
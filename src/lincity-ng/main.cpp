@@ -42,6 +42,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "MainLincity.hpp"
 #include "MainMenu.hpp"
 #include "Game.hpp"
+#include "Replay.hpp"
 #include "Sound.hpp"
 #include "Config.hpp"
 #include "PBar.hpp"
@@ -49,6 +50,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 #include "lincity/engglobs.h"
 #include "lincity/lin-city.h"
 #include "lincity/init_game.h"
+#include "lincity/Profiler.h"
 
 
 #ifdef ENABLE_BINRELOC
@@ -58,6 +60,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 Painter* painter = 0;
 tinygettext::DictionaryManager* dictionaryManager = 0;
 bool restart = false;
+std::string replayFile;
+std::string compareSetting;
+std::string metricsFile;
 
 #ifdef __APPLE__
      extern char *getBundleSharePath(char *packageName);
@@ -495,6 +500,14 @@ void parseCommandLine(int argc, char** argv)
             std::cout << "                               -q 9 skips animation steps for speed.\n";
             std::cout << "                               -q 8 is the slowest speed with full animation.\n";
             std::cout << "                               -q 1 is fastest. It may heat your hardware!\n";
+            std::cout << "-r [file]    --replay [file]   replay a journal recorded with F7\n";
+            std::cout << "                               without display and print its timing\n";
+            std::cout << "-c [file] [setting]            replay a journal with an engine setting\n";
+            std::cout << "--compare [file] [setting]     (powerGrid, carsEnabled, tradeGraph, sleeping,\n";
+            std::cout << "                               denseTrade) on and off and report where\n";
+            std::cout << "                               the cities diverge\n";
+            std::cout << "-M [file]    --metrics [file]  write a row of statistics per month to file\n";
+            std::cout << "                               as CSV for names ending in .csv, else NDJSON\n";
             exit(0);
         } else if(argStr == "-g" || argStr == "--gl") {
             getConfig()->useOpenGL = true;
@@ -542,7 +555,38 @@ void parseCommandLine(int argc, char** argv)
                 newSpeed = FAST_TIME_FOR_YEAR;
             }
             getConfig()->quickness = newSpeed;
+        } else if(argStr == "-r" || argStr == "--replay") {
+            currentArgument++;
+            if(currentArgument >= argc) {
+                std::cerr << "Error: --replay needs a parameter.\n";
+                exit(1);
+            }
+            replayFile = argv[currentArgument];
+            compareSetting.clear();
+            getConfig()->useOpenGL = false;
+            getConfig()->soundEnabled = false;
+            getConfig()->musicEnabled = false;
+            SDL_putenv("SDL_VIDEODRIVER=dummy");
+        } else if(argStr == "-c" || argStr == "--compare") {
+            currentArgument += 2;
+            if(currentArgument >= argc) {
+                std::cerr << "Error: --compare needs two parameters.\n";
+                exit(1);
+            }
+            replayFile = argv[currentArgument - 1];
+            compareSetting = argv[currentArgument];
+            getConfig()->useOpenGL = false;
+            getConfig()->soundEnabled = false;
+            getConfig()->musicEnabled = false;
+            SDL_putenv("SDL_VIDEODRIVER=dummy");
 
+        } else if(argStr == "-M" || argStr == "--metrics") {
+            currentArgument++;
+            if(currentArgument >= argc) {
+                std::cerr << "Error: --metrics needs a parameter.\n";
+                exit(1);
+            }
+            metricsFile = argv[currentArgument];
         } else {
             std::cerr << "Unknown command line argument: " << argStr << "\n";
             exit(1);
@@ -601,12 +645,28 @@ int main(int argc, char** argv)
         }
         initVideo(getConfig()->videoX, getConfig()->videoY);
         initLincity();
+        std::unique_ptr<MetricsFileSink> metrics;
+        if(!metricsFile.empty()) {
+            metrics.reset(new MetricsFileSink(metricsFile));
+            if(!metrics->isOpen())
+                throw std::runtime_error("Couldn't open metrics file " + metricsFile);
+            metricsSink = metrics.get();
+        }
         std::unique_ptr<Sound> sound;
         sound.reset(new Sound());
         //set a function to call when music stops
         Mix_HookMusicFinished(musicHalted);
-        mainLoop();
-        getConfig()->save();
+        if(replayFile.empty()) {
+            mainLoop();
+            getConfig()->save();
+        } else {
+            //the replay settings are not meant to stay
+            if(compareSetting.empty())
+                result = replayJournal(replayFile);
+            else
+                result = compareJournal(replayFile, compareSetting);
+        }
+        metricsSink = NULL;
         destroy_game();
 #ifndef DEBUG
     } catch(std::exception& e) {
@@ -627,6 +687,9 @@ int main(int argc, char** argv)
     xmlCleanupParser();
     delete dictionaryManager;
     dictionaryManager = 0;
+#ifdef ENABLE_ZONES
+    Profiler::dump("profile.json");
+#endif
     PHYSFS_deinit();
     if( restart ){
 #ifdef WIN32
@@ -161,7 +161,6 @@ return (a && b)?((a->constructionGroup->group == b->constructionGroup->group)?(a
         (a->constructionGroup->group < b->constructionGroup->group)):false;
 }
 
-//FIXME Only for use in debugging
 void
 ConstructionCount::reset()
 {
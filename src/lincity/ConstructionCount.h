@@ -24,7 +24,7 @@ public:
     int size();     //return the current size constructionVector NOT the number of Constructions
     int count();    //return the current number of constructions
     void size (int new_len); //set the new size of constructionVector
-    void reset(); //FIXME Only for use in debugging
+    void reset(); //forget all constructions, used when the world is wiped
     void sort(); //Sort all contructions
     Construction* operator[](unsigned int i);
     Construction* pos(unsigned int i);
@@ -0,0 +1,96 @@
+/* ---------------------------------------------------------------------- *
+ * ConstructionPool.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include <iostream>
+#include <new>
+#include "ConstructionPool.h"
+
+//slots keep the alignment operator new would give
+static const size_t POOL_ALIGN = 16;
+
+ConstructionPool::ConstructionPool(size_t objectSize)
+{
+    this->objectSize = objectSize;
+    slotSize = (objectSize + POOL_ALIGN - 1) / POOL_ALIGN * POOL_ALIGN;
+    live = 0;
+    freeList = NULL;
+    registry().push_back(this);
+}
+
+std::vector<ConstructionPool *> &
+ConstructionPool::registry()
+{
+    //pools are never destroyed, constructions may outlive static destruction
+    static std::vector<ConstructionPool *> *pools = new std::vector<ConstructionPool *>;
+    return *pools;
+}
+
+void *
+ConstructionPool::allocate(size_t size)
+{
+    //derived classes of different size are not pooled
+    if (size != objectSize)
+    {   return ::operator new(size);}
+    if (!freeList)
+    {
+        char *block = static_cast<char *>(::operator new(slotSize * BLOCK_LEN));
+        blocks.push_back(block);
+        //thread the new slots so the first one is handed out first
+        for (int i = BLOCK_LEN - 1; i >= 0; --i)
+        {
+            *reinterpret_cast<void **>(block + i * slotSize) = freeList;
+            freeList = block + i * slotSize;
+        }
+    }
+    void *slot = freeList;
+    freeList = *static_cast<void **>(slot);
+    ++live;
+    return slot;
+}
+
+void
+ConstructionPool::release(void *ptr, size_t size)
+{
+    if (size != objectSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    *static_cast<void **>(ptr) = freeList;
+    freeList = ptr;
+    --live;
+}
+
+void
+ConstructionPool::reset()
+{
+    if (live)
+    {
+        std::cout << "ConstructionPool::reset# " << live << " objects still alive" << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {   ::operator delete(blocks[i]);}
+    blocks.clear();
+    freeList = NULL;
+}
+
+size_t
+ConstructionPool::count()
+{
+    return live;
+}
+
+void
+ConstructionPool::resetAll()
+{
+    std::vector<ConstructionPool *> &pools = registry();
+    for (size_t i = 0; i < pools.size(); ++i)
+    {   pools[i]->reset();}
+}
+
+/** @file lincity/ConstructionPool.cpp */
+
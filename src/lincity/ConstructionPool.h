@@ -0,0 +1,77 @@
+/* ---------------------------------------------------------------------- *
+ * ConstructionPool.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __ConstructionPool_h__
+#define __ConstructionPool_h__
+
+#include <cstddef>
+#include <vector>
+
+//Memory for objects of one size, like the constructions of one class.
+//Objects are carved from blocks of BLOCK_LEN slots, so objects of the same
+//kind lie next to each other, and freed slots are reused before a new block
+//is started.
+class ConstructionPool
+{
+public:
+    ConstructionPool(size_t objectSize);
+    void *allocate(size_t size);
+    void release(void *ptr, size_t size);
+    void reset();   //frees all blocks once every construction is gone
+    size_t count(); //number of live constructions
+    static void resetAll(); //reset the pools of all classes
+protected:
+    enum { BLOCK_LEN = 256 };
+    size_t slotSize;
+    size_t objectSize;
+    size_t live;
+    void *freeList;
+    std::vector<char *> blocks;
+    static std::vector<ConstructionPool *> &registry();
+};
+
+//Allocator handing out single elements from a ConstructionPool, for
+//containers that allocate one node at a time like std::list
+template <typename T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+    template <typename U>
+    struct rebind { typedef PoolAllocator<U> other; };
+    PoolAllocator() {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+    T *allocate(size_t n)
+    {
+        if (n == 1)
+        {   return static_cast<T *>(pool().allocate(sizeof(T)));}
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    void deallocate(T *ptr, size_t n)
+    {
+        if (n == 1)
+        {   pool().release(ptr, sizeof(T));}
+        else
+        {   ::operator delete(ptr);}
+    }
+    static ConstructionPool &pool()
+    {
+        static ConstructionPool *pool = new ConstructionPool(sizeof(T));
+        return *pool;
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{   return true;}
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T> &, const PoolAllocator<U> &)
+{   return false;}
+
+#endif /* __ConstructionPool_h__ */
+
+/** @file lincity/ConstructionPool.h */
+
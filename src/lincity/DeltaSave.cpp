@@ -0,0 +1,399 @@
+/* ---------------------------------------------------------------------- *
+ * DeltaSave.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "DeltaSave.h"
+#include "engglobs.h"
+#include "loadsave.h"
+#include "xmlloadsave.h"
+#include "Profiler.h"
+
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+#define ORDER_UNCHANGED 0xFFFFFFFFU
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+//Entry: day, full, lines of the prefix, changed prefix lines (index, line),
+//between, suffix, changed tiles (index, record),
+//changed constructions (index, record), removed constructions (index) and
+//the order of the constructions or ORDER_UNCHANGED. In the journal every
+//entry is preceded by its length.
+
+static void putInt(std::string &out, unsigned int value)
+{   out.append((const char *)&value, sizeof(value));}
+
+static void putString(std::string &out, const std::string &value)
+{
+    putInt(out, value.size());
+    out.append(value);
+}
+
+static void putRecord(std::string &out, const std::string &in, size_t begin, size_t len)
+{
+    putInt(out, len);
+    out.append(in, begin, len);
+}
+
+//FNV-1a of a record of in
+static unsigned long long hashRecord(const std::string &in, size_t begin, size_t len)
+{
+    unsigned long long hash = FNV_OFFSET;
+    for (size_t i = begin; i < begin + len; ++i)
+    {
+        hash ^= (unsigned char)in[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool getInt(const std::string &in, size_t &pos, unsigned int &value)
+{
+    if (in.size() - pos < sizeof(value))
+    {   return false;}
+    memcpy(&value, in.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+static bool getString(const std::string &in, size_t &pos, std::string &value)
+{
+    unsigned int len;
+    if (!getInt(in, pos, len) || in.size() - pos < len)
+    {   return false;}
+    value.assign(in, pos, len);
+    pos += len;
+    return true;
+}
+
+void DeltaSave::Records::assemble(std::string &savegame)
+{
+    savegame.clear();
+    for (size_t i = 0; i < prefix.size(); ++i)
+    {   savegame += prefix[i];}
+    for (size_t i = 0; i < tiles.size(); ++i)
+    {   savegame += tiles[i];}
+    savegame += between;
+    for (size_t i = 0; i < order.size(); ++i)
+    {   savegame += constructions[order[i]];}
+    savegame += suffix;
+}
+
+DeltaSave::DeltaSave()
+{
+    interval = 0;
+    compactAfter = 0;
+    lastBytes = 0;
+    diffs = 0;
+    entries = 0;
+    lastDay = -1;
+    since = 0;
+}
+
+void DeltaSave::update()
+{
+    if (interval <= 0 || filename.empty())
+    {   return;}
+    if (lastDay >= 0 && total_time < lastDay + interval)
+    {   return;}
+    save();
+}
+
+bool DeltaSave::save()
+{
+    PROFILE_ZONE("DeltaSave::save");
+    lastDay = total_time;
+    bool full = entries == 0 || entries >= compactAfter
+        || tileHashes.size() != (size_t)(world.len() * world.len());
+    int changedSince = full ? 0 : since;
+    since = world.nextGeneration();
+    //records are only separable in binary savegames with every tile
+    bool old_binary_mode = binary_mode;
+    bool old_seed_compression = seed_compression;
+    binary_mode = true;
+    seed_compression = false;
+    std::string savegame;
+    SaveLayout layout;
+    xml_loadsave.saveXMLbuffer(savegame, &layout, changedSince);
+    binary_mode = old_binary_mode;
+    seed_compression = old_seed_compression;
+
+    std::string entry;
+    diff(savegame, layout, full, entry);
+
+    //a full entry replaces the journal only once it is complete
+    std::string path = full ? filename + ".tmp" : filename;
+    gzFile fp = gzopen(path.c_str(), full ? "wb1" : "ab1");
+    if (!fp)
+    {
+        std::cerr << "DeltaSave::save# could not write " << path << std::endl;
+        reset();
+        return false;
+    }
+    unsigned int len = entry.size();
+    bool written = gzwrite(fp, &len, sizeof(len)) == sizeof(len)
+        && gzwrite(fp, entry.data(), len) == (int)len;
+    written = gzclose(fp) == Z_OK && written;
+    if (written && full)
+    {
+#if defined (WIN32)
+        remove(filename.c_str());   //rename does not replace files there
+#endif
+        written = rename(path.c_str(), filename.c_str()) == 0;
+    }
+    if (!written)
+    {
+        std::cerr << "DeltaSave::save# could not write " << filename << std::endl;
+        if (full)
+        {   remove(path.c_str());}
+        reset();
+        return false;
+    }
+    entries = full ? 1 : entries + 1;
+    lastBytes = len;
+    return true;
+}
+
+void DeltaSave::reset()
+{
+    entries = 0;
+    lastDay = -1;
+    since = 0;
+    prefixHashes.clear();
+    tileHashes.clear();
+    constructionHashes.clear();
+    order.clear();
+}
+
+void DeltaSave::diff(const std::string &savegame, const SaveLayout &layout, bool full, std::string &entry)
+{
+    size_t tilesEnd = layout.tiles.empty() ? layout.tilesBegin : layout.tiles.back().end;
+    size_t constructionsEnd = layout.constructions.empty() ?
+        layout.constructionsBegin : layout.constructions.back().end;
+    if (full)
+    {
+        prefixHashes.clear();
+        tileHashes.assign(world.len() * world.len(), 0);
+        constructionHashes.clear();
+        order.clear();
+    }
+    ++diffs;
+    entry.clear();
+    putInt(entry, total_time);
+    putInt(entry, full);
+
+    //the globals change by a few lines a day, the history most of all
+    std::string changed;
+    unsigned int count = 0;
+    unsigned int lines = 0;
+    size_t begin = 0;
+    while (begin < layout.tilesBegin)
+    {
+        size_t next = savegame.find('\n', begin);
+        next = (next == std::string::npos || next >= layout.tilesBegin) ? layout.tilesBegin : next + 1;
+        Hash hash = hashRecord(savegame, begin, next - begin);
+        if (lines == prefixHashes.size())
+        {   prefixHashes.push_back(0);}
+        if (full || prefixHashes[lines] != hash)
+        {
+            prefixHashes[lines] = hash;
+            putInt(changed, lines);
+            putRecord(changed, savegame, begin, next - begin);
+            ++count;
+        }
+        ++lines;
+        begin = next;
+    }
+    prefixHashes.resize(lines);
+    putInt(entry, lines);
+    putInt(entry, count);
+    entry += changed;
+    putRecord(entry, savegame, tilesEnd, layout.constructionsBegin - tilesEnd);
+    putRecord(entry, savegame, constructionsEnd, savegame.size() - constructionsEnd);
+
+    //only the tiles stamped since the last entry are in the savegame
+    changed.clear();
+    count = 0;
+    begin = layout.tilesBegin;
+    for (size_t i = 0; i < layout.tiles.size(); ++i)
+    {
+        const SaveRecord &record = layout.tiles[i];
+        size_t len = record.end - begin;
+        Hash hash = hashRecord(savegame, begin, len);
+        if (full || tileHashes[record.index] != hash)
+        {
+            tileHashes[record.index] = hash;
+            putInt(changed, record.index);
+            putRecord(changed, savegame, begin, len);
+            ++count;
+        }
+        begin = record.end;
+    }
+    putInt(entry, count);
+    entry += changed;
+
+    changed.clear();
+    count = 0;
+    begin = layout.constructionsBegin;
+    std::vector<int> newOrder;
+    newOrder.reserve(layout.constructions.size());
+    for (size_t i = 0; i < layout.constructions.size(); ++i)
+    {
+        const SaveRecord &record = layout.constructions[i];
+        size_t len = record.end - begin;
+        Hash hash = hashRecord(savegame, begin, len);
+        std::map<int, Saved>::iterator it = constructionHashes.find(record.index);
+        if (it == constructionHashes.end() || it->second.hash != hash)
+        {
+            putInt(changed, record.index);
+            putRecord(changed, savegame, begin, len);
+            ++count;
+        }
+        Saved &saved = constructionHashes[record.index];
+        saved.hash = hash;
+        saved.diff = diffs;
+        newOrder.push_back(record.index);
+        begin = record.end;
+    }
+    putInt(entry, count);
+    entry += changed;
+
+    //whatever was not saved this time is gone
+    changed.clear();
+    count = 0;
+    std::map<int, Saved>::iterator it = constructionHashes.begin();
+    while (it != constructionHashes.end())
+    {
+        if (it->second.diff == diffs)
+        {
+            ++it;
+            continue;
+        }
+        putInt(changed, it->first);
+        ++count;
+        constructionHashes.erase(it++);
+    }
+    putInt(entry, count);
+    entry += changed;
+
+    if (newOrder == order)
+    {   putInt(entry, ORDER_UNCHANGED);}
+    else
+    {
+        putInt(entry, newOrder.size());
+        for (size_t i = 0; i < newOrder.size(); ++i)
+        {   putInt(entry, newOrder[i]);}
+        order.swap(newOrder);
+    }
+}
+
+bool DeltaSave::apply(Records &records, const std::string &entry)
+{
+    size_t pos = 0;
+    unsigned int day, full, count, index;
+    if (!getInt(entry, pos, day) || !getInt(entry, pos, full))
+    {   return false;}
+    if (full)
+    {   records = Records();}
+    if (!getInt(entry, pos, count))
+    {   return false;}
+    records.prefix.resize(count);
+    if (!getInt(entry, pos, count))
+    {   return false;}
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (!getInt(entry, pos, index) || index >= records.prefix.size()
+            || !getString(entry, pos, records.prefix[index]))
+        {   return false;}
+    }
+    if (!getString(entry, pos, records.between) || !getString(entry, pos, records.suffix))
+    {   return false;}
+
+    if (!getInt(entry, pos, count))
+    {   return false;}
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (!getInt(entry, pos, index))
+        {   return false;}
+        if (index >= records.tiles.size())
+        {   records.tiles.resize(index + 1);}
+        if (!getString(entry, pos, records.tiles[index]))
+        {   return false;}
+    }
+
+    if (!getInt(entry, pos, count))
+    {   return false;}
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (!getInt(entry, pos, index) || !getString(entry, pos, records.constructions[index]))
+        {   return false;}
+    }
+
+    if (!getInt(entry, pos, count))
+    {   return false;}
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        if (!getInt(entry, pos, index))
+        {   return false;}
+        records.constructions.erase(index);
+    }
+
+    if (!getInt(entry, pos, count))
+    {   return false;}
+    if (count != ORDER_UNCHANGED)
+    {
+        records.order.resize(count);
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            if (!getInt(entry, pos, index))
+            {   return false;}
+            records.order[i] = index;
+        }
+    }
+    return pos == entry.size();
+}
+
+bool DeltaSave::restore(const std::string &filename)
+{
+    PROFILE_ZONE("DeltaSave::restore");
+    gzFile fp = gzopen(filename.c_str(), "rb");
+    if (!fp)
+    {
+        std::cerr << "DeltaSave::restore# could not open " << filename << std::endl;
+        return false;
+    }
+    Records records;
+    std::string entry;
+    int applied = 0;
+    unsigned int len;
+    //a torn last entry from a crash is skipped, the ones before still count
+    while (gzread(fp, &len, sizeof(len)) == sizeof(len))
+    {
+        entry.resize(len);
+        if (len && gzread(fp, &entry[0], len) != (int)len)
+        {   break;}
+        if (!apply(records, entry))
+        {
+            std::cerr << "DeltaSave::restore# broken entry in " << filename << std::endl;
+            gzclose(fp);
+            return false;
+        }
+        ++applied;
+    }
+    gzclose(fp);
+    if (!applied)
+    {
+        std::cerr << "DeltaSave::restore# no entries in " << filename << std::endl;
+        return false;
+    }
+    std::string savegame;
+    records.assemble(savegame);
+    return load_city_buffer(savegame) == 0;
+}
+
+/** @file lincity/DeltaSave.cpp */
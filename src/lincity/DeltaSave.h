@@ -0,0 +1,77 @@
+/* ---------------------------------------------------------------------- *
+ * DeltaSave.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __DeltaSave_h__
+#define __DeltaSave_h__
+
+#include <map>
+#include <string>
+#include <vector>
+
+struct SaveLayout;
+
+//Autosaves into an append-only journal of the binary savegame.
+//The first entry holds every record of the savegame, every later entry
+//only the lines of the globals and the tiles and constructions whose
+//records changed since the entry before, plus the constructions that are gone. After
+//compactAfter entries the journal is rewritten as a single full entry.
+//Each entry is a gzip member of its own, appending never rewrites the file.
+//A full entry goes to a temporary file that then replaces the journal, so
+//a crash never leaves less than the last journal behind.
+//Only the tiles World stamped since the entry before are saved again, and
+//only hashes of the records are kept to tell what changed, so an entry
+//costs the globals, the constructions and the changed tiles.
+//Restoring replays the entries into one savegame in memory and loads it.
+class DeltaSave
+{
+public:
+    DeltaSave();
+
+    int interval;           //days between autosaves, 0 for none
+    int compactAfter;       //entries before the journal is rewritten
+    std::string filename;   //path of the journal
+
+    void update();          //autosaves once interval days have passed
+    bool save();
+    void reset();           //the next save starts a new journal
+    size_t lastBytes;       //uncompressed bytes of the last entry
+
+    static bool restore(const std::string &filename);
+
+private:
+    typedef unsigned long long Hash;
+    //the savegame rebuilt from the entries when restoring
+    struct Records
+    {
+        std::vector<std::string> prefix;    //header and globals, by line
+        std::string between;    //end of the tiles, start of the constructions
+        std::string suffix;
+        std::vector<std::string> tiles;             //by world index
+        std::map<int, std::string> constructions;   //by world index
+        std::vector<int> order;                     //of the constructions
+        void assemble(std::string &savegame);
+    };
+    //hashes of the records as of the last entry, to tell what changed
+    struct Saved
+    {
+        Hash hash;
+        int diff;       //the last diff that saved it
+    };
+    std::vector<Hash> prefixHashes;     //header and globals, by line
+    std::vector<Hash> tileHashes;       //by world index
+    std::map<int, Saved> constructionHashes; //by world index
+    std::vector<int> order;             //of the constructions
+    int diffs;              //counted, tells the constructions saved last from those gone
+    int entries;
+    int lastDay;
+    int since;              //generation of World at the last entry
+
+    void diff(const std::string &savegame, const SaveLayout &layout, bool full, std::string &entry);
+    static bool apply(Records &records, const std::string &entry);
+};
+
+#endif /* __DeltaSave_h__ */
+
+/** @file lincity/DeltaSave.h */
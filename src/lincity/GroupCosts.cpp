@@ -0,0 +1,83 @@
+/* ---------------------------------------------------------------------- *
+ * GroupCosts.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "GroupCosts.h"
+#include "lintypes.h"
+#include "engglobs.h"
+
+#include <algorithm>
+
+GroupCosts::GroupCosts()
+{
+    enabled = false;
+    days = 0;
+}
+
+void GroupCosts::reset()
+{
+    days = 0;
+    tradeTime.clear();
+    updateTime.clear();
+}
+
+static bool moreTime(const GroupCost &a, const GroupCost &b)
+{
+    return a.tradeTime + a.updateTime > b.tradeTime + b.updateTime;
+}
+
+static bool moreMemory(const GroupCost &a, const GroupCost &b)
+{
+    return a.memory > b.memory;
+}
+
+void GroupCosts::collect(std::vector<GroupCost> &costs, Order order)
+{
+    std::map<unsigned short, GroupCost> byGroup;
+    for (int i = 0; i < constructionCount.size(); i++)
+    {
+        Construction *cst = constructionCount[i];
+        if (!cst)
+        {   continue;}
+        unsigned short group = cst->constructionGroup->group;
+        GroupCost &cost = byGroup[group];
+        if (!cost.count)
+        {
+            cost.constructionGroup = cst->constructionGroup;
+            cost.tradeTime = group < tradeTime.size() ? tradeTime[group] : 0;
+            cost.updateTime = group < updateTime.size() ? updateTime[group] : 0;
+            cost.memory = 0;
+        }
+        ++cost.count;
+        cost.memory += cst->memoryUsage();
+    }
+    costs.clear();
+    std::map<unsigned short, GroupCost>::iterator it;
+    for (it = byGroup.begin(); it != byGroup.end(); ++it)
+    {   costs.push_back(it->second);}
+    std::stable_sort(costs.begin(), costs.end(), order == BY_TIME ? moreTime : moreMemory);
+}
+
+void GroupCosts::writeJSON(std::ostream &os)
+{
+    std::vector<GroupCost> costs;
+    collect(costs, BY_TIME);
+    os << "{\"days\":" << days << ",\"groups\":[";
+    for (size_t i = 0; i < costs.size(); ++i)
+    {
+        //group names are plain ascii
+        os << (i ? ",\n" : "\n")
+           << "{\"group\":" << costs[i].constructionGroup->group
+           << ",\"name\":\"" << costs[i].constructionGroup->name << "\""
+           << ",\"count\":" << costs[i].count
+           << ",\"trade_us\":" << costs[i].tradeTime
+           << ",\"update_us\":" << costs[i].updateTime
+           << ",\"memory\":" << costs[i].memory << "}";
+    }
+    os << "\n]}\n";
+}
+
+/** @file lincity/GroupCosts.cpp */
+
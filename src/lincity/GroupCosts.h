@@ -0,0 +1,57 @@
+/* ---------------------------------------------------------------------- *
+ * GroupCosts.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __GroupCosts_h__
+#define __GroupCosts_h__
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+class ConstructionGroup;
+
+struct GroupCost
+{
+    ConstructionGroup *constructionGroup;
+    int count;              //constructions of the group
+    long long tradeTime;    //microseconds in trade()
+    long long updateTime;   //microseconds in update() and checkChanges()
+    size_t memory;          //bytes of all constructions, estimated
+};
+
+//Optional accounting of simulation time per ConstructionGroup.
+//simulate_mappoints() adds the time of each construction while enabled,
+//memory is counted whenever a report is made.
+class GroupCosts
+{
+public:
+    enum Order { BY_TIME, BY_MEMORY };
+
+    GroupCosts();
+    bool enabled;   //set every day from the config
+    int days;       //days accounted since the last reset
+    void reset();
+    void add(unsigned short group, long long trade, long long update)
+    {
+        if (group >= tradeTime.size())
+        {
+            tradeTime.resize(group + 1, 0);
+            updateTime.resize(group + 1, 0);
+        }
+        tradeTime[group] += trade;
+        updateTime[group] += update;
+    }
+    //one entry per group with constructions, most expensive first
+    void collect(std::vector<GroupCost> &costs, Order order);
+    void writeJSON(std::ostream &os);
+protected:
+    std::vector<long long> tradeTime;   //indexed by ConstructionGroup::group
+    std::vector<long long> updateTime;
+};
+
+#endif /* __GroupCosts_h__ */
+
+/** @file lincity/GroupCosts.h */
+
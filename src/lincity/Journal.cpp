@@ -0,0 +1,232 @@
+/* ---------------------------------------------------------------------- *
+ * Journal.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "Journal.h"
+#include "lintypes.h"
+#include "engglobs.h"
+#include "engine.h"
+#include "UserOperation.h"
+#include "modules/all_modules.h"
+
+#include <physfs.h>
+#include <stdio.h>
+#include <iostream>
+
+#define JOURNAL_VERSION 2
+
+void setLincitySpeed( int speed ); //defined in lincity-ng/MainLincity.cpp
+
+Journal::Journal()
+{
+    seed = 0;
+    settingsKnown = false;
+    endDay = 0;
+}
+
+Journal::~Journal()
+{
+    stopRecording();
+}
+
+bool Journal::startRecording(const std::string &filename, const std::string &savegame, unsigned int seed,
+    const Settings &settings)
+{
+    stopRecording();
+    std::string fullname = PHYSFS_getWriteDir();
+    fullname += PHYSFS_getDirSeparator();
+    fullname += filename;
+    file.open(fullname.c_str());
+    if (!file.is_open())
+    {
+        std::cerr << "Journal::startRecording# could not create " << fullname << std::endl;
+        return false;
+    }
+    this->savegame = savegame;
+    this->seed = seed;
+    this->settings = settings;
+    settingsKnown = true;
+    file << "lincity-journal " << JOURNAL_VERSION << " " << seed << " " << settings.speed
+        << " " << settings.carsEnabled << " " << settings.powerGrid << " " << settings.tradeGraph
+        << " " << settings.sleeping << " " << settings.denseTrade << " " << savegame << "\n";
+    file.flush();
+    return true;
+}
+
+void Journal::stopRecording()
+{
+    if (!file.is_open())
+    {   return;}
+    file << "end " << total_time << "\n";
+    file.close();
+}
+
+void Journal::detach()
+{
+    //every line is flushed, so this writes nothing
+    if (file.is_open())
+    {   file.close();}
+}
+
+void Journal::record(Op op, int x, int y, int arg1, int arg2)
+{
+    if (!file.is_open())
+    {   return;}
+    file << total_time << " " << static_cast<char>(op) << " " << x << " " << y
+        << " " << arg1 << " " << arg2 << "\n";
+    //flushed right away so sessions that crash can be replayed
+    file.flush();
+}
+
+//the trade rules of the instance, only markets and ports have their own
+static std::map<Construction::Commodities, CommodityRule> *instanceRules(Construction *cst)
+{
+    if (Market *market = dynamic_cast<Market *>(cst))
+    {   return &market->commodityRuleCount;}
+    if (Port *port = dynamic_cast<Port *>(cst))
+    {   return &port->commodityRuleCount;}
+    return 0;
+}
+
+void Journal::recordRules(Construction *cst)
+{
+    std::map<Construction::Commodities, CommodityRule> *rules = instanceRules(cst);
+    if (!file.is_open() || !rules)
+    {   return;}
+    int give = 0;
+    int take = 0;
+    std::map<Construction::Commodities, CommodityRule>::iterator rule_it;
+    for (rule_it = rules->begin(); rule_it != rules->end(); ++rule_it)
+    {
+        if (rule_it->second.give)
+        {   give |= 1 << rule_it->first;}
+        if (rule_it->second.take)
+        {   take |= 1 << rule_it->first;}
+    }
+    record(OP_RULES, cst->x, cst->y, give, take);
+}
+
+bool Journal::load(const std::string &filename)
+{
+    entries.clear();
+    endDay = 0;
+    FILE *in = fopen(filename.c_str(), "r");
+    if (!in)
+    {
+        std::cerr << "Journal::load# could not open " << filename << std::endl;
+        return false;
+    }
+    int version;
+    char name[512];
+    int cars, power, graph, sleeping, dense;
+    settingsKnown = false;
+    if (fscanf(in, "lincity-journal %d %u", &version, &seed) != 2)
+    {   version = 0;}
+    if (version == JOURNAL_VERSION && fscanf(in, "%d %d %d %d %d %d", &settings.speed,
+        &cars, &power, &graph, &sleeping, &dense) == 6)
+    {
+        settings.carsEnabled = cars;
+        settings.powerGrid = power;
+        settings.tradeGraph = graph;
+        settings.sleeping = sleeping;
+        settings.denseTrade = dense;
+        settingsKnown = true;
+    }
+    if ((version != 1 && !settingsKnown) || fscanf(in, "%511s", name) != 1)
+    {
+        std::cerr << "Journal::load# " << filename << " is not a journal" << std::endl;
+        fclose(in);
+        return false;
+    }
+    savegame = name;
+    Entry entry;
+    char op;
+    while (fscanf(in, "%d %c %d %d %d %d", &entry.day, &op, &entry.x, &entry.y,
+        &entry.arg1, &entry.arg2) == 6)
+    {
+        entry.op = op;
+        entries.push_back(entry);
+        endDay = entry.day;
+    }
+    //recordings of crashed sessions have no end line
+    int day;
+    if (fscanf(in, " end %d", &day) == 1)
+    {   endDay = day;}
+    fclose(in);
+    return true;
+}
+
+void Journal::apply(const Entry &entry)
+{
+    if (entry.op == OP_SPEED)
+    {
+        setLincitySpeed(entry.arg1);
+        return;
+    }
+    if (!world.is_inside(entry.x, entry.y))
+    {
+        std::cerr << "Journal::apply# " << static_cast<char>(entry.op) << " outside the map" << std::endl;
+        return;
+    }
+    Construction *cst = world(entry.x, entry.y)->reportingConstruction();
+    switch (entry.op)
+    {
+        case OP_BUILD:
+        {
+            ConstructionGroup *group = ConstructionGroup::getConstructionGroup(entry.arg1);
+            if (!group)
+            {
+                std::cerr << "Journal::apply# unknown group " << entry.arg1 << std::endl;
+                break;
+            }
+            //place_item builds whatever the player has selected
+            UserOperation build;
+            build.action = UserOperation::ACTION_BUILD;
+            build.constructionGroup = group;
+            UserOperation *selected = userOperation;
+            userOperation = &build;
+            place_item(entry.x, entry.y);
+            userOperation = selected;
+            break;
+        }
+        case OP_BULLDOZE:
+            bulldoze_item(entry.x, entry.y);
+            break;
+        case OP_FLOOD:
+            flood_tile(entry.x, entry.y, entry.arg1);
+            break;
+        case OP_EVACUATE:
+            toggle_evacuation(entry.x, entry.y);
+            break;
+        case OP_RULES:
+        {
+            std::map<Construction::Commodities, CommodityRule> *rules = instanceRules(cst);
+            if (!rules)
+            {   break;}
+            for (int stuff = 0; stuff < Construction::STUFF_COUNT; ++stuff)
+            {
+                Construction::Commodities commodity = static_cast<Construction::Commodities>(stuff);
+                bool give = entry.arg1 & (1 << stuff);
+                bool take = entry.arg2 & (1 << stuff);
+                if (!give && !take && !rules->count(commodity))
+                {   continue;}
+                (*rules)[commodity].give = give;
+                (*rules)[commodity].take = take;
+            }
+            break;
+        }
+        case OP_COAL_SURVEY:
+            do_coal_survey();
+            break;
+        case OP_LAUNCH_ROCKET:
+            if (RocketPad *rocket = dynamic_cast<RocketPad *>(cst))
+            {   rocket->launch_rocket();}
+            break;
+        default:
+            std::cerr << "Journal::apply# unknown operation " << entry.op << std::endl;
+    }
+}
+
+/** @file lincity/Journal.cpp */
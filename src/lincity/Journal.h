@@ -0,0 +1,100 @@
+/* ---------------------------------------------------------------------- *
+ * Journal.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __Journal_h__
+#define __Journal_h__
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Construction;
+
+//Records every operation of the player together with the day it happened.
+//A recording starts from a saved game, a seed for rand(), the game speed
+//and the engine settings. Loading the save, seeding, restoring speed and
+//settings and applying the operations before the day they were made
+//reproduces the session. Speed changes are operations too, since cars
+//only draw random numbers below the fast speed.
+//File: a header line "lincity-journal <version> <seed> <speed> <carsEnabled>
+//<powerGrid> <tradeGraph> <sleeping> <denseTrade> <savegame>", then
+//one line "<day> <op> <x> <y> <arg1> <arg2>" per operation and a closing
+//"end <day>" with the last simulated day. Version 1 had no speed and
+//settings.
+class Journal
+{
+public:
+    enum Op
+    {
+        OP_BUILD = 'B',         //arg1: ConstructionGroup::group
+        OP_BULLDOZE = 'D',
+        OP_FLOOD = 'F',         //arg1: cost
+        OP_EVACUATE = 'E',
+        OP_RULES = 'R',         //arg1, arg2: give and take mask of a market or port
+        OP_COAL_SURVEY = 'C',
+        OP_LAUNCH_ROCKET = 'L',
+        OP_SPEED = 'S'          //arg1: lincitySpeed
+    };
+    struct Settings
+    {
+        int speed;              //lincitySpeed
+        bool carsEnabled;
+        bool powerGrid;
+        bool tradeGraph;
+        bool sleeping;
+        bool denseTrade;
+    };
+    struct Entry
+    {
+        int day;
+        int op;
+        int x, y;
+        int arg1, arg2;
+    };
+
+    Journal();
+    ~Journal();
+
+    //filename is created in the write directory
+    bool startRecording(const std::string &filename, const std::string &savegame, unsigned int seed,
+        const Settings &settings);
+    void stopRecording();
+    //closes the file without ending it, for a forked process
+    void detach();
+    bool isRecording()
+    {   return file.is_open();}
+    void record(Op op, int x, int y, int arg1 = 0, int arg2 = 0);
+    void recordRules(Construction *cst);
+
+    //reads a recording, filename is a path of the real filesystem
+    bool load(const std::string &filename);
+    const std::string &getSavegame()
+    {   return savegame;}
+    unsigned int getSeed()
+    {   return seed;}
+    //false for recordings without speed and settings
+    bool hasSettings()
+    {   return settingsKnown;}
+    const Settings &getSettings()
+    {   return settings;}
+    int getEndDay()
+    {   return endDay;}
+    const std::vector<Entry> &getEntries()
+    {   return entries;}
+    static void apply(const Entry &entry);
+
+private:
+    std::ofstream file;
+    std::string savegame;
+    unsigned int seed;
+    Settings settings;
+    bool settingsKnown;
+    int endDay;
+    std::vector<Entry> entries;
+};
+
+#endif /* __Journal_h__ */
+
+/** @file lincity/Journal.h */
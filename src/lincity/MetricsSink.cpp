@@ -0,0 +1,120 @@
+/* ---------------------------------------------------------------------- *
+ * MetricsSink.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "MetricsSink.h"
+#include "engglobs.h"
+#include "stats.h"
+#include "lintypes.h"
+#include "Profiler.h"
+
+#include <ctype.h>
+#include <iostream>
+
+#define METRICS_BUFFER_SIZE (1 << 16)
+
+MetricsSink::MetricsSink()
+{
+    lastDay = -1;
+    lastTime = 0;
+}
+
+void MetricsSink::startRun(const std::string &name)
+{
+    run = name;
+    lastDay = -1;
+}
+
+void MetricsSink::reportMonth()
+{
+    MonthMetrics metrics;
+    metrics.run = run;
+    metrics.day = total_time;
+    metrics.population = housed_population + people_pool;
+    metrics.housed = housed_population;
+    metrics.peoplePool = people_pool;
+    metrics.housing = total_housing;
+    metrics.starving = tstarving_population / NUMOF_DAYS_IN_MONTH;
+    metrics.unemployed = tunemployed_population / NUMOF_DAYS_IN_MONTH;
+    metrics.tech = tech_level;
+    metrics.money = total_money;
+    metrics.pollution = total_pollution;
+    for (int stuff = 0; stuff < Construction::STUFF_COUNT; ++stuff)
+    {
+        metrics.census.push_back(tstat_census[(Construction::Commodities)stuff]);
+        metrics.capacity.push_back(tstat_capacities[(Construction::Commodities)stuff]);
+    }
+    long long now = Profiler::now();
+    //a loaded or rewound city starts over
+    metrics.daysPerSecond = (lastDay >= 0 && total_time > lastDay && now > lastTime) ?
+        (total_time - lastDay) * 1e6 / (now - lastTime) : 0;
+    lastDay = total_time;
+    lastTime = now;
+    writeMonth(metrics);
+}
+
+MetricsFileSink::MetricsFileSink(const std::string &filename)
+{
+    csv = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".csv") == 0;
+    header = false;
+    for (int stuff = 0; stuff < Construction::STUFF_COUNT; ++stuff)
+    {
+        std::string name = commodityNames[stuff];
+        for (size_t i = 0; i < name.size(); ++i)
+        {   name[i] = tolower(name[i]);}
+        commodities.push_back(name);
+    }
+    file = fopen(filename.c_str(), "w");
+    if (!file)
+    {
+        std::cerr << "MetricsFileSink# could not write " << filename << std::endl;
+        return;
+    }
+    setvbuf(file, NULL, _IOFBF, METRICS_BUFFER_SIZE);
+}
+
+MetricsFileSink::~MetricsFileSink()
+{
+    if (file)
+    {   fclose(file);}
+}
+
+void MetricsFileSink::writeMonth(const MonthMetrics &m)
+{
+    if (!file)
+    {   return;}
+    if (csv)
+    {
+        if (!header)
+        {
+            fprintf(file, "run,day,population,housed,people_pool,housing,starving,unemployed,tech,money,pollution");
+            for (size_t i = 0; i < commodities.size(); ++i)
+            {   fprintf(file, ",census_%s,capacity_%s", commodities[i].c_str(), commodities[i].c_str());}
+            fprintf(file, ",days_per_second\n");
+            header = true;
+        }
+        fprintf(file, "%s,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d", m.run.c_str(), m.day, m.population, m.housed, m.peoplePool,
+            m.housing, m.starving, m.unemployed, m.tech, m.money, m.pollution);
+        for (size_t i = 0; i < commodities.size(); ++i)
+        {   fprintf(file, ",%d,%d", m.census[i], m.capacity[i]);}
+        fprintf(file, ",%.1f\n", m.daysPerSecond);
+    }
+    else
+    {
+        fprintf(file, "{\"run\":\"%s\",\"day\":%d,\"population\":%d,\"housed\":%d,\"people_pool\":%d,\"housing\":%d,"
+            "\"starving\":%d,\"unemployed\":%d,\"tech\":%d,\"money\":%d,\"pollution\":%d",
+            m.run.c_str(), m.day, m.population, m.housed, m.peoplePool, m.housing,
+            m.starving, m.unemployed, m.tech, m.money, m.pollution);
+        fprintf(file, ",\"census\":{");
+        for (size_t i = 0; i < commodities.size(); ++i)
+        {   fprintf(file, "%s\"%s\":%d", i ? "," : "", commodities[i].c_str(), m.census[i]);}
+        fprintf(file, "},\"capacity\":{");
+        for (size_t i = 0; i < commodities.size(); ++i)
+        {   fprintf(file, "%s\"%s\":%d", i ? "," : "", commodities[i].c_str(), m.capacity[i]);}
+        fprintf(file, "},\"days_per_second\":%.1f}\n", m.daysPerSecond);
+    }
+}
+
+/** @file lincity/MetricsSink.cpp */
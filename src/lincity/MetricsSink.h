@@ -0,0 +1,71 @@
+/* ---------------------------------------------------------------------- *
+ * MetricsSink.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __MetricsSink_h__
+#define __MetricsSink_h__
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+//A month of the city, the numbers behind the pbars and print_stats
+struct MonthMetrics
+{
+    std::string run;            //which run of a replay, empty when playing
+    int day;                    //total_time
+    int population;             //housed and people_pool
+    int housed;
+    int peoplePool;
+    int housing;
+    int starving;               //means of the month
+    int unemployed;
+    int tech;
+    int money;
+    int pollution;
+    std::vector<int> census;    //by commodity
+    std::vector<int> capacity;
+    double daysPerSecond;       //since the month before, 0 for the first
+};
+
+//Receives the metrics at the end of every month, when the census is
+//complete. end_of_month_update reports to metricsSink, NULL for none.
+class MetricsSink
+{
+public:
+    MetricsSink();
+    virtual ~MetricsSink() {}
+    void reportMonth();         //collects the month and writes it
+    void startRun(const std::string &name); //labels the rows from now on
+    virtual void writeMonth(const MonthMetrics &metrics) = 0;
+
+private:
+    std::string run;
+    int lastDay;
+    long long lastTime;
+};
+
+//Streams a row per month into a file through a large stdio buffer.
+//Every row names its run, so the runs of --compare can be told apart.
+//Names ending in .csv get CSV with a header line, all others NDJSON with
+//one object per line. The last rows reach the file when the sink is deleted.
+class MetricsFileSink : public MetricsSink
+{
+public:
+    MetricsFileSink(const std::string &filename);
+    ~MetricsFileSink();
+    bool isOpen()
+    {   return file != NULL;}
+    virtual void writeMonth(const MonthMetrics &metrics);
+
+private:
+    FILE *file;
+    bool csv;
+    bool header;    //written already
+    std::vector<std::string> commodities;   //lower case names for the columns
+};
+
+#endif /* __MetricsSink_h__ */
+
+/** @file lincity/MetricsSink.h */
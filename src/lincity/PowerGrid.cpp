@@ -0,0 +1,189 @@
+/* ---------------------------------------------------------------------- *
+ * PowerGrid.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "PowerGrid.h"
+#include "lintypes.h"
+#include "engglobs.h"
+#include "lin-city.h"
+#include "transport.h"
+#include "modules/power_line.h"
+
+enum Role { ROLE_NONE, ROLE_PRODUCER, ROLE_CONSUMER, ROLE_CABLE };
+
+static const unsigned int MWH_BIT = 1 << Construction::STUFF_MWH;
+
+static Role role(Construction *cst)
+{
+    ConstructionGroup *cstGroup = cst->constructionGroup;
+    cstGroup->cacheRules();
+    bool give = cstGroup->giveMask & MWH_BIT;
+    bool take = cstGroup->takeMask & MWH_BIT;
+    //evacuating constructions only hand out, like in trade()
+    if (cst->flags & FLAG_EVACUATE)
+    {   return ROLE_PRODUCER;}
+    if (give && take)
+    {   return ROLE_CABLE;}
+    if (give)
+    {   return ROLE_PRODUCER;}
+    if (take)
+    {   return ROLE_CONSUMER;}
+    return ROLE_NONE;
+}
+
+//next part of amount split by weight, all parts add up to amount exactly
+static int share(long long weight, long long total, long long amount, long long *acc, long long *done)
+{
+    *acc += weight;
+    long long upto = 0;
+    if (*acc >= total)
+    {   upto = amount;}
+    else if (total > 0)
+    {   upto = (long long)((double)*acc * amount / total);}
+    int part = upto - *done;
+    *done = upto;
+    return part;
+}
+
+PowerGrid::PowerGrid()
+{
+    enabled = false;
+    labeled = 0;
+    valid = false;
+}
+
+size_t
+PowerGrid::componentCount()
+{
+    return componentStart.empty() ? 0 : componentStart.size() - 1;
+}
+
+void
+PowerGrid::label()
+{
+    members.clear();
+    componentStart.clear();
+    size_t n = ::tradeGraph.nodeCount();
+    //component that took a node, consumers may join every component next to them
+    std::vector<int> seen(n, -1);
+    for (size_t i = 0; i < n; ++i)
+    {
+        Construction *root = ::tradeGraph.node(i);
+        root->cacheStuff();
+        if (seen[i] >= 0 || !(root->stuffMask & MWH_BIT) || role(root) == ROLE_CONSUMER)
+        {   continue;}
+        size_t first = members.size();
+        int component = componentStart.size();
+        seen[i] = component;
+        members.push_back(root);
+        //the members found so far are the queue of the search
+        for (size_t next = first; next < members.size(); ++next)
+        {
+            //power does not pass through consumers, they would join separate grids
+            if (role(members[next]) == ROLE_CONSUMER)
+            {   continue;}
+            size_t count;
+            Construction **neibs = ::tradeGraph.neighbors(members[next], &count);
+            for (size_t j = 0; j < count; ++j)
+            {
+                Construction *pear = neibs[j];
+                int idx = pear->tradeIndex;
+                if (idx < 0 || (size_t)idx >= n || ::tradeGraph.node(idx) != pear)
+                {   continue;}
+                pear->cacheStuff();
+                if (!(pear->stuffMask & MWH_BIT))
+                {   continue;}
+                if (role(pear) == ROLE_CONSUMER ? seen[idx] == component : seen[idx] >= 0)
+                {   continue;}
+                seen[idx] = component;
+                members.push_back(pear);
+            }
+        }
+        //nothing to balance without a link
+        if (members.size() - first < 2)
+        {   members.resize(first);}
+        else
+        {   componentStart.push_back(first);}
+    }
+    componentStart.push_back(members.size());
+    labeled = ::tradeGraph.version();
+    valid = true;
+}
+
+void
+PowerGrid::balance()
+{
+    if (!valid || labeled != ::tradeGraph.version())
+    {   label();}
+    for (size_t c = 0; c + 1 < componentStart.size(); ++c)
+    {   balance(componentStart[c], componentStart[c + 1]);}
+}
+
+void
+PowerGrid::balance(size_t first, size_t last)
+{
+    const int stuff = Construction::STUFF_MWH;
+    long long produced = 0, stored = 0, storeCap = 0, room = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        Construction *cst = members[i];
+        int lvl = *cst->stuffLevel[stuff];
+        int cap = cst->constructionGroup->maxload[stuff];
+        switch (role(cst))
+        {
+            case ROLE_PRODUCER: produced += lvl; break;
+            case ROLE_CONSUMER: room += (cap > lvl) ? cap - lvl : 0; break;
+            case ROLE_CABLE: stored += lvl; storeCap += cap; break;
+            default: break;
+        }
+    }
+    //consumers get as much as there is, cables fill up with the rest
+    long long pool = produced + stored;
+    long long delivered = (pool < room) ? pool : room;
+    long long left = pool - delivered;
+    long long kept = (left < storeCap || produced == 0) ? left : storeCap;
+    long long back = left - kept;
+    int traffic = 0;
+    if (storeCap > 0)
+    {
+        long long load = delivered * TRANSPORT_QUANTA / storeCap;
+        traffic = (load < TRANSPORT_QUANTA) ? load : TRANSPORT_QUANTA;
+    }
+
+    long long accProduced = 0, accStored = 0, accRoom = 0;
+    long long doneProduced = 0, doneStored = 0, doneRoom = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        Construction *cst = members[i];
+        int *lvl = cst->stuffLevel[stuff];
+        int cap = cst->constructionGroup->maxload[stuff];
+        int old_lvl = *lvl;
+        switch (role(cst))
+        {
+            case ROLE_PRODUCER:
+                *lvl = share(*lvl, produced, back, &accProduced, &doneProduced);
+                break;
+            case ROLE_CONSUMER:
+                *lvl += share((cap > *lvl) ? cap - *lvl : 0, room, delivered, &accRoom, &doneRoom);
+                break;
+            case ROLE_CABLE:
+                *lvl = share(cap, storeCap, kept, &accStored, &doneStored);
+                if (cst->constructionGroup->group == GROUP_POWER_LINE)
+                {
+                    Powerline *powerline = static_cast<Powerline *>(cst);
+                    powerline->trafficCount[Construction::STUFF_MWH] =
+                        (9 * powerline->trafficCount[Construction::STUFF_MWH] + traffic) / 10;
+                }
+                break;
+            default:
+                break;
+        }
+        if (*lvl != old_lvl)
+        {   cst->lastChange = total_time;}
+    }
+}
+
+/** @file lincity/PowerGrid.cpp */
+
@@ -0,0 +1,39 @@
+/* ---------------------------------------------------------------------- *
+ * PowerGrid.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __PowerGrid_h__
+#define __PowerGrid_h__
+
+#include <cstddef>
+#include <vector>
+
+class Construction;
+
+//Optional replacement for trading STUFF_MWH tile by tile.
+//Producers and cables linked through MWH form components, which are labeled
+//again only after links changed. Consumers belong to every component next to
+//them but do not link components. Once a day balance() hands the MWH of the
+//producers and cables of each component to its consumers at once, cables
+//keep what is left over. trade() then leaves MWH alone.
+class PowerGrid
+{
+public:
+    PowerGrid();
+    bool enabled;       //set every day from the config
+    void balance();     //moves MWH within every component
+    size_t componentCount();
+protected:
+    unsigned int labeled; //::tradeGraph.version() the components belong to
+    bool valid;
+    std::vector<Construction *> members; //grouped by component
+    std::vector<size_t> componentStart;  //members of c are from start[c] up to start[c+1]
+    void label();
+    void balance(size_t first, size_t last);
+};
+
+#endif /* __PowerGrid_h__ */
+
+/** @file lincity/PowerGrid.h */
+
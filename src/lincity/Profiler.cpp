@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------- *
+ * Profiler.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "Profiler.h"
+
+#include <SDL.h>
+#include <SDL_thread.h>
+#include <physfs.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//Written only by its thread. The reader copies events below count and
+//drops those the writer may have overwritten meanwhile.
+struct ZoneBuffer
+{
+    ZoneBuffer() : tid(SDL_ThreadID()), count(0), events(Profiler::BUFFER_LEN) {}
+    Uint32 tid;
+    std::atomic<unsigned long long> count; //events recorded ever
+    std::vector<Profiler::Event> events;
+};
+
+static SDL_mutex *buffersMutex = SDL_CreateMutex(); //SDL needs no init for it
+static std::vector<ZoneBuffer *> buffers; //never freed, threads may be gone by the dump
+static thread_local ZoneBuffer *threadBuffer = 0;
+
+static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+static ZoneBuffer *ownBuffer()
+{
+    if (!threadBuffer)
+    {
+        threadBuffer = new ZoneBuffer();
+        SDL_LockMutex(buffersMutex);
+        buffers.push_back(threadBuffer);
+        SDL_UnlockMutex(buffersMutex);
+    }
+    return threadBuffer;
+}
+
+static void writeString(std::ostream &os, const char *s)
+{
+    os << '"';
+    for (; *s; ++s)
+    {
+        if (*s == '"' || *s == '\\')
+        {   os << '\\';}
+        os << *s;
+    }
+    os << '"';
+}
+
+long long Profiler::phaseTime[PHASE_COUNT];
+
+long long Profiler::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::record(const char *name, long long start, long long duration)
+{
+    ZoneBuffer *buffer = ownBuffer();
+    unsigned long long n = buffer->count.load(std::memory_order_relaxed);
+    Event &event = buffer->events[n % BUFFER_LEN];
+    event.name = name;
+    event.start = start;
+    event.duration = duration;
+    buffer->count.store(n + 1, std::memory_order_release);
+}
+
+void Profiler::writeTrace(std::ostream &os)
+{
+    SDL_LockMutex(buffersMutex);
+    std::vector<ZoneBuffer *> all(buffers);
+    SDL_UnlockMutex(buffersMutex);
+
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    std::vector<Event> events;
+    for (size_t b = 0; b < all.size(); ++b)
+    {
+        ZoneBuffer *buffer = all[b];
+        unsigned long long last = buffer->count.load(std::memory_order_acquire);
+        unsigned long long begin = last > BUFFER_LEN ? last - BUFFER_LEN : 0;
+        events.clear();
+        for (unsigned long long i = begin; i < last; ++i)
+        {   events.push_back(buffer->events[i % BUFFER_LEN]);}
+        //the owner kept recording while we copied, and may be writing
+        //slot now already, which is the slot of begin + BUFFER_LEN
+        unsigned long long now = buffer->count.load(std::memory_order_acquire);
+        size_t skip = now + 1 > begin + BUFFER_LEN ? now + 1 - begin - BUFFER_LEN : 0;
+        for (size_t i = skip; i < events.size(); ++i)
+        {
+            os << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(os, events[i].name);
+            os << ",\"ph\":\"X\",\"ts\":" << events[i].start
+               << ",\"dur\":" << events[i].duration
+               << ",\"pid\":1,\"tid\":" << buffer->tid << "}";
+            first = false;
+        }
+    }
+    os << "\n]}\n";
+}
+
+void Profiler::takePhaseTimes(long long times[PHASE_COUNT])
+{
+    for (int i = 0; i < PHASE_COUNT; ++i)
+    {
+        times[i] = phaseTime[i];
+        phaseTime[i] = 0;
+    }
+}
+
+void Profiler::dump(const char *filename)
+{
+    std::string fullname = PHYSFS_getWriteDir();
+    fullname += PHYSFS_getDirSeparator();
+    fullname += filename;
+    std::ofstream os(fullname.c_str());
+    if (!os)
+    {
+        std::cerr << "Profiler::dump# could not write " << fullname << std::endl;
+        return;
+    }
+    writeTrace(os);
+    std::cout << "Profiler::dump# zones written to " << fullname << std::endl;
+}
+
+/** @file lincity/Profiler.cpp */
+
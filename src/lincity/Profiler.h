@@ -0,0 +1,106 @@
+/* ---------------------------------------------------------------------- *
+ * Profiler.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __Profiler_h__
+#define __Profiler_h__
+
+#include "lcconfig.h"
+#include <ostream>
+
+//Scoped timing zones for finding out where the time goes.
+//Every thread records the zones it left into its own ring buffer, the
+//buffers are written as Chrome trace JSON (chrome://tracing, Perfetto).
+//Zones only cost something when configured with --enable-zones.
+//Phases are always timed, they add up where a day of the main thread went.
+//Trade and update are told apart construction by construction with zones
+//or group costs enabled, otherwise a sample of constructions splits them.
+class Profiler
+{
+public:
+    enum { BUFFER_LEN = 1 << 16 }; //zones kept per thread
+
+    enum Phase
+    {
+        PHASE_TRADE,
+        PHASE_UPDATE,
+        PHASE_VEHICLES,
+        PHASE_ECOLOGY,
+        PHASE_POLLUTION,
+        PHASE_COVER,
+        PHASE_REQUESTS,
+        PHASE_RENDER,
+        PHASE_COUNT
+    };
+
+    struct Event
+    {
+        const char *name;   //string literal, never copied
+        long long start;    //microseconds
+        long long duration;
+    };
+
+    class Zone
+    {
+    public:
+        Zone(const char *name) : name(name), start(Profiler::now()) {}
+        ~Zone()
+        {   Profiler::record(name, start, Profiler::now() - start);}
+    private:
+        Zone(const Zone &);
+        Zone &operator=(const Zone &);
+        const char *name;
+        long long start;
+    };
+
+    //A zone that also adds its duration to a phase, main thread only
+    class PhaseZone
+    {
+    public:
+        PhaseZone(Phase phase, const char *name) :
+            phase(phase), name(name), start(Profiler::now()) {}
+        ~PhaseZone()
+        {
+            long long duration = Profiler::now() - start;
+            Profiler::addPhase(phase, duration);
+#ifdef ENABLE_ZONES
+            Profiler::record(name, start, duration);
+#endif
+        }
+    private:
+        PhaseZone(const PhaseZone &);
+        PhaseZone &operator=(const PhaseZone &);
+        Phase phase;
+        const char *name;
+        long long start;
+    };
+
+    static long long now(); //microseconds since the first call
+    static void record(const char *name, long long start, long long duration);
+    //all buffered zones of all threads, oldest first per thread
+    static void writeTrace(std::ostream &os);
+    //writeTrace into filename of the write directory
+    static void dump(const char *filename);
+
+    static void addPhase(Phase phase, long long duration)
+    {   phaseTime[phase] += duration;}
+    //microseconds spent per phase since the last call
+    static void takePhaseTimes(long long times[PHASE_COUNT]);
+private:
+    static long long phaseTime[PHASE_COUNT];
+};
+
+#define PROFILE_ZONE_CAT2(a, b) a##b
+#define PROFILE_ZONE_CAT(a, b) PROFILE_ZONE_CAT2(a, b)
+#ifdef ENABLE_ZONES
+#define PROFILE_ZONE(name) Profiler::Zone PROFILE_ZONE_CAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
+#define PROFILE_PHASE(phase, name) Profiler::PhaseZone PROFILE_ZONE_CAT(profilePhase, __LINE__)(Profiler::phase, name)
+
+#endif /* __Profiler_h__ */
+
+/** @file lincity/Profiler.h */
+
@@ -0,0 +1,164 @@
+/* ---------------------------------------------------------------------- *
+ * RewindBuffer.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "RewindBuffer.h"
+#include "engglobs.h"
+#include "loadsave.h"
+#include "xmlloadsave.h"
+#include "Profiler.h"
+
+#include <iostream>
+#include <stdio.h>
+#include <zlib.h>
+
+#define GZIP_WINDOW_BITS (15 + 16)  //deflate window and gzip header
+
+static bool deflateSnapshot(const std::string &in, std::string &out)
+{
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    if (deflateInit2(&strm, Z_BEST_SPEED, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {   return false;}
+    out.resize(deflateBound(&strm, in.size()) + 32);
+    strm.next_in = (Bytef *)in.data();
+    strm.avail_in = in.size();
+    strm.next_out = (Bytef *)&out[0];
+    strm.avail_out = out.size();
+    int r = deflate(&strm, Z_FINISH);
+    out.resize(strm.total_out);
+    deflateEnd(&strm);
+    return r == Z_STREAM_END;
+}
+
+static bool inflateSnapshot(const std::string &in, size_t size, std::string &out)
+{
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = (Bytef *)in.data();
+    strm.avail_in = in.size();
+    if (inflateInit2(&strm, GZIP_WINDOW_BITS) != Z_OK)
+    {   return false;}
+    out.resize(size);
+    strm.next_out = (Bytef *)&out[0];
+    strm.avail_out = out.size();
+    int r = inflate(&strm, Z_FINISH);
+    inflateEnd(&strm);
+    return r == Z_STREAM_END && strm.total_out == size;
+}
+
+RewindBuffer::RewindBuffer()
+{
+    interval = 0;
+    capacity = 0;
+    lastDay = -1;
+    restoring = false;
+}
+
+void RewindBuffer::update()
+{
+    if (interval <= 0 || capacity == 0)
+    {   return;}
+    if (lastDay >= 0 && total_time < lastDay + interval)
+    {   return;}
+    take();
+}
+
+bool RewindBuffer::take()
+{
+    PROFILE_ZONE("RewindBuffer::take");
+    lastDay = total_time;
+    //after a restore the newer snapshots belong to another past
+    while (!snapshots.empty() && snapshots.back().day >= total_time)
+    {   snapshots.pop_back();}
+    //every tile, binary: no world generation and no parsing when restored
+    bool old_binary_mode = binary_mode;
+    bool old_seed_compression = seed_compression;
+    binary_mode = true;
+    seed_compression = false;
+    std::string savegame;
+    xml_loadsave.saveXMLbuffer(savegame);
+    binary_mode = old_binary_mode;
+    seed_compression = old_seed_compression;
+
+    Snapshot snapshot;
+    snapshot.day = total_time;
+    snapshot.size = savegame.size();
+    if (!deflateSnapshot(savegame, snapshot.data))
+    {
+        std::cerr << "RewindBuffer::take# deflate failed" << std::endl;
+        return false;
+    }
+    while (snapshots.size() >= capacity)
+    {   snapshots.pop_front();}
+    snapshots.push_back(snapshot);
+
+    if (!recoveryFile.empty())
+    {
+        //the old recovery file is only replaced by a complete one
+        std::string path = recoveryFile + ".tmp";
+        FILE *fp = fopen(path.c_str(), "wb");
+        bool written = fp
+            && fwrite(snapshot.data.data(), 1, snapshot.data.size(), fp) == snapshot.data.size();
+        written = fp && fclose(fp) == 0 && written;
+        if (written)
+        {
+#if defined (WIN32)
+            remove(recoveryFile.c_str());   //rename does not replace files there
+#endif
+            written = rename(path.c_str(), recoveryFile.c_str()) == 0;
+        }
+        if (!written)
+        {
+            std::cerr << "RewindBuffer::take# could not write " << recoveryFile << std::endl;
+            remove(path.c_str());
+        }
+    }
+    return true;
+}
+
+bool RewindBuffer::restore(size_t i)
+{
+    PROFILE_ZONE("RewindBuffer::restore");
+    if (i >= snapshots.size())
+    {   return false;}
+    std::string savegame;
+    if (!inflateSnapshot(snapshots[i].data, snapshots[i].size, savegame))
+    {
+        std::cerr << "RewindBuffer::restore# inflate failed" << std::endl;
+        return false;
+    }
+    //clear_game must leave the snapshots alone
+    restoring = true;
+    int r = load_city_buffer(savegame);
+    restoring = false;
+    if (r != 0)
+    {
+        std::cerr << "RewindBuffer::restore# broken snapshot" << std::endl;
+        return false;
+    }
+    lastDay = snapshots[i].day;
+    return true;
+}
+
+void RewindBuffer::reset()
+{
+    snapshots.clear();
+    lastDay = -1;
+}
+
+size_t RewindBuffer::memory()
+{
+    size_t bytes = 0;
+    for (size_t i = 0; i < snapshots.size(); ++i)
+    {   bytes += snapshots[i].data.size();}
+    return bytes;
+}
+
+/** @file lincity/RewindBuffer.cpp */
@@ -0,0 +1,55 @@
+/* ---------------------------------------------------------------------- *
+ * RewindBuffer.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __RewindBuffer_h__
+#define __RewindBuffer_h__
+
+#include <deque>
+#include <string>
+
+//Keeps the last snapshots of the city in memory to go back in time.
+//A snapshot is a binary savegame of every tile, deflated with the fastest
+//level into a gzip stream. Restoring skips the file, the world generation
+//of seed_compression and the gunzip of a big file, and the stream written
+//to disk as is loads like any other savegame, which makes the newest
+//snapshot a recovery point after a crash.
+class RewindBuffer
+{
+public:
+    struct Snapshot
+    {
+        int day;            //total_time when taken
+        size_t size;        //bytes of the uncompressed savegame
+        std::string data;   //gzip stream
+    };
+
+    RewindBuffer();
+
+    int interval;               //days between snapshots, 0 for none
+    size_t capacity;            //snapshots kept, older ones are dropped
+    std::string recoveryFile;   //newest snapshot is written here too, empty for none
+
+    void update();              //takes a snapshot once interval days have passed
+    bool take();
+    bool restore(size_t i);     //0 is the oldest snapshot
+    void reset();               //forgets all snapshots
+    bool isRestoring()
+    {   return restoring;}
+
+    size_t count()
+    {   return snapshots.size();}
+    const Snapshot &snapshot(size_t i)
+    {   return snapshots[i];}
+    size_t memory();            //bytes of all snapshots
+
+private:
+    std::deque<Snapshot> snapshots;
+    int lastDay;
+    bool restoring;
+};
+
+#endif /* __RewindBuffer_h__ */
+
+/** @file lincity/RewindBuffer.h */
@@ -0,0 +1,133 @@
+/* ---------------------------------------------------------------------- *
+ * StatsHistory.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "StatsHistory.h"
+#include "engglobs.h"
+#include "stats.h"
+#include "lintypes.h"
+
+#include <algorithm>
+
+static const char *columnNames[StatsHistory::COLUMN_COUNT] =
+{
+    "population", "housed", "people_pool", "housing", "starving", "unemployed",
+    "births", "deaths", "tech", "money", "pollution"
+};
+
+//summed over a month or year instead of averaged
+static bool isTotal(int column)
+{   return column == StatsHistory::BIRTHS || column == StatsHistory::DEATHS;}
+
+void StatsHistory::Series::push(int day, const int *values)
+{
+    days[head] = day;
+    for (int c = 0; c < COLUMN_COUNT; ++c)
+    {   columns[c][head] = values[c];}
+    head = (head + 1) % capacity();
+    if (size < capacity())
+    {   ++size;}
+}
+
+StatsHistory::StatsHistory()
+{
+    const int kept[RESOLUTION_COUNT] = {STATS_DAYS_KEPT, STATS_MONTHS_KEPT, STATS_YEARS_KEPT};
+    for (int r = 0; r < RESOLUTION_COUNT; ++r)
+    {
+        series[r].days.resize(kept[r]);
+        for (int c = 0; c < COLUMN_COUNT; ++c)
+        {   series[r].columns[c].resize(kept[r]);}
+    }
+    reset();
+}
+
+void StatsHistory::reset()
+{
+    for (int r = 0; r < RESOLUTION_COUNT; ++r)
+    {
+        series[r].head = 0;
+        series[r].size = 0;
+        std::fill(series[r].days.begin(), series[r].days.end(), 0);
+        for (int c = 0; c < COLUMN_COUNT; ++c)
+        {   std::fill(series[r].columns[c].begin(), series[r].columns[c].end(), 0);}
+    }
+    monthDays = 0;
+    yearDays = 0;
+    for (int c = 0; c < COLUMN_COUNT; ++c)
+    {
+        monthSums[c] = 0;
+        yearSums[c] = 0;
+    }
+}
+
+static void rollUp(StatsHistory::Series &series, int day, long long *sums, int &days)
+{
+    int values[StatsHistory::COLUMN_COUNT];
+    for (int c = 0; c < StatsHistory::COLUMN_COUNT; ++c)
+    {
+        values[c] = isTotal(c) ? sums[c] : sums[c] / days;
+        sums[c] = 0;
+    }
+    days = 0;
+    series.push(day, values);
+}
+
+void StatsHistory::sampleDay()
+{
+    int values[COLUMN_COUNT];
+    values[POPULATION] = population + people_pool;
+    values[HOUSED] = population;
+    values[PEOPLE_POOL] = people_pool;
+    values[HOUSING] = housing;
+    values[STARVING] = starving_population;
+    values[UNEMPLOYED] = unemployed_population;
+    values[BIRTHS] = dbirths;
+    values[DEATHS] = ddeaths;
+    values[TECH] = tech_level;
+    values[MONEY] = total_money;
+    values[POLLUTION] = total_pollution;
+    series[DAILY].push(total_time, values);
+
+    for (int c = 0; c < COLUMN_COUNT; ++c)
+    {
+        monthSums[c] += values[c];
+        yearSums[c] += values[c];
+    }
+    ++monthDays;
+    ++yearDays;
+    if (total_time % NUMOF_DAYS_IN_MONTH == NUMOF_DAYS_IN_MONTH - 1)
+    {   rollUp(series[MONTHLY], total_time, monthSums, monthDays);}
+    if (total_time % NUMOF_DAYS_IN_YEAR == NUMOF_DAYS_IN_YEAR - 1)
+    {   rollUp(series[YEARLY], total_time, yearSums, yearDays);}
+}
+
+int StatsHistory::monthSoFar(Column column)
+{
+    if (!monthDays)
+    {   return 0;}
+    return isTotal(column) ? monthSums[column] : monthSums[column] / monthDays;
+}
+
+const char *StatsHistory::columnName(int column)
+{   return columnNames[column];}
+
+void StatsHistory::writeJSON(std::ostream &os, Resolution resolution)
+{
+    int n = count(resolution);
+    os << "{\"day\":[";
+    for (int age = n - 1; age >= 0; --age)
+    {   os << (age == n - 1 ? "" : ",") << day(resolution, age);}
+    os << "]";
+    for (int c = 0; c < COLUMN_COUNT; ++c)
+    {
+        os << ",\n\"" << columnNames[c] << "\":[";
+        for (int age = n - 1; age >= 0; --age)
+        {   os << (age == n - 1 ? "" : ",") << value(resolution, (Column)c, age);}
+        os << "]";
+    }
+    os << "}";
+}
+
+/** @file lincity/StatsHistory.cpp */
@@ -0,0 +1,80 @@
+/* ---------------------------------------------------------------------- *
+ * StatsHistory.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __StatsHistory_h__
+#define __StatsHistory_h__
+
+#include <ostream>
+#include <vector>
+
+#define STATS_DAYS_KEPT 1200    //one year of days
+#define STATS_MONTHS_KEPT 1200  //a century of months
+#define STATS_YEARS_KEPT 1000
+
+//History of the city statistics, sampled at the end of every day.
+//Every resolution is a ring buffer per column, the days of the last year,
+//the means of the months of the last century and the means of the years
+//before. Births and deaths are summed instead of averaged. Saved with the
+//globals in slot order, so the text of a slot only changes when it is
+//written again.
+class StatsHistory
+{
+public:
+    enum Column
+    {
+        POPULATION,     //housed and people_pool
+        HOUSED,
+        PEOPLE_POOL,
+        HOUSING,
+        STARVING,
+        UNEMPLOYED,
+        BIRTHS,
+        DEATHS,
+        TECH,
+        MONEY,
+        POLLUTION,
+        COLUMN_COUNT
+    };
+    enum Resolution { DAILY, MONTHLY, YEARLY, RESOLUTION_COUNT };
+
+    struct Series
+    {
+        int head;                       //slot of the next sample
+        int size;                       //samples kept
+        std::vector<int> days;          //last day of every sample
+        std::vector<int> columns[COLUMN_COUNT];
+        int capacity()
+        {   return days.size();}
+        int slot(int age)               //age 0 is the newest sample
+        {   return (head - 1 - age + 2 * capacity()) % capacity();}
+        void push(int day, const int *values);
+    };
+
+    StatsHistory();
+    void reset();
+    void sampleDay();       //called once the day is simulated
+
+    int count(Resolution resolution)
+    {   return series[resolution].size;}
+    int day(Resolution resolution, int age)
+    {   return series[resolution].days[series[resolution].slot(age)];}
+    int value(Resolution resolution, Column column, int age)
+    {   return series[resolution].columns[column][series[resolution].slot(age)];}
+    //mean or sum of the month in progress, 0 on its first day
+    int monthSoFar(Column column);
+    static const char *columnName(int column);
+    //oldest sample first, for the headless runner
+    void writeJSON(std::ostream &os, Resolution resolution);
+
+    Series series[RESOLUTION_COUNT];
+    //sums of the month and year in progress
+    int monthDays, yearDays;
+    long long monthSums[COLUMN_COUNT];
+    long long yearSums[COLUMN_COUNT];
+};
+
+#endif /* __StatsHistory_h__ */
+
+/** @file lincity/StatsHistory.h */
@@ -0,0 +1,110 @@
+/* ---------------------------------------------------------------------- *
+ * TradeGraph.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "TradeGraph.h"
+#include "lintypes.h"
+#include "engglobs.h"
+
+TradeGraph::TradeGraph()
+{
+    enabled = true;
+    dirty = true;
+    changes = 0;
+}
+
+void
+TradeGraph::invalidate()
+{
+    dirty = true;
+    ++changes;
+}
+
+unsigned int
+TradeGraph::version()
+{
+    return changes;
+}
+
+void
+TradeGraph::rebuild()
+{
+    //clear() keeps the capacity, so rebuilding rarely allocates
+    nodes.clear();
+    neighborStart.clear();
+    partnerStart.clear();
+    neighborSlots.clear();
+    partnerSlots.clear();
+    for (int i = 0; i < constructionCount.size(); ++i)
+    {
+        Construction *cst = constructionCount.pos(i);
+        if (!cst)
+        {   continue;}
+        cst->tradeIndex = nodes.size();
+        //links changed, so sleeping constructions have to look again
+        cst->asleepSince = -1;
+        nodes.push_back(cst);
+        neighborStart.push_back(neighborSlots.size());
+        neighborSlots.insert(neighborSlots.end(), cst->neighbors.begin(), cst->neighbors.end());
+        partnerStart.push_back(partnerSlots.size());
+        partnerSlots.insert(partnerSlots.end(), cst->partners.begin(), cst->partners.end());
+    }
+    neighborStart.push_back(neighborSlots.size());
+    partnerStart.push_back(partnerSlots.size());
+    dirty = false;
+}
+
+bool
+TradeGraph::contains(Construction *cst)
+{
+    if (dirty)
+    {   rebuild();}
+    //constructions made after the last rebuild without any links are not in here
+    return cst->tradeIndex >= 0 && (size_t)cst->tradeIndex < nodes.size()
+        && nodes[cst->tradeIndex] == cst;
+}
+
+Construction **
+TradeGraph::neighbors(Construction *cst, size_t *count)
+{
+    if (!enabled || !contains(cst))
+    {
+        *count = cst->neighbors.size();
+        return *count ? &cst->neighbors[0] : NULL;
+    }
+    size_t start = neighborStart[cst->tradeIndex];
+    *count = neighborStart[cst->tradeIndex + 1] - start;
+    return *count ? &neighborSlots[start] : NULL;
+}
+
+Construction **
+TradeGraph::partners(Construction *cst, size_t *count)
+{
+    if (!enabled || !contains(cst))
+    {
+        *count = cst->partners.size();
+        return *count ? &cst->partners[0] : NULL;
+    }
+    size_t start = partnerStart[cst->tradeIndex];
+    *count = partnerStart[cst->tradeIndex + 1] - start;
+    return *count ? &partnerSlots[start] : NULL;
+}
+
+size_t
+TradeGraph::nodeCount()
+{
+    if (dirty)
+    {   rebuild();}
+    return nodes.size();
+}
+
+Construction *
+TradeGraph::node(size_t i)
+{
+    return nodes[i];
+}
+
+/** @file lincity/TradeGraph.cpp */
+
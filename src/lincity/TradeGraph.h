@@ -0,0 +1,47 @@
+/* ---------------------------------------------------------------------- *
+ * TradeGraph.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __TradeGraph_h__
+#define __TradeGraph_h__
+
+#include <cstddef>
+#include <vector>
+
+class Construction;
+
+//Packed copy of the neighbors and partners of all constructions.
+//The links of node i are the slots from start[i] up to start[i+1] in one
+//array, so trading streams through contiguous memory. Construction::link_to
+//and deneighborize still edit the vectors of the constructions and mark the
+//graph dirty, it is rebuilt from them on the next lookup. The nodes are
+//kept up to date for PowerGrid even while lookups are disabled.
+class TradeGraph
+{
+public:
+    TradeGraph();
+    bool enabled;      //set every day from the config, false looks links up in the constructions
+    void invalidate(); //called whenever a link is made or cut
+    unsigned int version(); //changes whenever a link is made or cut
+    //links of cst, valid until the graph changes again
+    Construction **neighbors(Construction *cst, size_t *count);
+    Construction **partners(Construction *cst, size_t *count);
+    size_t nodeCount();
+    Construction *node(size_t i);
+protected:
+    bool dirty;
+    unsigned int changes;
+    std::vector<Construction *> nodes;
+    std::vector<size_t> neighborStart;
+    std::vector<size_t> partnerStart;
+    std::vector<Construction *> neighborSlots;
+    std::vector<Construction *> partnerSlots;
+    void rebuild();
+    bool contains(Construction *cst);
+};
+
+#endif /* __TradeGraph_h__ */
+
+/** @file lincity/TradeGraph.h */
+
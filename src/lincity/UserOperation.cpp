@@ -48,8 +48,8 @@ UserOperation::is_allowed_here(int x, int y, bool warning)
         //check_bulldoze_area in MapEdit is careful anyways
             return false;
         case ACTION_EVACUATE:
-            return (world.is_visible(x,y) && world(x,y)->reportingConstruction &&
-            ! (world(x,y)->reportingConstruction->flags & FLAG_NEVER_EVACUATE));
+            return (world.is_visible(x,y) && world(x,y)->reportingConstruction() &&
+            ! (world(x,y)->reportingConstruction()->flags & FLAG_NEVER_EVACUATE));
         case ACTION_FLOOD:
             return (world.is_visible(x,y) && world(x,y)->is_bare());
         default:
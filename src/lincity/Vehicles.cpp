@@ -38,8 +38,8 @@ Vehicle::Vehicle(int x0, int y0, VehicleModel model0, VehicleStrategy vehicleStr
     //TODO Choose a random model for suitable stuff
     this->model = model0;
     this->strategy = vehicleStrategy;
-    if (world(x,y)->reportingConstruction)
-    {   this->initial_cargo = world(x,y)->reportingConstruction->tellstuff(stuff_id,-2);}
+    if (world(x,y)->reportingConstruction())
+    {   this->initial_cargo = world(x,y)->reportingConstruction()->tellstuff(stuff_id,-2);}
     else
     {   this->initial_cargo = -1;}
 
@@ -326,14 +326,7 @@ void Vehicle::walk()
 
 void Vehicle::move_frame(int new_idx)
 {
-    if(!world(new_idx)->framesptr)
-    {   world(new_idx)->framesptr = new std::list<ExtraFrame>;}
-    world(new_idx)->framesptr->splice(world(new_idx)->framesptr->end(), *(world(map_idx)->framesptr), frameIt);
-    if(world(map_idx)->framesptr->empty())
-    {
-        delete world(map_idx)->framesptr;
-        world(map_idx)->framesptr = NULL;
-    }
+    world(new_idx)->takeframe(world(map_idx), frameIt);
     map_idx = new_idx; //remember where the frame was put
 }
 
@@ -361,22 +354,22 @@ bool Vehicle::acceptable_heading(int idx)
     {   return true;}
 
     //dont go nowhere
-    if(!world(idx)->reportingConstruction)
+    if(!world(idx)->reportingConstruction())
     {   return false;}
     //always leave from illegal area
-    if(!world(x,y)->reportingConstruction)
+    if(!world(x,y)->reportingConstruction())
     {   return true;}
 
     switch(strategy)
     {
         case VEHICLE_STRATEGY_MAXIMIZE:
-            return world(x,y)->reportingConstruction->tellstuff(stuff_id, -2)*24/25 <
-            world(idx)->reportingConstruction->tellstuff(stuff_id, -2) &&
-            initial_cargo*99/100 < world(idx)->reportingConstruction->tellstuff(stuff_id, -2);
+            return world(x,y)->reportingConstruction()->tellstuff(stuff_id, -2)*24/25 <
+            world(idx)->reportingConstruction()->tellstuff(stuff_id, -2) &&
+            initial_cargo*99/100 < world(idx)->reportingConstruction()->tellstuff(stuff_id, -2);
         case VEHICLE_STRATEGY_MINIMIZE:
-            return world(x,y)->reportingConstruction->tellstuff(stuff_id, -2) >
-            world(idx)->reportingConstruction->tellstuff(stuff_id, -2)*24/25
-            && initial_cargo > world(idx)->reportingConstruction->tellstuff(stuff_id, -2)*99/100;
+            return world(x,y)->reportingConstruction()->tellstuff(stuff_id, -2) >
+            world(idx)->reportingConstruction()->tellstuff(stuff_id, -2)*24/25
+            && initial_cargo > world(idx)->reportingConstruction()->tellstuff(stuff_id, -2)*99/100;
         default: //silence warning
         return true;
     }
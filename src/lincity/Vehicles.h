@@ -52,7 +52,7 @@ public:
     Construction::Commodities stuff_id; //cargo
     int initial_cargo;
     VehicleStrategy strategy; // delivery, pickup, random
-    std::list<ExtraFrame>::iterator frameIt; //the particular extraframe at the host
+    ExtraFrameList::iterator frameIt; //the particular extraframe at the host
     int map_idx;    //index of the maptile with the frame, NOT necessarily the current position
 
     int speed0, speed, anim;
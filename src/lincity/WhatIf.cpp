@@ -0,0 +1,146 @@
+/* ---------------------------------------------------------------------- *
+ * WhatIf.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "WhatIf.h"
+#include "engglobs.h"
+#include "simulate.h"
+#include "Profiler.h"
+
+#include <iostream>
+#include <string.h>
+#if !defined (WIN32)
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+WhatIf::WhatIf()
+{
+    pid = 0;
+    fd = -1;
+    summarize(before);
+}
+
+WhatIf::~WhatIf()
+{
+    cancel();
+}
+
+void WhatIf::summarize(WhatIfSummary &summary)
+{
+    summary.day = total_time;
+    summary.population = housed_population + people_pool;
+    summary.starving = starving_population;
+    summary.unemployed = unemployed_population;
+    summary.money = total_money;
+    summary.pollution = total_pollution;
+    summary.tech = tech_level;
+    summary.wallMs = 0;
+}
+
+#if defined (WIN32)
+
+bool WhatIf::start(const Journal::Entry *, int, const WhatIfHooks &)
+{
+    std::cerr << "WhatIf::start# forecasts need fork()" << std::endl;
+    return false;
+}
+
+bool WhatIf::poll(WhatIfSummary &)
+{   return false;}
+
+void WhatIf::cancel()
+{}
+
+#else
+
+bool WhatIf::start(const Journal::Entry *op, int days, const WhatIfHooks &hooks)
+{
+    cancel();
+    if (hooks.pause && !hooks.pause())
+    {
+        std::cerr << "WhatIf::start# the game is busy" << std::endl;
+        return false;
+    }
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        std::cerr << "WhatIf::start# pipe: " << strerror(errno) << std::endl;
+        if (hooks.resume)
+        {   hooks.resume();}
+        return false;
+    }
+    summarize(before);
+    pid = fork();
+    if (hooks.resume)
+    {   hooks.resume();}
+    if (pid < 0)
+    {
+        std::cerr << "WhatIf::start# fork: " << strerror(errno) << std::endl;
+        close(fds[0]);
+        close(fds[1]);
+        pid = 0;
+        return false;
+    }
+    if (pid == 0)
+    {
+        close(fds[0]);
+        if (hooks.detach)
+        {   hooks.detach();}
+        //the journal and the metrics belong to the game, not to the forecast
+        journal.detach();
+        metricsSink = NULL;
+        long long start = Profiler::now();
+        if (op)
+        {   Journal::apply(*op);}
+        for (int day = 0; day < days; ++day)
+        {   do_time_step();}
+        WhatIfSummary result;
+        summarize(result);
+        result.wallMs = (Profiler::now() - start) / 1000;
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        //no destructors and atexit handlers, they belong to the game as well
+        _exit(written == sizeof(result) ? 0 : 1);
+    }
+    close(fds[1]);
+    fd = fds[0];
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    return true;
+}
+
+bool WhatIf::poll(WhatIfSummary &result)
+{
+    if (pid <= 0)
+    {   return false;}
+    ssize_t got = read(fd, &result, sizeof(result));
+    if (got < 0 && (errno == EAGAIN || errno == EINTR))
+    {   return false;}
+    if (got != sizeof(result))
+    {   std::cerr << "WhatIf::poll# the forecast failed" << std::endl;}
+    close(fd);
+    fd = -1;
+    waitpid(pid, 0, 0);
+    pid = 0;
+    return got == sizeof(result);
+}
+
+void WhatIf::cancel()
+{
+    if (pid <= 0)
+    {   return;}
+    kill(pid, SIGKILL);
+    waitpid(pid, 0, 0);
+    close(fd);
+    fd = -1;
+    pid = 0;
+}
+
+#endif
+
+/** @file lincity/WhatIf.cpp */
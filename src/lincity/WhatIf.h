@@ -0,0 +1,60 @@
+/* ---------------------------------------------------------------------- *
+ * WhatIf.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __WhatIf_h__
+#define __WhatIf_h__
+
+#include "Journal.h"
+
+struct WhatIfSummary
+{
+    int day;
+    int population;
+    int starving;
+    int unemployed;
+    int money;
+    int pollution;
+    int tech;
+    int wallMs;     //milliseconds the forecast took
+};
+
+//What the game does around fork(). Only the forking thread lives on in
+//the forecast, so the other threads must not hold a lock at that moment.
+struct WhatIfHooks
+{
+    bool (*pause)();    //holds the other threads, false if it cannot yet
+    void (*resume)();   //lets them go on, runs in both processes
+    void (*detach)();   //runs in the forecast, keeps it off display and sound
+};
+
+//Simulates the city some years ahead while the game goes on.
+//The game process is forked, so the forecast starts from a snapshot of
+//everything. The child reports a WhatIfSummary through a pipe and exits.
+//Not available on Windows.
+class WhatIf
+{
+public:
+    WhatIf();
+    ~WhatIf();
+
+    //op is applied in the forecast only, 0 for none. Hooks left 0 are skipped.
+    bool start(const Journal::Entry *op, int days, const WhatIfHooks &hooks);
+    bool isRunning()
+    {   return pid > 0;}
+    //true once the forecast is done, then result holds its summary
+    bool poll(WhatIfSummary &result);
+    void cancel();
+
+    WhatIfSummary before;   //the city when the forecast started
+    static void summarize(WhatIfSummary &summary);
+
+private:
+    int pid;
+    int fd;     //read end of the pipe from the child
+};
+
+#endif /* __WhatIf_h__ */
+
+/** @file lincity/WhatIf.h */
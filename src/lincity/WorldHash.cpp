@@ -0,0 +1,207 @@
+/* ---------------------------------------------------------------------- *
+ * WorldHash.cpp
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+
+#include "WorldHash.h"
+#include "lintypes.h"
+#include "engglobs.h"
+#include "ConstructionCount.h"
+
+#include <stddef.h>
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+struct HashedGlobal
+{
+    const char *name;
+    const void *ptr;
+    size_t size;
+};
+
+#define HASHED_GLOBAL(global) { #global, &global, sizeof(global) }
+
+static const HashedGlobal hashedGlobals[] =
+{
+    HASHED_GLOBAL(total_time),
+    HASHED_GLOBAL(total_money),
+    HASHED_GLOBAL(tech_level),
+    HASHED_GLOBAL(highest_tech_level),
+    HASHED_GLOBAL(population),
+    HASHED_GLOBAL(starving_population),
+    HASHED_GLOBAL(housed_population),
+    HASHED_GLOBAL(unemployed_population),
+    HASHED_GLOBAL(people_pool),
+    HASHED_GLOBAL(max_pop_ever),
+    HASHED_GLOBAL(total_evacuated),
+    HASHED_GLOBAL(total_births),
+    HASHED_GLOBAL(total_pollution_deaths),
+    HASHED_GLOBAL(total_starve_deaths),
+    HASHED_GLOBAL(total_unemployed_days),
+    HASHED_GLOBAL(total_unemployed_years),
+    HASHED_GLOBAL(pollution_deaths_history),
+    HASHED_GLOBAL(starve_deaths_history),
+    HASHED_GLOBAL(unemployed_history),
+    HASHED_GLOBAL(rockets_launched),
+    HASHED_GLOBAL(rockets_launched_success),
+    HASHED_GLOBAL(coal_survey_done),
+    HASHED_GLOBAL(sust_dig_ore_coal_count),
+    HASHED_GLOBAL(sust_port_count),
+    HASHED_GLOBAL(sust_old_money_count),
+    HASHED_GLOBAL(sust_old_population_count),
+    HASHED_GLOBAL(sust_old_tech_count),
+    HASHED_GLOBAL(sust_fire_count)
+};
+
+static const int numHashedGlobals = sizeof(hashedGlobals) / sizeof(hashedGlobals[0]);
+
+//FNV-1a
+static void mix(WorldHash::Hash &hash, const void *data, size_t len)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < len; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+}
+
+template <typename T>
+static void mix(WorldHash::Hash &hash, const T &value)
+{   mix(hash, &value, sizeof(value));}
+
+static WorldHash::Hash hashTile(int index)
+{
+    WorldHash::Hash hash = FNV_OFFSET;
+    mix(hash, index);
+    MapTile tile = world(index);
+    mix(hash, tile->type());
+    mix(hash, tile->group());
+    mix(hash, tile->flags());
+    mix(hash, tile->coal_reserve());
+    mix(hash, tile->ore_reserve());
+    mix(hash, tile->pollution());
+    const Ground *ground = world.ground(index);
+    mix(hash, ground->altitude);
+    mix(hash, ground->ecotable);
+    mix(hash, ground->wastes);
+    mix(hash, ground->pollution);
+    mix(hash, ground->water_alt);
+    mix(hash, ground->water_pol);
+    mix(hash, ground->water_wast);
+    mix(hash, ground->water_next);
+    return hash;
+}
+
+//everything a savegame keeps of the construction
+static WorldHash::Hash hashConstruction(int index, Construction *cst)
+{
+    WorldHash::Hash hash = FNV_OFFSET;
+    mix(hash, index);
+    mix(hash, cst->constructionGroup->group);
+    const std::map<std::string, MemberRule> &rules = cst->memberRules();
+    std::map<std::string, MemberRule>::const_iterator member_it;
+    for (member_it = rules.begin(); member_it != rules.end(); ++member_it)
+    {
+        void *ptr = member_it->second.ptr(cst);
+        if (!ptr)
+        {   ptr = (void *)&Construction::missingMember;}
+        switch (member_it->second.memberType)
+        {
+            case Construction::TYPE_BOOL:
+                mix(hash, *static_cast<bool *>(ptr));
+                break;
+            case Construction::TYPE_INT:
+                mix(hash, *static_cast<int *>(ptr));
+                break;
+            case Construction::TYPE_USHORT:
+                mix(hash, *static_cast<unsigned short *>(ptr));
+                break;
+            case Construction::TYPE_DOUBLE:
+                mix(hash, *static_cast<double *>(ptr));
+                break;
+            case Construction::TYPE_FLOAT:
+                mix(hash, *static_cast<float *>(ptr));
+                break;
+        }
+    }
+    return hash;
+}
+
+WorldHash::WorldHash()
+{
+    detailed = false;
+    total = globals = tiles = constructions = 0;
+    since = 0;
+}
+
+WorldHash::Hash WorldHash::update()
+{
+    const int area = world.len() * world.len();
+    globals = constructions = 0;
+    if (detailed)
+    {
+        globalHashes.assign(numHashedGlobals, 0);
+        constructionHashes.assign(area, 0);
+    }
+    for (int i = 0; i < numHashedGlobals; ++i)
+    {
+        Hash hash = FNV_OFFSET;
+        mix(hash, i);
+        mix(hash, hashedGlobals[i].ptr, hashedGlobals[i].size);
+        globals += hash;
+        if (detailed)
+        {   globalHashes[i] = hash;}
+    }
+    //only the tiles changed since the last update are hashed again
+    if ((int)tileHashes.size() != area)
+    {
+        tileHashes.assign(area, 0);
+        tiles = 0;
+        since = 0;
+    }
+    int from = since;
+    since = world.nextGeneration();
+    for (int index = world.nextChanged(0, from); index < area;
+        index = world.nextChanged(index + 1, from))
+    {
+        Hash hash = hashTile(index);
+        tiles += hash - tileHashes[index];
+        tileHashes[index] = hash;
+    }
+    //members of constructions are written directly, so they are all hashed
+    for (int i = 0; i < constructionCount.size(); ++i)
+    {
+        Construction *cst = constructionCount.pos(i);
+        if (!cst)
+        {   continue;}
+        int index = cst->x + cst->y * world.len();
+        Hash hash = hashConstruction(index, cst);
+        constructions += hash;
+        if (detailed)
+        {   constructionHashes[index] = hash;}
+    }
+    total = globals + tiles + constructions;
+    return total;
+}
+
+int WorldHash::globalCount()
+{   return numHashedGlobals;}
+
+const char *WorldHash::globalName(int i)
+{   return hashedGlobals[i].name;}
+
+int WorldHash::firstDifference(const std::vector<Hash> &a, const std::vector<Hash> &b)
+{
+    size_t len = a.size() < b.size() ? a.size() : b.size();
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (a[i] != b[i])
+        {   return i;}
+    }
+    return a.size() == b.size() ? -1 : len;
+}
+
+/** @file lincity/WorldHash.cpp */
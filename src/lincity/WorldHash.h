@@ -0,0 +1,46 @@
+/* ---------------------------------------------------------------------- *
+ * WorldHash.h
+ * This file is part of lincity.
+ * Lincity is copyright (c) I J Peters 1995-1997, (c) Greg Sharp 1997-2001.
+ * ---------------------------------------------------------------------- */
+#ifndef __WorldHash_h__
+#define __WorldHash_h__
+
+#include <vector>
+
+//Hash of the simulation state: globals, tiles with their ground and the
+//saved members of every construction. Two ways of simulating the same
+//city must end up with the same hash every day.
+//The total is the sum of the hashes of the parts, so a part that changes
+//can be replaced without hashing everything again. Tiles are only hashed
+//again once World stamped them as changed. With detailed set the hash of
+//every global and construction is kept too, which tells the first global,
+//tile or construction that differs from another run.
+class WorldHash
+{
+public:
+    typedef unsigned long long Hash;
+
+    WorldHash();
+    bool detailed;
+    Hash update();      //hashes the current state, returns total
+
+    Hash total;
+    Hash globals;
+    Hash tiles;
+    Hash constructions;
+    std::vector<Hash> globalHashes;         //by globalName
+    std::vector<Hash> tileHashes;           //by world index, always kept
+    std::vector<Hash> constructionHashes;   //by world index of the construction, 0 if none
+
+    int since;          //generation of the last update
+
+    static int globalCount();
+    static const char *globalName(int i);
+    //first index where a and b differ, -1 if they are equal
+    static int firstDifference(const std::vector<Hash> &a, const std::vector<Hash> &b);
+};
+
+#endif /* __WorldHash_h__ */
+
+/** @file lincity/WorldHash.h */
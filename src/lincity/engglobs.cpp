@@ -12,7 +12,16 @@ int ldsv_version;
 int use_waterwell = true;
 
 ConstructionCount constructionCount = ConstructionCount();
-World world = World(WORLD_SIDE_LEN);
+TradeGraph tradeGraph;
+PowerGrid powerGrid;
+GroupCosts groupCosts;
+Journal journal;
+WhatIf whatIf;
+RewindBuffer rewindBuffer;
+DeltaSave deltaSave;
+StatsHistory statsHistory;
+MetricsSink* metricsSink = NULL;
+World world(WORLD_SIDE_LEN);
 int world_id = 0;
 UserOperation* userOperation = NULL;
 
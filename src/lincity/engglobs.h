@@ -10,6 +10,15 @@
 #include "groups.h"
 #include "world.h"
 #include "ConstructionCount.h"
+#include "TradeGraph.h"
+#include "PowerGrid.h"
+#include "GroupCosts.h"
+#include "Journal.h"
+#include "WhatIf.h"
+#include "RewindBuffer.h"
+#include "DeltaSave.h"
+#include "StatsHistory.h"
+#include "MetricsSink.h"
 #include "UserOperation.h"
 // Use permutator to shuffle the simulation order
 //#include "lincity-ng/Permutator.hpp"
@@ -26,6 +35,15 @@ extern struct GROUP main_groups[NUM_OF_GROUPS];
 extern struct TYPE main_types[NUM_OF_TYPES];
 
 extern ConstructionCount constructionCount;
+extern TradeGraph tradeGraph;
+extern PowerGrid powerGrid;
+extern GroupCosts groupCosts;
+extern Journal journal;
+extern WhatIf whatIf;
+extern RewindBuffer rewindBuffer;
+extern DeltaSave deltaSave;
+extern StatsHistory statsHistory;
+extern MetricsSink* metricsSink;
 extern World world;
 extern int world_id;
 extern UserOperation* userOperation;
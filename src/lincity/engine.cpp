@@ -39,17 +39,17 @@ void fire_area(int x, int y)
     /* this happens when a rocket crashes or on random_fire. */
     if (world(x, y)->getGroup() == GROUP_WATER || world(x, y)->getGroup() == GROUP_FIRE)
     {   return;}
-    if(world(x, y)->reportingConstruction)
+    if(world(x, y)->reportingConstruction())
     {
         //fire is an unatural death for one in two
         if(world(x,y)->is_residence())
         {
-            int casualities = ((dynamic_cast<Residence*>(world(x,y)->reportingConstruction))->local_population/2);
-            (dynamic_cast<Residence*>(world(x,y)->reportingConstruction))->local_population -= casualities;
+            int casualities = ((dynamic_cast<Residence*>(world(x,y)->reportingConstruction()))->local_population/2);
+            (dynamic_cast<Residence*>(world(x,y)->reportingConstruction()))->local_population -= casualities;
             tunnat_deaths += casualities;
             ddeaths += casualities;
         }
-        ConstructionManager::submitRequest( new SetOnFire(world(x,y)->reportingConstruction));
+        ConstructionManager::submitRequest( new SetOnFire(world(x,y)->reportingConstruction()));
     }
 }
 
@@ -81,6 +81,7 @@ int place_item(int x, int y)
                 ("ERROR: group does not exist. This should not happen! Please consider filling a bug report to lincity-ng team, with the saved game and what you did :-) "));
         return -1000;
     }
+    journal.record(Journal::OP_BUILD, x, y, group);
 
 #ifdef DEBUG
     assert(userOperation->constructionGroup->is_allowed_here(x,y,false));
@@ -101,6 +102,7 @@ int bulldoze_item(int x, int y)
 {
     int g, size = 1;
     bool construction_found = false;
+    journal.record(Journal::OP_BULLDOZE, x, y);
     if (!world(x, y)->is_visible())
     {
         /* This is considered "improper" input.  Silently ignore. */
@@ -110,16 +112,16 @@ int bulldoze_item(int x, int y)
         return -1;
     }
 
-    if (world(x, y)->reportingConstruction )
+    if (world(x, y)->reportingConstruction() )
     {
         construction_found = true;
-        size = world(x, y)->reportingConstruction->constructionGroup->size;
-        g = world(x, y)->reportingConstruction->constructionGroup->group;
+        size = world(x, y)->reportingConstruction()->constructionGroup->size;
+        g = world(x, y)->reportingConstruction()->constructionGroup->group;
     }
     else
     {
         size = 1; //all non-constructions are 1// MP_SIZE(x, y);
-        g = world(x, y)->group;
+        g = world(x, y)->group();
         //size = main_groups[g].size;
     }
 
@@ -132,7 +134,7 @@ int bulldoze_item(int x, int y)
     {
         ConstructionManager::executeRequest
                 (
-                    new BurnDownRequest(world(x,y)->reportingConstruction)
+                    new BurnDownRequest(world(x,y)->reportingConstruction())
                 );
         adjust_money(-GROUP_SHANTY_BUL_COST);
     }
@@ -145,12 +147,12 @@ int bulldoze_item(int x, int y)
         if (!construction_found)
         {   adjust_money(-world(x,y)->getTileConstructionGroup()->bul_cost);}
         else
-        {   adjust_money(-world(x, y)->reportingConstruction->constructionGroup->bul_cost);}
+        {   adjust_money(-world(x, y)->reportingConstruction()->constructionGroup->bul_cost);}
 
         if (g == GROUP_OREMINE)
         {
             ConstructionManager::executeRequest
-            (   new OreMineDeletionRequest(world(x, y)->reportingConstruction));
+            (   new OreMineDeletionRequest(world(x, y)->reportingConstruction()));
         }
         else
         {   do_bulldoze_area(x, y);}
@@ -160,30 +162,59 @@ int bulldoze_item(int x, int y)
     return size;                /* No longer used... */
 }
 
+void flood_tile(int x, int y, int cost)
+{
+    journal.record(Journal::OP_FLOOD, x, y, cost);
+    world(x, y)->setTerrain(GROUP_WATER);
+    world(x, y)->addFlags(FLAG_ALTERED);
+    adjust_money(-cost);
+    connect_transport(x - 2, y - 2, x + 1 + 1, y + 1 + 1);
+    desert_water_frontiers(x - 1, y - 1, 1 + 2, 1 + 2);
+    connect_rivers(x, y);
+}
+
+void toggle_evacuation(int x, int y)
+{
+    Construction *cst = world(x, y)->reportingConstruction();
+    if (!cst)
+    {   return;}
+    journal.record(Journal::OP_EVACUATE, cst->x, cst->y);
+    if (cst->constructionGroup->group == GROUP_MARKET)
+    {
+        dynamic_cast<Market*>(cst)->toggleEvacuation();
+        return;
+    }
+    if (cst->flags & FLAG_EVACUATE)
+    {   cst->flags &= ~FLAG_EVACUATE;}
+    else
+    {   cst->flags |= FLAG_EVACUATE;}
+    cst->wake();
+}
+
 void do_bulldoze_area(int x, int y) //arg1 was short fill
 {
 
-    if (world(x, y)->reportingConstruction)
+    if (world(x, y)->reportingConstruction())
     {
         ConstructionManager::executeRequest
-        (   new ConstructionDeletionRequest(world(x, y)->reportingConstruction));
+        (   new ConstructionDeletionRequest(world(x, y)->reportingConstruction()));
     }
     else
     {
-        world(x, y)->flags &= ~(FLAG_POWER_CABLES_0 | FLAG_POWER_CABLES_90);
+        world(x, y)->clearFlags(FLAG_POWER_CABLES_0 | FLAG_POWER_CABLES_90);
         if (world(x, y)->is_water())
         {
-            world(x, y)->type = CST_GREEN;
-            world(x, y)->group = GROUP_BARE;
-            world(x, y)->flags &= ~(FLAG_IS_RIVER);
-            world(x, y)->flags |= FLAG_ALTERED;
+            world(x, y)->setType(CST_GREEN);
+            world(x, y)->setGroup(GROUP_BARE);
+            world(x, y)->clearFlags(FLAG_IS_RIVER);
+            world(x, y)->addFlags(FLAG_ALTERED);
         }
         else
         {
-            world(x, y)->type = CST_DESERT;
-            world(x, y)->group = GROUP_DESERT;
+            world(x, y)->setType(CST_DESERT);
+            world(x, y)->setGroup(GROUP_DESERT);
         }
-        if (world(x, y)->construction)
+        if (world(x, y)->construction())
         {   ok_dial_box("fire.mes", BAD, _("ups, Bulldozer found a dangling reportingConstruction"));}
         //Here size is always 1
         connect_transport(x - 2, y - 2, x + 1 + 1, y + 1 + 1);
@@ -203,11 +234,11 @@ void do_pollution()
     {
         if (world.is_border(*it))
         {
-            world(*it)->pollution /= POL_DIV;
+            world(*it)->setPollution(world(*it)->pollution() / POL_DIV);
             continue;
         }
 
-        if (world(*it)->pollution > 10 )
+        if (world(*it)->pollution() > 10 )
         {
             int x = *it % len;
             int y = *it / len;
@@ -215,30 +246,30 @@ void do_pollution()
             //assert(world.is_visible(x,y));
 
             int pflow;
-            pflow = world(x, y)->pollution/16;
-            world(x, y)->pollution -= pflow;
+            pflow = world(x, y)->pollution()/16;
+            world(x, y)->addPollution(-pflow);
             switch (rand() % 11)
             {
                 case 0:/* up */
                 case 1:
                 case 2:
-                    world(x, y-1)->pollution += pflow;
+                    world(x, y-1)->addPollution(pflow);
                 break;
                 case 3:/* right */
                 case 4:
                 case 5:
-                    world(x-1, y)->pollution += pflow;
+                    world(x-1, y)->addPollution(pflow);
                 break;
                 case 6:/* down */
                 case 7:
-                    world(x, y+1)->pollution += pflow;
+                    world(x, y+1)->addPollution(pflow);
                 break;
                 case 8:/* left */
                 case 9:
-                    world(x+1, y)->pollution += pflow;
+                    world(x+1, y)->addPollution(pflow);
                 break;
                 case 10:/* clean up*/
-                    world(x, y)->pollution += (pflow - 2);
+                    world(x, y)->addPollution(pflow - 2);
                 break;
             }// endswitch
         }// endif
@@ -256,13 +287,13 @@ void scan_pollution()
         int x = index % len;
         int y = index / len;
         it = world.polluted.find(index);
-        if( (world(x,y)->pollution > 10)
+        if( (world(x,y)->pollution() > 10)
          && (it == world.polluted.end()))
         {   world.polluted.insert(index);}
-        else if ((world(x,y)->pollution <= 10)
+        else if ((world(x,y)->pollution() <= 10)
               && (it != world.polluted.end()))
         {   world.polluted.erase(it);}
-        total_pollution += world(x,y)->pollution;
+        total_pollution += world(x,y)->pollution();
     }
 }
 
@@ -270,9 +301,9 @@ void do_fire_health_cricket_power_cover(void)
 {
     const int len = world.len();
     const int area = len * len;
-    const int mask = ~(FLAG_FIRE_COVER | FLAG_HEALTH_COVER | FLAG_CRICKET_COVER | FLAG_MARKET_COVER );
+    const int mask = FLAG_FIRE_COVER | FLAG_HEALTH_COVER | FLAG_CRICKET_COVER | FLAG_MARKET_COVER;
     for(int index = 0; index < area; ++index)
-    {   world(index)->flags &= mask;}
+    {   world(index)->clearFlags(mask);}
     refresh_cover = true; //constructions will call ::cover()
 }
 
@@ -291,18 +322,18 @@ void do_random_fire(int x, int y, int pwarning)
             return;
         }
     }
-    if(world(x, y)->reportingConstruction)
+    if(world(x, y)->reportingConstruction())
     {
-        xx = world(x, y)->reportingConstruction->x;
-        yy = world(x, y)->reportingConstruction->y;
+        xx = world(x, y)->reportingConstruction()->x;
+        yy = world(x, y)->reportingConstruction()->y;
         x = xx;
         y = yy;
     }
 
     xx = rand() % 100;
-    if(world(x, y)->reportingConstruction)
+    if(world(x, y)->reportingConstruction())
     {
-        if (xx >= world(x, y)->reportingConstruction->constructionGroup->fire_chance)
+        if (xx >= world(x, y)->reportingConstruction()->constructionGroup->fire_chance)
             return;
     }
     else
@@ -310,12 +341,12 @@ void do_random_fire(int x, int y, int pwarning)
         if (xx >= (world(x, y)->getConstructionGroup()->fire_chance))
             return;
     }
-    if ((world(x, y)->flags & FLAG_FIRE_COVER) != 0)
+    if ((world(x, y)->flags() & FLAG_FIRE_COVER) != 0)
         return;
     if (pwarning)
     {
-        if(world(x, y)->reportingConstruction)
-            ok_dial_box("fire.mes", BAD, world(x, y)->reportingConstruction->
+        if(world(x, y)->reportingConstruction())
+            ok_dial_box("fire.mes", BAD, world(x, y)->reportingConstruction()->
 constructionGroup->name);
         else
             ok_dial_box("fire.mes", BAD, _("UNKNOWN!"));
@@ -331,7 +362,7 @@ void do_daily_ecology() //should be going to MapTile:: und handled during simula
     {
         /* approximately 3 monthes needed to turn bulldoze area into green */
         if ((world(idx)->getLowerstVisibleGroup() == GROUP_DESERT)
-            && (world(idx)->flags & FLAG_HAS_UNDERGROUND_WATER)
+            && (world(idx)->flags() & FLAG_HAS_UNDERGROUND_WATER)
             && (rand() % 300 == 1))
         {
             world(idx)->setTerrain(CST_GREEN);
@@ -395,7 +426,7 @@ void connect_rivers(int x, int y)
             int yy = y + dy[i];
             if(world(xx,yy)->is_river())
             {
-                world(x, y)->flags |= FLAG_IS_RIVER;
+                world(x, y)->addFlags(FLAG_IS_RIVER);
                 i = 4;
                 //now check for more close by lakes
                 for(unsigned int j = 0;j<4;++j)
@@ -415,6 +446,7 @@ void do_coal_survey(void)
 {
     if (coal_survey_done == 0)
     {
+        journal.record(Journal::OP_COAL_SURVEY, 0, 0);
         adjust_money(-1000000);
         coal_survey_done = 1;
     }
@@ -469,7 +501,7 @@ void desert_water_frontiers(int originx, int originy, int w, int h)
                 {   mask |= 2;}
                 if ( check_lvgroup(x, y + 1) == GROUP_DESERT )
                 {   ++mask;}
-                world(x, y)->type = mask;
+                world(x, y)->setType(mask);
             }
             else if ( world(x, y)->getLowerstVisibleGroup() == GROUP_WATER)
             {
@@ -484,7 +516,7 @@ void desert_water_frontiers(int originx, int originy, int w, int h)
                 {   mask |= 2;}
                 if (  check_water(x, y + 1)  )
                 {   ++mask;}
-                world(x, y)->type = mask;
+                world(x, y)->setType(mask);
             }
         }
     }
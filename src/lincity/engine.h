@@ -10,6 +10,8 @@ int adjust_money(int value);
 int place_item(int x, int y);
 int bulldoze_item(int x, int y);
 void do_bulldoze_area(int x, int y);
+void flood_tile(int x, int y, int cost);
+void toggle_evacuation(int x, int y);
 void do_coal_survey(void);
 void do_random_fire(int x, int y, int pwarning);
 void fire_area(int x, int y);
@@ -43,7 +43,6 @@
 
 //static void init_mappoint_array(void);
 static void initialize_tax_rates(void);
-static void nullify_mappoint(int x, int y);
 static void random_start(int *originx, int *originy);
 static void coal_reserve_setup(void);
 static void ore_reserve_setup(void);
@@ -71,14 +70,19 @@ void destroy_game(void)
 {
     ConstructionManager::clearRequests();
     Vehicle::clearVehicleList();
-    const int len = world.len();
-    const int area = len * len;
-    for (int index = 0; index < area; ++index)
-    {
-        int xx = index % world.len();
-        int yy = index / world.len();
-        nullify_mappoint(xx, yy);
-    }
+    //Everything goes, so there is no need to bulldoze constructions one by one
+    //and reconnect their neighbors each time
+    world.clear();
+    constructionCount.reset();
+    tradeGraph.invalidate();
+    groupCosts.reset();
+    journal.stopRecording();
+    whatIf.cancel();
+    if (!rewindBuffer.isRestoring())
+    {   rewindBuffer.reset();}
+    deltaSave.reset();
+    statsHistory.reset();
+    ConstructionPool::resetAll();
 }
 
 void clear_game(void)
@@ -205,13 +209,13 @@ void setup_land()
         if(world(xx,yy)->is_water())
         {
             *dist(xx,yy) = 0;
-            *water(xx,yy) = world(xx,yy)->ground.water_alt;
+            *water(xx,yy) = world.ground(xx,yy)->water_alt;
             line.push_back(xx + yy * len);
         }
         else
         {
             *dist(xx,yy) = 50;
-            *water(xx,yy) = 3*world(xx,yy)->ground.altitude/4;
+            *water(xx,yy) = 3*world.ground(xx,yy)->altitude/4;
         }
     }
     //std::cout << "detected " << line.size() << " river tiles" << std::endl;
@@ -232,9 +236,9 @@ void setup_land()
       if(!world.is_visible(xt,yt))
       {  continue;}
             int old_eco = (*dist(xt,yt) * *dist(xt,yt)/5 + 1) + arid +
-            (world(xt, yt)->ground.altitude - *water(xt,yt)) * 50 / alt_step;
+            (world.ground(xt, yt)->altitude - *water(xt,yt)) * 50 / alt_step;
             int next_eco = (next_dist * next_dist/5 + 1) + arid +
-                (world(xt, yt)->ground.altitude - water_alt) * 50 / alt_step;
+                (world.ground(xt, yt)->altitude - water_alt) * 50 / alt_step;
             if (world.is_visible(xt,yt) && next_eco < old_eco )
             {
                 *dist(xt,yt) = next_dist;
@@ -256,7 +260,7 @@ void setup_land()
         int alt0 = 0;
 
         /* test against IS_RIVER to prevent terrible recursion */
-        if ( (world(xx, yy)->flags & FLAG_IS_RIVER) || !world(xx, yy)->is_bare())
+        if ( (world(xx, yy)->flags() & FLAG_IS_RIVER) || !world(xx, yy)->is_bare())
             continue;
         r = *dist(xx,yy);
         d2w_min = r * r;
@@ -272,7 +276,7 @@ void setup_land()
         }
         /* Altitude has same effect as distance */
         r = rand()%(d2w_min/5 + 1) + arid +
-                (world(xx, yy)->ground.altitude - alt0) * 50 / alt_step;
+                (world.ground(xx, yy)->altitude - alt0) * 50 / alt_step;
         do_rand_ecology(xx,yy,r);
 
     }
@@ -305,7 +309,7 @@ void create_new_city(int *originx, int *originy, city_settings *city, int old_se
     coal_reserve_setup();
 
     global_mountainity= 100 + rand () % 300; // roughly water slope = 25m / 1km (=from N to S)
-    //global_mountainity = 200; //  nearly useless to have a random one (only impacts do_rand_ecology through world(x, y)->ground.altitude)
+    //global_mountainity = 200; //  nearly useless to have a random one (only impacts do_rand_ecology through world.ground(x, y)->altitude)
 
     switch (climate) {
         case 0:
@@ -374,7 +378,7 @@ static void coal_reserve_setup(void)
         }
         while (xx == 0 && yy == 0);
         for (j = 0; j < 5; j++) {
-            world(x, y)->coal_reserve += rand() % COAL_RESERVE_SIZE;
+            world(x, y)->setCoalReserve(world(x, y)->coal_reserve() + (rand() % COAL_RESERVE_SIZE));
             x += xx;
             y += yy;
         }
@@ -385,7 +389,7 @@ static void ore_reserve_setup(void)
 {
     const int area = world.len() * world.len();
     for (int index=0; index < area; index++ )
-    {   world(index)->ore_reserve = ORE_RESERVE;}
+    {   world(index)->setOreReserve(ORE_RESERVE);}
 }
 
 static void new_setup_river_ground(void)
@@ -675,9 +679,9 @@ static void new_setup_river_ground(void)
     {
         i = index % len;
         j = index / len;
-        world(i, j)->ground.altitude += int (*f1(SHIFT + i, SHIFT + j)) - alt_min + 1;// + (len-j*j/len)*global_mountainity/2;
-        if (  world(i, j)->ground.altitude > alt_max)
-            alt_max =  world(i, j)->ground.altitude;
+        world.pokeGround(i, j)->altitude += int (*f1(SHIFT + i, SHIFT + j)) - alt_min + 1;// + (len-j*j/len)*global_mountainity/2;
+        if (  world.ground(i, j)->altitude > alt_max)
+            alt_max =  world.ground(i, j)->altitude;
     }
 
     // take visible value for maximum color dynamic
@@ -696,9 +700,9 @@ static void new_setup_river_ground(void)
     {
         i = index % len;
         j = index / len;
-        if (  world.is_visible(i,j) && world(i, j)->ground.altitude < sea_level)
+        if (  world.is_visible(i,j) && world.ground(i, j)->altitude < sea_level)
         {
-            world(i, j)->ground.altitude = sea_level;
+            world.pokeGround(i, j)->altitude = sea_level;
             set_river_tile(i,j);
         }
     }
@@ -728,10 +732,10 @@ static void new_setup_river(void)
     // Put the gray border (not visible) at alt_min - 1, for easier rivers handling.
     for ( i = 0; i < len; i++)
     {
-        world(i, 0)->ground.altitude = alt_min ;
-        world(i, world.len() - 1)->ground.altitude = alt_min ;
-        world(0, i)->ground.altitude = alt_min ;
-        world(world.len() - 1, i)->ground.altitude = alt_min ;
+        world.pokeGround(i, 0)->altitude = alt_min ;
+        world.pokeGround(i, world.len() - 1)->altitude = alt_min ;
+        world.pokeGround(0, i)->altitude = alt_min ;
+        world.pokeGround(world.len() - 1, i)->altitude = alt_min ;
     }
 
     l = 0;
@@ -820,7 +824,7 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
     line.clear();
     lake.clear();
     //make sure a shallow min is an actual min
-    level = --world(start_x,start_y)->ground.altitude;
+    level = --world.pokeGround(start_x,start_y)->altitude;
     //int level0 = level;
     *i1(start_x,start_y) = 1;
     line.push_back(start_x + start_y * len);
@@ -839,11 +843,11 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
         int xx = index % len;
         int yy = index / len;
         //assert(*i1(xx,yy) == 1);
-        level = world(xx,yy)->ground.altitude;
+        level = world.ground(xx,yy)->altitude;
 /*      /Not needed if altitude == flooding level
-        if (world(xx,yy)->ground.water_alt > level)
+        if (world.ground(xx,yy)->water_alt > level)
         {
-            level = world(xx,yy)->ground.water_alt;
+            level = world.ground(xx,yy)->water_alt;
         }
 */
         //dont grow lakes in diagonal steps,
@@ -856,11 +860,11 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
             {
                 continue;
             }
-            new_level = world(x,y)->ground.altitude;
+            new_level = world.ground(x,y)->altitude;
 /*          //Not needed if altitude == flooding level
-            if (world(x,y)->ground.water_alt > new_level)
+            if (world.ground(x,y)->water_alt > new_level)
             {
-                new_level = world(x,y)->ground.water_alt;
+                new_level = world.ground(x,y)->water_alt;
             }
 */
             if ((new_level >= level && new_level < lowest_exit_level))
@@ -885,12 +889,12 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
                         if (!world.is_inside(tx,ty))
                         {   continue;}
                         //Allow a little walking along edge of a plateau
-                        if(min_alt >= world(tx, ty)->ground.altitude)
+                        if(min_alt >= world.ground(tx, ty)->altitude)
                         {
                             //dont go back into lake at first step i.e test if there is any second exit
                             if ( s == 1 && *i1(tx,ty))
                             {   continue;}
-                            min_alt = world(tx, ty)->ground.altitude;
+                            min_alt = world.ground(tx, ty)->altitude;
                             x_min = tx;
                             y_min = ty;
                         }
@@ -938,7 +942,7 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
                 {
                     int xt = x;
                     int yt = y;
-                    if (world(xx,y)->ground.altitude > world(x,yy)->ground.altitude)
+                    if (world.ground(xx,y)->altitude > world.ground(x,yy)->altitude)
                     {
                         yt = yy;
                     }
@@ -946,7 +950,7 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
                     {
                         xt = xx;
                     }
-                    world(xt,yt)->ground.altitude = world(x,y)->ground.altitude;
+                    world.pokeGround(xt,yt)->altitude = world.ground(x,y)->altitude;
                     set_river_tile(xt,yt);
                 }
             }
@@ -964,7 +968,7 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
                 {   continue;}
                 int tx = idx % len;
                 int ty = idx / len;
-                if (world(tx,ty)->ground.altitude < lowest_exit_level)
+                if (world.ground(tx,ty)->altitude < lowest_exit_level)
                 {
                     line.push_back(tx + ty * len);
                     *i1(tx,ty) = 1;
@@ -988,10 +992,10 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
         {   continue;}
         int x = index % len;
         int y = index / len;
-        world(x,y)->ground.altitude = flooding_level;
+        world.pokeGround(x,y)->altitude = flooding_level;
         set_river_tile(x,y);
         //mark as lake
-        world(x,y)->flags |= FLAG_IS_LAKE;
+        world(x,y)->addFlags(FLAG_IS_LAKE);
     } //end for lake.size()
     //last_lake = start_x + start_y * len;
     for (size_t i=0; i<river_starts.size(); i++)
@@ -1020,10 +1024,10 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
                 int x = index % len;
                 int y = index / len;
 
-                if(lowest_exit_level > world(x,y)->ground.altitude)
+                if(lowest_exit_level > world.ground(x,y)->altitude)
                 //lowest naked river end
                 {
-                    lowest_exit_level = world(x,y)->ground.altitude;
+                    lowest_exit_level = world.ground(x,y)->altitude;
                     i_min = i;
                 }
             }
@@ -1035,11 +1039,11 @@ static int overfill_lake(int start_x, int start_y)//, Shoreline *shore, int lake
 
 void set_river_tile( int x, int y)
 {
-    world(x, y)->type = CST_WATER;
-    world(x, y)->group = GROUP_WATER;
-    world(x, y)->flags |= FLAG_IS_RIVER;
-    world(x, y)->flags |= FLAG_HAS_UNDERGROUND_WATER;
-    world(x, y)->ground.water_alt = world(x, y)->ground.altitude;
+    world(x, y)->setType(CST_WATER);
+    world(x, y)->setGroup(GROUP_WATER);
+    world(x, y)->addFlags(FLAG_IS_RIVER);
+    world(x, y)->addFlags(FLAG_HAS_UNDERGROUND_WATER);
+    world.pokeGround(x, y)->water_alt = world.ground(x, y)->altitude;
 }
 
 /*
@@ -1053,7 +1057,7 @@ static void sort_by_altitude(int n, std::vector <int> *tabx, std::vector <int> *
     for (int i = 0; i < n && !sorted ; i++) {
         sorted = true;
         for (int j=1; j < n - i; j++)
-            if (world((*tabx)[j],(*taby)[j])->ground.altitude < world((*tabx)[j-1], (*taby)[j-1])->ground.altitude) {
+            if (world.ground((*tabx)[j],(*taby)[j])->altitude < world.ground((*tabx)[j-1], (*taby)[j-1])->altitude) {
                 tmp_x = (*tabx)[j-1];
                 tmp_y = (*taby)[j-1];
                 (*tabx)[j-1] =  (*tabx)[j];
@@ -1075,7 +1079,7 @@ static int quick_river( int xx, int yy)
     y_now = yy;
     x_new = xx;
     y_new = yy;
-    new_alt = world(x_now,y_now)->ground.altitude;
+    new_alt = world.ground(x_now,y_now)->altitude;
     //std::cout << "new river: " << x_now << ", " << y_now;// << " alt = " <<  new_alt;
     do
     {
@@ -1087,9 +1091,9 @@ static int quick_river( int xx, int yy)
         {
             int x = x_now + dx[i];
             int y = y_now + dy[i];
-            if (world.is_inside(x,y) && world(x,y)->ground.altitude < new_alt && !world(x,y)->is_river())
+            if (world.is_inside(x,y) && world.ground(x,y)->altitude < new_alt && !world(x,y)->is_river())
             {
-                new_alt = world(x,y)->ground.altitude;
+                new_alt = world.ground(x,y)->altitude;
                 x_new = x;
                 y_new = y;
                 j = i;
@@ -1099,7 +1103,7 @@ static int quick_river( int xx, int yy)
         if (j>3) //we moved in the diagonal
         {
             //std::cout << ".";
-            if (world(x_now + dx[j], y_now)->ground.altitude > world(x_now, y_now + dy[j])->ground.altitude)
+            if (world.ground(x_now + dx[j], y_now)->altitude > world.ground(x_now, y_now + dy[j])->altitude)
                 set_river_tile(x_now, y_now + dy[j]);
             else
                 set_river_tile(x_now + dx[j], y_now);
@@ -1116,9 +1120,9 @@ static int quick_river( int xx, int yy)
     {
         int x = x_now + dx[i];
         int y = y_now + dy[i];
-        if (world.is_visible(x,y) && world(x,y)->ground.altitude < new_alt)
+        if (world.is_visible(x,y) && world.ground(x,y)->altitude < new_alt)
         {
-            new_alt = world(x,y)->ground.altitude;
+            new_alt = world.ground(x,y)->altitude;
             x_new = x;
             y_new = y;
         }
@@ -1136,7 +1140,7 @@ static void setup_river(void)
     int alt = 1; //lowest altitude in the map = surface of the river at mouth.
     x = (1 * len + rand() % len) / 3;
     y = len - 1;
-    world(x, y)->ground.water_alt = alt; // 1 unit = 1 cm ,
+    world.pokeGround(x, y)->water_alt = alt; // 1 unit = 1 cm ,
                         //for rivers .water_alt = .altitude = surface of the water
                         //for "earth tile" .water_alt = alt of underground water
                         //                 .altitude = alt of the ground
@@ -1230,7 +1234,7 @@ static void setup_ground(void)
         if ( world(x, y)->is_river())
         {
             *i1(x,y) = 0;
-            world(x,y)->ground.water_alt = world(x,y)->ground.altitude = (len-y*y/len) * slope;
+            world.pokeGround(x,y)->water_alt = world.pokeGround(x,y)->altitude = (len-y*y/len) * slope;
             line.push_back(index);
         }
         else
@@ -1254,7 +1258,7 @@ static void setup_ground(void)
             int new_dist = *i1(tx,ty);
             if ( !world.is_visible(tx,ty) || world(tx,ty)->is_river() || new_dist <= dist)
             {   continue;}
-            world(tx,ty)->ground.altitude = ((len-ty*ty/len + dist/2 + 2*(len*len - (len-dist)*(len-dist))/len) * slope);
+            world.pokeGround(tx,ty)->altitude = ((len-ty*ty/len + dist/2 + 2*(len*len - (len-dist)*(len-dist))/len) * slope);
             *i1(tx,ty) = dist;
             line.push_back(tx + ty * len);
         }
@@ -1274,10 +1278,10 @@ static void setup_ground(void)
         {
             continue;
         }
-        if (alt_min > world(x, y)->ground.altitude)
-        {   alt_min = world(x, y)->ground.altitude;}
-        if (alt_max < world(x, y)->ground.altitude)
-        {   alt_max = world(x, y)->ground.altitude;}
+        if (alt_min > world.ground(x, y)->altitude)
+        {   alt_min = world.ground(x, y)->altitude;}
+        if (alt_max < world.ground(x, y)->altitude)
+        {   alt_max = world.ground(x, y)->altitude;}
 
      }
     alt_step = (alt_max - alt_min) /10;
@@ -1296,60 +1300,12 @@ static void remove_river(void)
             world(index)->group = GROUP_BARE;
             world(index)->flags &= ~FLAG_IS_RIVER;
             world(index)->flags &= ~FLAG_HAS_UNDERGROUND_WATER;
-            world(index)->ground.water_alt = 0;
+            world.pokeGround(index)->water_alt = 0;
         }
     }
 }
 */
 
-static void nullify_mappoint(int x, int y)
-{
-    MapTile * tile = world(x,y);
-    ConstructionGroup *constGrp = 0;
-    if(tile->construction)
-    {
-        constGrp = tile->construction->constructionGroup;
-        do_bulldoze_area(x, y);
-        //turn fresh desert into grass
-        tile->type = CST_GREEN;
-        tile->group = GROUP_BARE;
-    }
-    else
-    {
-        tile->reportingConstruction = NULL;
-        tile->type = CST_GREEN;
-        tile->group = GROUP_BARE;
-    }
-#ifdef DEBUG
-    assert( !(tile->framesptr) );
-#endif
-    if (tile->framesptr)
-    {
-        std::cout << "Invalid ExtraFrames at x,y: " << x << "," << y << " " << constGrp->name << std::endl;
-        tile->framesptr->clear();
-        delete tile->framesptr;
-        tile->framesptr = NULL;
-    }
-    tile->flags = 0;
-    tile->coal_reserve = 0;
-    tile->ore_reserve = 0;
-    tile->pollution = 0;
-
-    tile->ground.altitude = 0;
-    tile->ground.ecotable = 0;
-    tile->ground.wastes = 0;
-    tile->ground.pollution = 0;
-    tile->ground.water_alt = 0;
-    tile->ground.water_pol = 0;
-    tile->ground.water_wast = 0;
-    tile->ground.water_next = 0;
-    tile->ground.int1 = 0;
-    tile->ground.int2 = 0;
-    tile->ground.int3 = 0;
-    tile->ground.int4 = 0;
-
-}
-
 static void random_start(int *originx, int *originy)
 {
     int x, y, xx, yy, flag, watchdog;
@@ -1363,7 +1319,7 @@ static void random_start(int *originx, int *originy)
             flag = 0;
             for (y = yy + 2; y < yy + 23; y++)
                 for (x = xx + 2; x < xx + 23; x++)
-                    if (world(x, y)->flags & FLAG_IS_RIVER)
+                    if (world(x, y)->flags() & FLAG_IS_RIVER)
                     {
                         flag = 1;
                         x = xx + 23;    /* break out of loop */
@@ -1375,7 +1331,7 @@ static void random_start(int *originx, int *originy)
                 /* Don't put the village on a river, but don't care of
                  * isolated random water tiles putted by setup_land
                  */
-                if (world(x, y)->flags & FLAG_IS_RIVER)
+                if (world(x, y)->flags() & FLAG_IS_RIVER)
                 {
                     flag = 0;
                     x = xx + 22;        /* break out of loop */
@@ -1397,25 +1353,25 @@ static void random_start(int *originx, int *originy)
         for (int j = 0; j < 4; j++)
             if (rand() > RAND_MAX/2)
             {
-                world(xx + 6 + i, yy + 5 + j)->flags |= FLAG_HAS_UNDERGROUND_WATER;
+                world(xx + 6 + i, yy + 5 + j)->addFlags(FLAG_HAS_UNDERGROUND_WATER);
             }
     organic_farmConstructionGroup.placeItem(xx + 6, yy + 5); //first Farm
     for (int i = 0; i < 4; i++)
         for (int j = 0; j < 4 ; j++)
             if (rand() > RAND_MAX/2)
             {
-                world(xx + 17 + i, yy + 5 + j)->flags |= FLAG_HAS_UNDERGROUND_WATER;
+                world(xx + 17 + i, yy + 5 + j)->addFlags(FLAG_HAS_UNDERGROUND_WATER);
             }
     organic_farmConstructionGroup.placeItem(xx + 17, yy + 5); //second Farm
     residenceMLConstructionGroup.placeItem(xx + 10, yy + 6);
-    dynamic_cast < Residence * > (world(xx + 10, yy + 6)->construction) ->local_population = 50;
+    dynamic_cast < Residence * > (world(xx + 10, yy + 6)->construction()) ->local_population = 50;
     potteryConstructionGroup.placeItem(xx + 9, yy + 9);
 
-    world(xx + 16, yy + 9 )->flags |= FLAG_HAS_UNDERGROUND_WATER;
+    world(xx + 16, yy + 9 )->addFlags(FLAG_HAS_UNDERGROUND_WATER);
     waterwellConstructionGroup.placeItem(xx + 16, yy + 9);
 
     residenceMLConstructionGroup.placeItem(xx + 14, yy + 6);
-    dynamic_cast < Residence * > (world(xx + 14, yy + 6)->construction) ->local_population = 50;
+    dynamic_cast < Residence * > (world(xx + 14, yy + 6)->construction()) ->local_population = 50;
 
     marketConstructionGroup.placeItem(xx + 14, yy + 9);
     /* build tracks */
@@ -1567,7 +1523,7 @@ static void do_rand_ecology(int x, int y, int r)
     }
     if (world(x, y)->getGroup() != GROUP_DESERT)
     {
-        world(x, y)->flags |= FLAG_HAS_UNDERGROUND_WATER;
+        world(x, y)->addFlags(FLAG_HAS_UNDERGROUND_WATER);
     }
 }
 
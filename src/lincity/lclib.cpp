@@ -23,7 +23,7 @@ const char *current_month(int current_time)
     if (doinit) {
         doinit = false;
         for (int i = 0; i < 12; ++i) {
-            months[i] = strdup(_(months[i]));
+            months[i] = strdup(translated(months[i]));
         }
     }
     return months[(current_time % NUMOF_DAYS_IN_YEAR) / NUMOF_DAYS_IN_MONTH];
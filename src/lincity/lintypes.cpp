@@ -25,6 +25,7 @@
 #include <iostream>
 #include "lincity-ng/Sound.hpp"
 #include "Vehicles.h"
+#include "Profiler.h"
 #include "lincity-ng/MainLincity.hpp"
 #include "lincity-ng/Config.hpp"
 
@@ -39,6 +40,7 @@ Ground::Ground()
     wastes = 0;
     pollution = 0;
     water_alt = 0;
+    water_pol = 0;
     water_wast = 0;
     water_next = 0;
     int1 = 0;
@@ -51,42 +53,17 @@ Ground::~Ground() {}
 
 //MapTile Declarations
 
-MapTile::MapTile():ground()
-{
-    construction = NULL;
-    reportingConstruction = NULL;
-    framesptr = NULL;
-    flags = 0;
-    type = 0;
-    group = 0;
-    pollution = 0;
-    ore_reserve = 0;
-    coal_reserve = 0;
-}
-
-MapTile::~MapTile()
-{
-    //Here the order matters
-    if(construction)
-    {   delete construction;}
-    if (framesptr)
-    {
-        framesptr->clear();
-        delete framesptr;
-    }
-}
-
 void MapTile::setTerrain(unsigned short new_group)
 {
-    this->type = 0;
-    this->group = new_group;
+    setType(0);
+    setGroup(new_group);
     if(new_group == GROUP_WATER)
-    {   flags |= FLAG_HAS_UNDERGROUND_WATER;}
+    {   addFlags(FLAG_HAS_UNDERGROUND_WATER);}
 }
 
 ConstructionGroup* MapTile::getTileConstructionGroup()
 {
-    switch (group)
+    switch (group())
     {
         case GROUP_BARE:    return &bareConstructionGroup;      break;
         case GROUP_DESERT:  return &desertConstructionGroup;    break;
@@ -95,7 +72,7 @@ ConstructionGroup* MapTile::getTileConstructionGroup()
         case GROUP_TREE2:   return &tree2ConstructionGroup;     break;
         case GROUP_TREE3:   return &tree3ConstructionGroup;     break;
         default:
-            std::cout << "invalid group of maptile at: (" << world.map_x(this) <<"," << world.map_y(this) << ")" << std::endl;
+            std::cout << "invalid group of maptile at: (" << world.map_x(*this) <<"," << world.map_y(*this) << ")" << std::endl;
             return &desertConstructionGroup;
     }
 }
@@ -122,7 +99,7 @@ ResourceGroup* MapTile::getTileResourceGroup()
         tree3 = ResourceGroup::resMap["Tree3"];
 
     }
-    switch (group)
+    switch (group())
     {
         case GROUP_BARE:    return bare;      break;
         case GROUP_DESERT:  return desert;    break;
@@ -131,41 +108,41 @@ ResourceGroup* MapTile::getTileResourceGroup()
         case GROUP_TREE2:   return tree2;     break;
         case GROUP_TREE3:   return tree3;     break;
         default:
-            std::cout << "invalid group of maptile at: (" << world.map_x(this) <<"," << world.map_y(this) << ")" << std::endl;
+            std::cout << "invalid group of maptile at: (" << world.map_x(*this) <<"," << world.map_y(*this) << ")" << std::endl;
             return desert;
     }
 }
 
 ConstructionGroup* MapTile::getConstructionGroup() //constructionGroup of bare land or the covering construction
-{   return (reportingConstruction ? reportingConstruction->constructionGroup : getTileConstructionGroup());}
+{   return (reportingConstruction() ? reportingConstruction()->constructionGroup : getTileConstructionGroup());}
 
 ConstructionGroup* MapTile::getTopConstructionGroup() //constructionGroup of bare land or the actual construction
-{   return (construction ? construction->constructionGroup : getTileConstructionGroup());}
+{   return (construction() ? construction()->constructionGroup : getTileConstructionGroup());}
 
 ConstructionGroup* MapTile::getLowerstVisibleConstructionGroup()
 {
-    if(!reportingConstruction || reportingConstruction->flags & FLAG_TRANSPARENT)
+    if(!reportingConstruction() || reportingConstruction()->flags & FLAG_TRANSPARENT)
     {   return getTileConstructionGroup();}
     else
     {   return getConstructionGroup();}
 }
 
 unsigned short MapTile::getType() //type of bare land or the covering construction
-{   return (reportingConstruction ? reportingConstruction->frameIt->frame : type);}
+{   return (reportingConstruction() ? reportingConstruction()->frameIt->frame : type());}
 
 unsigned short MapTile::getTopType() //type of bare land or the actual construction
-{   return (construction ? construction->frameIt->frame : type);}
+{   return (construction() ? construction()->frameIt->frame : type());}
 
 unsigned short MapTile::getLowerstVisibleType()
 {
-    if(!reportingConstruction || reportingConstruction->flags & FLAG_TRANSPARENT)
-    {   return type;}
+    if(!reportingConstruction() || reportingConstruction()->flags & FLAG_TRANSPARENT)
+    {   return type();}
     else
-    {   return reportingConstruction->frameIt->frame;}
+    {   return reportingConstruction()->frameIt->frame;}
 }
 
 unsigned short MapTile::getGroup() //group of bare land or the covering construction
-{   return (reportingConstruction ? reportingConstruction->constructionGroup->group : group);}
+{   return (reportingConstruction() ? reportingConstruction()->constructionGroup->group : group());}
 
 unsigned short MapTile::getTransportGroup() //group of bare land or the covering construction
 {
@@ -192,50 +169,50 @@ unsigned short MapTile::getTransportGroup() //group of bare land or the covering
 
 unsigned short MapTile::getTopGroup() //group of bare land or the actual construction
 {
-    if(!construction) //simple case
-    {   return group;}
-    else if(construction == reportingConstruction) //regular construction
-    {   return construction->constructionGroup->group;}
+    if(!construction()) //simple case
+    {   return group();}
+    else if(construction() == reportingConstruction()) //regular construction
+    {   return construction()->constructionGroup->group;}
     else // in case a construction has a chile e.g. waste burning on transport
-    {   return (reportingConstruction ? reportingConstruction->constructionGroup->group : group);}
+    {   return (reportingConstruction() ? reportingConstruction()->constructionGroup->group : group());}
 }
 
 unsigned short MapTile::getLowerstVisibleGroup()
 {
-    if(!reportingConstruction || reportingConstruction->flags & FLAG_TRANSPARENT)
-    {   return group;}
+    if(!reportingConstruction() || reportingConstruction()->flags & FLAG_TRANSPARENT)
+    {   return group();}
     else
-    {   return reportingConstruction->constructionGroup->group;}
+    {   return reportingConstruction()->constructionGroup->group;}
 }
 
 
 bool MapTile::is_bare() //true if we there is neither a covering construction nor water
-{   return (!reportingConstruction) && (group != GROUP_WATER);}
+{   return (!reportingConstruction()) && (group() != GROUP_WATER);}
 
 bool MapTile::is_water() //true on bridges or lakes (also under bridges)
-{   return (group == GROUP_WATER);}
+{   return (group() == GROUP_WATER);}
 
 bool MapTile::is_lake() //true on lakes (also under bridges)
-{   return (group == GROUP_WATER) && !(flags & FLAG_IS_RIVER);}
+{   return (group() == GROUP_WATER) && !(flags() & FLAG_IS_RIVER);}
 
 bool MapTile::is_river() // true on rivers (also under bridges)
-{   return (flags & FLAG_IS_RIVER);}
+{   return (flags() & FLAG_IS_RIVER);}
 
 bool MapTile::is_visible() // true if tile is not covered by another construction. Only useful for minimap Gameview is rotated to upperleft
-{   return (construction || !reportingConstruction);}
+{   return (construction() || !reportingConstruction());}
 
 bool MapTile::is_transport() //true on tracks, road, rails and bridges
-{   return (reportingConstruction && reportingConstruction->flags & FLAG_IS_TRANSPORT);}
+{   return (reportingConstruction() && reportingConstruction()->flags & FLAG_IS_TRANSPORT);}
 
 bool MapTile::is_residence() //true on residences
 {
-    return (reportingConstruction &&(
-        (reportingConstruction->constructionGroup->group == GROUP_RESIDENCE_LL)
-     || (reportingConstruction->constructionGroup->group == GROUP_RESIDENCE_ML)
-     || (reportingConstruction->constructionGroup->group == GROUP_RESIDENCE_HL)
-     || (reportingConstruction->constructionGroup->group == GROUP_RESIDENCE_LH)
-     || (reportingConstruction->constructionGroup->group == GROUP_RESIDENCE_MH)
-     || (reportingConstruction->constructionGroup->group == GROUP_RESIDENCE_HH) ) );
+    return (reportingConstruction() &&(
+        (reportingConstruction()->constructionGroup->group == GROUP_RESIDENCE_LL)
+     || (reportingConstruction()->constructionGroup->group == GROUP_RESIDENCE_ML)
+     || (reportingConstruction()->constructionGroup->group == GROUP_RESIDENCE_HL)
+     || (reportingConstruction()->constructionGroup->group == GROUP_RESIDENCE_LH)
+     || (reportingConstruction()->constructionGroup->group == GROUP_RESIDENCE_MH)
+     || (reportingConstruction()->constructionGroup->group == GROUP_RESIDENCE_HH) ) );
 }
 
 void MapTile::writeTemplate()
@@ -249,44 +226,44 @@ void MapTile::writeTemplate()
         if (!binary_mode)
         {
             xml_tmp->putTag("group");
-            xml_tmp->add_len(sizeof(group));
+            xml_tmp->add_len(sizeof(Terrain::group));
             xml_tmp->putTag("type");
-            xml_tmp->add_len(sizeof(type));
+            xml_tmp->add_len(sizeof(Terrain::type));
             xml_tmp->putTag("map_x");
             xml_tmp->add_len(sizeof(int));//has to match local var in saveMembers
             xml_tmp->putTag("map_y");
             xml_tmp->add_len(sizeof(int));//has to match local var in saveMembers
         }
         xml_tmp->putTag("flags");
-        xml_tmp->add_len(sizeof(flags));
+        xml_tmp->add_len(sizeof(int));//has to match flags
         xml_tmp->putTag("air_pol");
-        xml_tmp->add_len(sizeof(pollution));
+        xml_tmp->add_len(sizeof(int));//has to match pollution
         xml_tmp->putTag("ore");
-        xml_tmp->add_len(sizeof(ore_reserve));
+        xml_tmp->add_len(sizeof(Reserves::ore));
         xml_tmp->putTag("coal");
-        xml_tmp->add_len(sizeof(coal_reserve));
+        xml_tmp->add_len(sizeof(Reserves::coal));
         xml_tmp->putTag("altitude");
-        xml_tmp->add_len(sizeof(ground.altitude));
+        xml_tmp->add_len(sizeof(Ground::altitude));
         xml_tmp->putTag("ecotable");
-        xml_tmp->add_len(sizeof(ground.ecotable));
+        xml_tmp->add_len(sizeof(Ground::ecotable));
         xml_tmp->putTag("wastes");
-        xml_tmp->add_len(sizeof(ground.wastes));
+        xml_tmp->add_len(sizeof(Ground::wastes));
         xml_tmp->putTag("grd_pol");
-        xml_tmp->add_len(sizeof(ground.pollution));
+        xml_tmp->add_len(sizeof(Ground::pollution));
         xml_tmp->putTag("water_alt");
-        xml_tmp->add_len(sizeof(ground.water_alt));
+        xml_tmp->add_len(sizeof(Ground::water_alt));
         xml_tmp->putTag("water_pol");
-        xml_tmp->add_len(sizeof(ground.water_pol));
+        xml_tmp->add_len(sizeof(Ground::water_pol));
         xml_tmp->putTag("water_next");
-        xml_tmp->add_len(sizeof(ground.water_next));
+        xml_tmp->add_len(sizeof(Ground::water_next));
         xml_tmp->putTag("int1");
-        xml_tmp->add_len(sizeof(ground.int1));
+        xml_tmp->add_len(sizeof(Ground::int1));
         xml_tmp->putTag("int2");
-        xml_tmp->add_len(sizeof(ground.int2));
+        xml_tmp->add_len(sizeof(Ground::int2));
         xml_tmp->putTag("int3");
-        xml_tmp->add_len(sizeof(ground.int3));
+        xml_tmp->add_len(sizeof(Ground::int3));
         xml_tmp->putTag("int4");
-        xml_tmp->add_len(sizeof(ground.int4));
+        xml_tmp->add_len(sizeof(Ground::int4));
         if (binary_mode)
         {   xml_tmp->set_group(GROUP_DESERT);}
     }
@@ -295,9 +272,16 @@ void MapTile::writeTemplate()
 
 void MapTile::saveMembers(std::ostream *os)
 {
-    type = type % getTileResourceGroup()->graphicsInfoVector.size();
-    int x = world.map_x(this);
-    int y = world.map_y(this);
+    setType(type() % getTileResourceGroup()->graphicsInfoVector.size());
+    unsigned short type = this->type();
+    unsigned short group = this->group();
+    int flags = this->flags();
+    int pollution = this->pollution();
+    unsigned short ore_reserve = this->ore_reserve();
+    unsigned short coal_reserve = this->coal_reserve();
+    int x = world.map_x(*this);
+    int y = world.map_y(*this);
+    const Ground& grd = ground();
     unsigned short head = GROUP_DESERT;
     size_t cm = 0;
     std::string xml_tag;
@@ -335,18 +319,18 @@ void MapTile::saveMembers(std::ostream *os)
             else if (xml_tag == "ore")               {*os << ore_reserve;}
             else if (xml_tag == "coal")              {*os << coal_reserve;}
             //ground
-            else if (xml_tag == "altitude")          {*os << ground.altitude;}
-            else if (xml_tag == "ecotable")          {*os << ground.ecotable;}
-            else if (xml_tag == "wastes")            {*os << ground.wastes;}
-            else if (xml_tag == "grd_pol")           {*os << ground.pollution;}
-            else if (xml_tag == "water_alt")         {*os << ground.water_alt;}
-            else if (xml_tag == "water_pol")         {*os << ground.water_pol;}
-            else if (xml_tag == "water_wast")        {*os << ground.water_wast;}
-            else if (xml_tag == "water_next")        {*os << ground.water_next;}
-            else if (xml_tag == "int1")              {*os << ground.int1;}
-            else if (xml_tag == "int2")              {*os << ground.int2;}
-            else if (xml_tag == "int3")              {*os << ground.int3;}
-            else if (xml_tag == "int4")              {*os << ground.int4;}
+            else if (xml_tag == "altitude")          {*os << grd.altitude;}
+            else if (xml_tag == "ecotable")          {*os << grd.ecotable;}
+            else if (xml_tag == "wastes")            {*os << grd.wastes;}
+            else if (xml_tag == "grd_pol")           {*os << grd.pollution;}
+            else if (xml_tag == "water_alt")         {*os << grd.water_alt;}
+            else if (xml_tag == "water_pol")         {*os << grd.water_pol;}
+            else if (xml_tag == "water_wast")        {*os << grd.water_wast;}
+            else if (xml_tag == "water_next")        {*os << grd.water_next;}
+            else if (xml_tag == "int1")              {*os << grd.int1;}
+            else if (xml_tag == "int2")              {*os << grd.int2;}
+            else if (xml_tag == "int3")              {*os << grd.int3;}
+            else if (xml_tag == "int4")              {*os << grd.int4;}
             else
             {
                 std::cout<<"Unknown Template entry "<< xml_tag << " while exporting <MapTile>"<<std::endl;
@@ -376,18 +360,18 @@ void MapTile::saveMembers(std::ostream *os)
             else if (xml_tag == "ore")               {os->write( (char*)&ore_reserve,sizeof(ore_reserve));cm+=sizeof(ore_reserve);}
             else if (xml_tag == "coal")              {os->write( (char*)&coal_reserve,sizeof(coal_reserve));cm+=sizeof(coal_reserve);}
             //ground
-            else if (xml_tag == "altitude")          {os->write( (char*)&ground.altitude,sizeof(ground.altitude));cm+=sizeof(ground.altitude);}
-            else if (xml_tag == "ecotable")          {os->write( (char*)&ground.ecotable,sizeof(ground.ecotable));cm+=sizeof(ground.ecotable);}
-            else if (xml_tag == "wastes")            {os->write( (char*)&ground.wastes,sizeof(ground.wastes));cm+=sizeof(ground.wastes);}
-            else if (xml_tag == "grd_pol")           {os->write( (char*)&ground.pollution,sizeof(ground.pollution));cm+=sizeof(ground.pollution);}
-            else if (xml_tag == "water_alt")         {os->write( (char*)&ground.water_alt,sizeof(ground.water_alt));cm+=sizeof(ground.water_alt);}
-            else if (xml_tag == "water_pol")         {os->write( (char*)&ground.water_pol,sizeof(ground.water_pol));cm+=sizeof(ground.water_pol);}
-            else if (xml_tag == "water_wast")        {os->write( (char*)&ground.water_wast,sizeof(ground.water_wast));cm+=sizeof(ground.water_wast);}
-            else if (xml_tag == "water_next")        {os->write( (char*)&ground.water_next,sizeof(ground.water_next));cm+=sizeof(ground.water_next);}
-            else if (xml_tag == "int1")              {os->write( (char*)&ground.int1,sizeof(ground.int1));cm+=sizeof(ground.int1);}
-            else if (xml_tag == "int2")              {os->write( (char*)&ground.int2,sizeof(ground.int2));cm+=sizeof(ground.int2);}
-            else if (xml_tag == "int3")              {os->write( (char*)&ground.int3,sizeof(ground.int3));cm+=sizeof(ground.int3);}
-            else if (xml_tag == "int4")              {os->write( (char*)&ground.int4,sizeof(ground.int4));cm+=sizeof(ground.int4);}
+            else if (xml_tag == "altitude")          {os->write( (char*)&grd.altitude,sizeof(Ground::altitude));cm+=sizeof(Ground::altitude);}
+            else if (xml_tag == "ecotable")          {os->write( (char*)&grd.ecotable,sizeof(Ground::ecotable));cm+=sizeof(Ground::ecotable);}
+            else if (xml_tag == "wastes")            {os->write( (char*)&grd.wastes,sizeof(Ground::wastes));cm+=sizeof(Ground::wastes);}
+            else if (xml_tag == "grd_pol")           {os->write( (char*)&grd.pollution,sizeof(Ground::pollution));cm+=sizeof(Ground::pollution);}
+            else if (xml_tag == "water_alt")         {os->write( (char*)&grd.water_alt,sizeof(Ground::water_alt));cm+=sizeof(Ground::water_alt);}
+            else if (xml_tag == "water_pol")         {os->write( (char*)&grd.water_pol,sizeof(Ground::water_pol));cm+=sizeof(Ground::water_pol);}
+            else if (xml_tag == "water_wast")        {os->write( (char*)&grd.water_wast,sizeof(Ground::water_wast));cm+=sizeof(Ground::water_wast);}
+            else if (xml_tag == "water_next")        {os->write( (char*)&grd.water_next,sizeof(Ground::water_next));cm+=sizeof(Ground::water_next);}
+            else if (xml_tag == "int1")              {os->write( (char*)&grd.int1,sizeof(Ground::int1));cm+=sizeof(Ground::int1);}
+            else if (xml_tag == "int2")              {os->write( (char*)&grd.int2,sizeof(Ground::int2));cm+=sizeof(Ground::int2);}
+            else if (xml_tag == "int3")              {os->write( (char*)&grd.int3,sizeof(Ground::int3));cm+=sizeof(Ground::int3);}
+            else if (xml_tag == "int4")              {os->write( (char*)&grd.int4,sizeof(Ground::int4));cm+=sizeof(Ground::int4);}
             else
             {
                 std::cout<<"Unknown Template entry "<< xml_tag << " while exporting <MapTile>"<<std::endl;
@@ -398,19 +382,21 @@ void MapTile::saveMembers(std::ostream *os)
     }
 }
 
-std::list<ExtraFrame>::iterator MapTile::createframe(void)
+ExtraFrameList::iterator MapTile::createframe(void)
 {
+    ExtraFrameList *&framesptr = world.framelayer.poke(index);
     if(!framesptr)
-    {   framesptr = new std::list<ExtraFrame>;}
+    {   framesptr = new ExtraFrameList;}
     framesptr->resize(framesptr->size() + 1);
-    std::list<ExtraFrame>::iterator frit = framesptr->end();
+    ExtraFrameList::iterator frit = framesptr->end();
     std::advance(frit, -1);
     return frit; //the last position
 }
 
-void MapTile::killframe(std::list<ExtraFrame>::iterator it)
+void MapTile::killframe(ExtraFrameList::iterator it)
 {
     //what would actually happen if "it" belongs to another maptile?
+    ExtraFrameList *&framesptr = world.framelayer.poke(index);
     framesptr->erase(it);
     if (framesptr->empty())
     {
@@ -419,6 +405,25 @@ void MapTile::killframe(std::list<ExtraFrame>::iterator it)
     }
 }
 
+void MapTile::takeframe(MapTile from, ExtraFrameList::iterator it)
+{
+    ExtraFrameList *&framesptr = world.framelayer.poke(index);
+    if(!framesptr)
+    {   framesptr = new ExtraFrameList;}
+    framesptr->splice(framesptr->end(), *from.framesptr(), it);
+    if (from.framesptr()->empty())
+    {   from.clearframes();}
+}
+
+void MapTile::clearframes()
+{
+    if (framesptr())
+    {
+        delete framesptr();
+        world.framelayer.poke(index) = NULL;
+    }
+}
+
 
 //Construction Declarations
 
@@ -514,7 +519,6 @@ void Construction::initialize_commodities(void)
     for(stuff_it = constructionGroup->commodityRuleCount.begin() ; stuff_it != constructionGroup->commodityRuleCount.end() ; stuff_it++)
     {
         commodityCount[stuff_it->first] = 0;
-        setMemberSaved(&commodityCount[stuff_it->first], commodityNames[stuff_it->first]);
     }
 }
 
@@ -558,40 +562,65 @@ void Construction::report_commodities(void)
 
 }
 
-void Construction::setCommodityRulesSaved(std::map<Commodities,CommodityRule> * stuffRuleCount)
+const double Construction::missingMember = 0;
+bool Construction::denseViews = true;
+bool Construction::sleeping = false;
+
+const std::map<std::string, MemberRule> &Construction::memberRules()
 {
-    std::map<Commodities,CommodityRule>::iterator stuff_it;
-    std::string giveStr = "give_";
-    std::string takeStr = "take_";
-    for( stuff_it = stuffRuleCount->begin() ; stuff_it != stuffRuleCount->end() ; stuff_it++)
+    std::map<std::string, MemberRule> &rules = constructionGroup->memberRuleCount;
+    if (rules.empty())
+    {   describeMembers(rules);}
+    return rules;
+}
+
+void Construction::describeMembers(std::map<std::string, MemberRule> &rules)
+{
+    MEMBER_SAVED(rules, Construction, flags);
+    std::map<Commodities, int>::iterator stuff_it;
+    for(stuff_it = commodityCount.begin() ; stuff_it != commodityCount.end() ; stuff_it++)
     {
-        setMemberSaved(&(stuff_it->second.give), giveStr + commodityNames[stuff_it->first]);
-        setMemberSaved(&(stuff_it->second.take), takeStr + commodityNames[stuff_it->first]);
+        MemberRule &rule = rules[commodityNames[stuff_it->first]];
+        rule.memberType = TYPE_INT;
+        rule.locate = &locateCommodity;
+        rule.arg = stuff_it->first;
     }
 }
 
+void *Construction::locateCommodity(Construction *cst, int stuff)
+{
+    //the rules of a group only name commodities its constructions have
+    std::map<Commodities, int>::iterator stuff_it = cst->commodityCount.find(static_cast<Commodities>(stuff));
+    return (stuff_it != cst->commodityCount.end()) ? &stuff_it->second : NULL;
+}
+
 int Construction::loadMember(std::string const &xml_tag, std::string const &xml_val)
 {
-    std::istringstream iss;
-    iss.str(xml_val);
-    if(memberRuleCount.count(xml_tag))
+    const std::map<std::string, MemberRule> &rules = memberRules();
+    std::map<std::string, MemberRule>::const_iterator member_it = rules.find(xml_tag);
+    if (member_it != rules.end())
     {
-        switch (memberRuleCount[xml_tag].memberType)
+        void *ptr = member_it->second.ptr(this);
+        if (!ptr)
+        {   return 0;}
+        std::istringstream iss;
+        iss.str(xml_val);
+        switch (member_it->second.memberType)
         {
             case TYPE_BOOL:
-                iss>>*static_cast<bool *>(memberRuleCount[xml_tag].ptr);
+                iss>>*static_cast<bool *>(ptr);
                 break;
             case TYPE_INT:
-                iss>>*static_cast<int *>(memberRuleCount[xml_tag].ptr);
+                iss>>*static_cast<int *>(ptr);
                 break;
             case TYPE_USHORT:
-                iss>>*static_cast<unsigned short *>(memberRuleCount[xml_tag].ptr);
+                iss>>*static_cast<unsigned short *>(ptr);
                 break;
              case TYPE_DOUBLE:
-                iss>>*static_cast<double *>(memberRuleCount[xml_tag].ptr);
+                iss>>*static_cast<double *>(ptr);
                 break;
             case TYPE_FLOAT:
-                iss>>*static_cast<float *>(memberRuleCount[xml_tag].ptr);
+                iss>>*static_cast<float *>(ptr);
                 break;
         }
         return 1;
@@ -603,12 +632,14 @@ int Construction::loadMember(std::string const &xml_tag, std::string const &xml_
     }
 }
 
-int Construction::readbinaryMember(std::string const &xml_tag, gzFile fp)
+int Construction::readbinaryMember(std::string const &xml_tag, size_t len, XMLloadsave &in)
 {
     size_t s_t = 0;
-//    if(memberRuleCount.count(xml_tag))
-//    {
-        switch (memberRuleCount[xml_tag].memberType)
+    const std::map<std::string, MemberRule> &rules = memberRules();
+    std::map<std::string, MemberRule>::const_iterator member_it = rules.find(xml_tag);
+    if (member_it != rules.end())
+    {
+        switch (member_it->second.memberType)
         {
             case TYPE_BOOL:
                 s_t = sizeof(bool);
@@ -626,15 +657,18 @@ int Construction::readbinaryMember(std::string const &xml_tag, gzFile fp)
                  s_t = sizeof(float);
                 break;
         }
-        gzread(fp,(char*)(memberRuleCount[xml_tag].ptr),s_t);
+        void *ptr = member_it->second.ptr(this);
+        if (!ptr)
+        {   return in.skip(len);}
+        in.read(ptr, s_t);
         return s_t;
-/*    }
+    }
     else
     {
-        assert(false);
-        return 0;
+        //len bytes were written for it, skip them to stay aligned
+        std::cout << "unknown member " << xml_tag << " in " << constructionGroup->name << std::endl;
+        return in.skip(len);
     }
-*/
 }
 
 void Construction::writeTemplate()
@@ -659,10 +693,10 @@ void Construction::writeTemplate()
             xml_tmp->putTag("map_x");
             xml_tmp->putTag("map_y");
         }
-        std::map<std::string, MemberRule>::iterator member_it;
-        for(member_it = memberRuleCount.begin() ; member_it != memberRuleCount.end() ; member_it++)
+        const std::map<std::string, MemberRule> &rules = memberRules();
+        std::map<std::string, MemberRule>::const_iterator member_it;
+        for(member_it = rules.begin() ; member_it != rules.end() ; member_it++)
         {
-            xml_tmp->putTag(member_it->first);
             size_t s_t = 4;
             switch (member_it->second.memberType)
             {
@@ -682,7 +716,7 @@ void Construction::writeTemplate()
                     s_t = sizeof(float);
                     break;
             }
-            xml_tmp->add_len(s_t);
+            xml_tmp->putTag(member_it->first, s_t);
         }
         xml_tmp->rewind();
         if (binary_mode)
@@ -716,7 +750,8 @@ void Construction::saveMembers(std::ostream *os)
     }
     xml_tmp->rewind();
     size_t checksum = 0;
-    std::map<std::string, MemberRule>::iterator member_it;
+    const std::map<std::string, MemberRule> &rules = memberRules();
+    std::map<std::string, MemberRule>::const_iterator member_it;
     if (binary_mode)
     {   //Mandatory header for binary files (before actual template)
         int idx = x + y * world.len();
@@ -741,28 +776,32 @@ void Construction::saveMembers(std::ostream *os)
     }
     while (!xml_tmp->reached_end())
     {
-        member_it = memberRuleCount.find(xml_tmp->getTag());
-        if (member_it != memberRuleCount.end())
+        member_it = rules.find(xml_tmp->getTag());
+        if (member_it != rules.end())
         {
+            void *ptr = member_it->second.ptr(this);
+            //a member this construction lacks is saved as 0
+            if (!ptr)
+            {   ptr = (void *)&missingMember;}
 
             if (!binary_mode)
             {
                 switch (member_it->second.memberType)
                 {
                     case TYPE_BOOL:
-                        *os << *static_cast<bool *>(member_it->second.ptr);
+                        *os << *static_cast<bool *>(ptr);
                         break;
                     case TYPE_INT:
-                        *os << *static_cast<int *>(member_it->second.ptr);
+                        *os << *static_cast<int *>(ptr);
                         break;
                     case TYPE_USHORT:
-                        *os << *static_cast<unsigned short *>(member_it->second.ptr);
+                        *os << *static_cast<unsigned short *>(ptr);
                         break;
                     case TYPE_DOUBLE:
-                        *os << *static_cast<double *>(member_it->second.ptr);
+                        *os << *static_cast<double *>(ptr);
                         break;
                     case TYPE_FLOAT:
-                        *os << *static_cast<float *>(member_it->second.ptr);
+                        *os << *static_cast<float *>(ptr);
                         break;
                 }
                 *os << '\t';
@@ -788,7 +827,7 @@ void Construction::saveMembers(std::ostream *os)
                         s_t = sizeof(float);
                         break;
                 }
-                os->write( (char*) member_it->second.ptr,s_t);
+                os->write( (char*) ptr,s_t);
                 checksum += s_t;
             }
         }
@@ -813,9 +852,9 @@ void Construction::detach()
 {
     //std::cout << "detaching: " << constructionGroup->name << std::endl;
     ::constructionCount.remove_construction(this);
-    if(world(x,y)->construction == this)
+    if(world(x,y)->construction() == this)
     {
-        world(x,y)->construction = NULL;
+        world(x,y)->setConstruction(NULL);
         world(x,y)->killframe(frameIt);
 /*
         world(x,y)->framesptr->erase(frameIt);
@@ -831,9 +870,9 @@ void Construction::detach()
     {
         for (unsigned short j = 0; j < constructionGroup->size; ++j)
         {
-            world(x + j, y + i)->flags &= (~FLAG_INVISIBLE);
+            world(x + j, y + i)->clearFlags(FLAG_INVISIBLE);
             // constructions may have children e.g. waste burning markets/shanties
-            Construction* child = world(x+j,y+i)->construction;
+            Construction* child = world(x+j,y+i)->construction();
             if(child)
             {
                 //std::cout << "killing child: " << world(x+j,y+i)->construction->constructionGroup->name << std::endl;
@@ -841,9 +880,9 @@ void Construction::detach()
                 world(x+j,y+i)->killframe(child->frameIt);
                 delete child;
                 child = NULL;
-                world(x+j,y+i)->construction = NULL;
+                world(x+j,y+i)->setConstruction(NULL);
             }
-            world(x+j,y+i)->reportingConstruction = NULL;
+            world(x+j,y+i)->setReportingConstruction(NULL);
         }
     }
     deneighborize();
@@ -851,8 +890,10 @@ void Construction::detach()
 
 void Construction::deneighborize()
 {
+    //the former neighbors and partners trade differently from now on
     for(size_t i = 0; i < neighbors.size(); ++i)
     {
+        neighbors[i]->wake();
         std::vector<Construction*> *neib = &(neighbors[i]->neighbors);
         std::vector<Construction*>::iterator neib_it = neib->begin();
         while(neib_it != neib->end() && *neib_it != this)
@@ -865,6 +906,7 @@ void Construction::deneighborize()
     neighbors.clear();
     for(size_t i = 0; i < partners.size(); ++i)
     {
+        partners[i]->wake();
         std::vector<Construction*> *partner = &(partners[i]->partners);
         std::vector<Construction*>::iterator partner_it = partner->begin();
         while(partner_it != partner->end() && *partner_it != this)
@@ -875,12 +917,13 @@ void Construction::deneighborize()
         partner->erase(partner_it);
     }
     partners.clear();
+    ::tradeGraph.invalidate();
     if (constructionGroup->group == GROUP_POWER_LINE)
     {
-        world(x + 1, y)->flags &= ~FLAG_POWER_CABLES_90;
-        world(x - 1, y)->flags &= ~FLAG_POWER_CABLES_90;
-        world(x, y + 1)->flags &= ~FLAG_POWER_CABLES_0;
-        world(x, y - 1)->flags &= ~FLAG_POWER_CABLES_0;
+        world(x + 1, y)->clearFlags(FLAG_POWER_CABLES_90);
+        world(x - 1, y)->clearFlags(FLAG_POWER_CABLES_90);
+        world(x, y + 1)->clearFlags(FLAG_POWER_CABLES_0);
+        world(x, y - 1)->clearFlags(FLAG_POWER_CABLES_0);
     }
 }
 
@@ -903,22 +946,22 @@ void Construction::neighborize()
             for (unsigned short edge = 0; edge < size; ++edge)
             {
                 //here we rely on invisible edge tiles
-                cst = world(x - 1,y + edge)->reportingConstruction;
+                cst = world(x - 1,y + edge)->reportingConstruction();
                 if(cst && cst != cst1 && !(cst->flags & (FLAG_IS_GHOST))
                     && (cst->constructionGroup->group != GROUP_FIRE)
                     && (cst->constructionGroup->group != GROUP_POWER_LINE)  )
                 {   link_to(cst1 = cst);}
-                cst = world(x + edge,y - 1)->reportingConstruction;
+                cst = world(x + edge,y - 1)->reportingConstruction();
                 if(cst && cst != cst2 && !(cst->flags & (FLAG_IS_GHOST))
                     && (cst->constructionGroup->group != GROUP_FIRE)
                     && (cst->constructionGroup->group != GROUP_POWER_LINE)  )
                 {   link_to(cst2 = cst);}
-                cst = world(x + size,y + edge)->reportingConstruction;
+                cst = world(x + size,y + edge)->reportingConstruction();
                 if(cst && cst != cst3 && !(cst->flags & (FLAG_IS_GHOST))
                     && (cst->constructionGroup->group != GROUP_FIRE)
                     && (cst->constructionGroup->group != GROUP_POWER_LINE)  )
                 {   link_to(cst3 = cst);}
-                cst = world(x + edge,y + size)->reportingConstruction;
+                cst = world(x + edge,y + size)->reportingConstruction();
                 if(cst && cst != cst4 && !(cst->flags & (FLAG_IS_GHOST))
                     && (cst->constructionGroup->group != GROUP_FIRE)
                     && (cst->constructionGroup->group != GROUP_POWER_LINE)  )
@@ -945,9 +988,10 @@ void Construction::neighborize()
                     //dont search at home
                     if(((xx == x )  && (yy == y)))
                     {   continue;}
-                    if(world(xx,yy)->construction) //be unique
+                    //be unique, constructions still waiting to be placed while loading have no reportingConstruction
+                    if(world(xx,yy)->construction() && world(xx,yy)->reportingConstruction())
                     {
-                        Construction *cst = world(xx,yy)->reportingConstruction; //stick with reporting
+                        Construction *cst = world(xx,yy)->reportingConstruction(); //stick with reporting
                         if((cst->constructionGroup->group == GROUP_FIRE)
                         || (cst->constructionGroup->group == GROUP_POWER_LINE)  )
                         {   continue;}
@@ -1020,6 +1064,9 @@ void Construction::link_to(Construction* other)
         {
             neighbors.push_back(other);
             other->neighbors.push_back(this);
+            ::tradeGraph.invalidate();
+            wake();
+            other->wake();
             //std::cout << "power link : " << constructionGroup->name << "(" << x << "," << y << ") - "
             //<< other->constructionGroup->name << "(" << other->x << "," << other->y << ")" << std::endl;
             return;
@@ -1034,6 +1081,9 @@ void Construction::link_to(Construction* other)
         {
             neighbors.push_back(other);
             other->neighbors.push_back(this);
+            ::tradeGraph.invalidate();
+            wake();
+            other->wake();
             //std::cout << "neighbor : " << constructionGroup->name << "(" << x << "," << y << ") - "
             //<< other->constructionGroup->name << "(" << other->x << "," << other->y << ")" << std::endl;
         }
@@ -1044,6 +1094,9 @@ void Construction::link_to(Construction* other)
             {
                 partners.push_back(other);
                 other->partners.push_back(this);
+                ::tradeGraph.invalidate();
+                wake();
+                other->wake();
                 //std::cout << "partner : " << constructionGroup->name << "(" << x << "," << y << ") - "
                 //<< other->constructionGroup->name << "(" << other->x << "," << other->y << ")" << std::endl;
             }
@@ -1073,19 +1126,19 @@ int Construction::countPowercables(int mask)
     for(unsigned short i = 0; i < size; ++i)
     {
         if( (mask & 8) &&
-            world(x + i, y - 1)->flags & FLAG_POWER_CABLES_0 )
+            world(x + i, y - 1)->flags() & FLAG_POWER_CABLES_0 )
         {++count;}
 
         if( (mask & 4) &&
-            world(x - 1, y + i)->flags & FLAG_POWER_CABLES_90 )
+            world(x - 1, y + i)->flags() & FLAG_POWER_CABLES_90 )
         {   ++count;}
 
         if( (mask & 2)
-            && world(x + size, y + i)->flags & FLAG_POWER_CABLES_90 )
+            && world(x + size, y + i)->flags() & FLAG_POWER_CABLES_90 )
         {   ++count;}
 
         if( (mask & 1) &&
-            world(x + i, y + size)->flags & FLAG_POWER_CABLES_0 )
+            world(x + i, y + size)->flags() & FLAG_POWER_CABLES_0 )
         {   ++count;}
 
     } //end for size
@@ -1141,26 +1194,53 @@ int Construction::tellstuff(Commodities stuff_ID, int center_ratio) //called by
     return -1;
 }
 
+size_t Construction::containerMemory()
+{
+    //a tree node carries three links and the color next to its value
+    size_t node = 4 * sizeof(void *) + sizeof(std::pair<const Commodities, int>);
+    return commodityCount.size() * node
+        + (neighbors.capacity() + partners.capacity()) * sizeof(Construction *);
+}
+
 void Construction::trade()
 {
+    PROFILE_ZONE("Construction::trade");
     int ratio, cap, lvl, center_lvl, center_cap;
     int traffic, max_traffic;
     Commodities stuff_ID;
-    const size_t neighsize = neighbors.size();
+    size_t neighsize;
+    Construction **neibs = ::tradeGraph.neighbors(this, &neighsize);
     bool lvls[neighsize];
-    std::map<Commodities, int>::iterator stuff_it;
     Transport *transport = NULL;
     Powerline *powerline = NULL;
+    bool moved = false; //some commodity was exchanged
+    bool busy = false;  //something else still changes from day to day
+    //the flag and the group already tell the class
     if(flags & FLAG_IS_TRANSPORT)
-    {   transport = dynamic_cast<Transport*>(this);}
+    {   transport = static_cast<Transport*>(this);}
     else if(constructionGroup->group == GROUP_POWER_LINE)
-    {   powerline = dynamic_cast<Powerline*>(this);}
+    {   powerline = static_cast<Powerline*>(this);}
+    //levels and rules are read from the dense views, no map lookups below
+    cacheStuff();
+    ConstructionGroup *cstGroup = constructionGroup;
+    cstGroup->cacheRules();
+    for(unsigned int i = 0; i < neighsize; ++i)
+    {
+        neibs[i]->cacheStuff();
+        neibs[i]->constructionGroup->cacheRules();
+    }
     /*begin for over all different stuff*/
-    for(stuff_it = commodityCount.begin() ; stuff_it != commodityCount.end() ; stuff_it++ )
+    for(int stuff = 0; stuff < STUFF_COUNT; ++stuff)
     {
-        stuff_ID = stuff_it->first;
-        center_lvl = stuff_it->second;
-        center_cap = constructionGroup->commodityRuleCount[stuff_ID].maxload;
+        unsigned int bit = 1 << stuff;
+        if(!(stuffMask & bit))
+        {   continue;}
+        stuff_ID = static_cast<Commodities>(stuff);
+        center_lvl = *stuffLevel[stuff];
+        center_cap = cstGroup->maxload[stuff];
+        //in grid mode PowerGrid::balance() moves MWH, cables still animate below
+        bool grid = (stuff_ID == STUFF_MWH) && ::powerGrid.enabled;
+        unsigned int pears = grid ? 0 : neighsize;
         if(flags & FLAG_EVACUATE)
         {
             if(center_lvl > 0)
@@ -1172,22 +1252,21 @@ void Construction::trade()
         ratio = (center_lvl * TRANSPORT_QUANTA / (center_cap) );
         lvl = center_lvl;
         cap = center_cap;
-        for(unsigned int i = 0; i < neighsize; ++i)
+        for(unsigned int i = 0; i < pears; ++i)
         {
-            Construction *pear = neighbors[i];
+            Construction *pear = neibs[i];
             lvls[i] = false;
-            if(pear->commodityCount.count(stuff_ID))
+            if(pear->stuffMask & bit)
             {
-                int lvlsi = pear->commodityCount[stuff_ID];
-                int capsi = pear->constructionGroup->commodityRuleCount[stuff_ID].maxload;
+                ConstructionGroup *pearGroup = pear->constructionGroup;
+                int lvlsi = *pear->stuffLevel[stuff];
+                int capsi = pearGroup->maxload[stuff];
                 if(!(pear->flags & FLAG_EVACUATE))
                 {
                     int pearat = lvlsi * TRANSPORT_QUANTA / capsi;
                     //only consider stuff that would tentatively move
-                    if(((pearat > ratio)&&!(constructionGroup->commodityRuleCount[stuff_ID].take &&
-                            pear->constructionGroup->commodityRuleCount[stuff_ID].give)) ||
-                       ((pearat < ratio)&&!(constructionGroup->commodityRuleCount[stuff_ID].give &&
-                            pear->constructionGroup->commodityRuleCount[stuff_ID].take)))
+                    if(((pearat > ratio) && !(cstGroup->takeMask & pearGroup->giveMask & bit)) ||
+                       ((pearat < ratio) && !(cstGroup->giveMask & pearGroup->takeMask & bit)))
                     {   continue;}
                     lvl += lvlsi;
                     cap += capsi;
@@ -1199,13 +1278,16 @@ void Construction::trade()
         max_traffic = 0;
         int old_center = center_lvl;
         //make flow towards ratio
-        for(unsigned int i = 0; i < neighsize; ++i)
+        for(unsigned int i = 0; i < pears; ++i)
         {
             if(lvls[i])
             {
-                traffic = neighbors[i]->equilibrate_stuff(&center_lvl, center_cap, ratio, stuff_ID, constructionGroup);
+                int before = center_lvl;
+                traffic = neibs[i]->equilibrate_stuff(&center_lvl, center_cap, ratio, stuff_ID, cstGroup);
                 if( traffic > max_traffic )
                 {   max_traffic = traffic;}
+                if (center_lvl != before)
+                {   moved = true;}
             }
         }
         int flow = center_lvl - old_center;
@@ -1214,6 +1296,9 @@ void Construction::trade()
         if(transport) //Special for transport
         {
             transport->trafficCount[stuff_ID] = (9 * transport->trafficCount[stuff_ID] + max_traffic) / 10;
+            //stay awake until the smoothed traffic has died down
+            if (transport->trafficCount[stuff_ID])
+            {   busy = true;}
             if(lincitySpeed != fast_time_for_year
             && getConfig()->carsEnabled
             && 100 * max_traffic *  TRANSPORT_RATE / TRANSPORT_QUANTA > 2
@@ -1226,8 +1311,8 @@ void Construction::trade()
                 {
                     case STUFF_JOBS :
                         if((rand()%COMMUTER_TRAFFIC_RATE) < (yield+1)/2
-                        && world(x,y)->framesptr //useful check in case the road is bulldozed
-                        &&  world(x,y)->framesptr->size() < 2) //only generate cars on emtpy streets
+                        && world(x,y)->framesptr() //useful check in case the road is bulldozed
+                        &&  world(x,y)->framesptr()->size() < 2) //only generate cars on emtpy streets
                         {   new Vehicle(x, y, VEHICLE_BLUECAR,
                                         (flow > 0)? VEHICLE_STRATEGY_MAXIMIZE : VEHICLE_STRATEGY_MINIMIZE);}
                         break;
@@ -1238,39 +1323,91 @@ void Construction::trade()
         }
         else if(powerline) //Special for powerlines
         {
-            powerline->trafficCount[stuff_ID] = (9 * powerline->trafficCount[stuff_ID] + max_traffic) / 10;
+            if(!grid)
+            {   powerline->trafficCount[stuff_ID] = (9 * powerline->trafficCount[stuff_ID] + max_traffic) / 10;}
+            //powerlines animate from the levels of their neighbors
+            busy = true;
             for(unsigned int i = 0; i < neighsize; ++i)
             {
                 if((powerline->anim_counter == 0)
-                && !(neighbors[i]->constructionGroup->group == GROUP_POWER_LINE)
-                && neighbors[i]->constructionGroup->commodityRuleCount[stuff_ID].give
-                && (neighbors[i]->commodityCount[stuff_ID] > 0))
+                && !(neibs[i]->constructionGroup->group == GROUP_POWER_LINE)
+                && (neibs[i]->constructionGroup->giveMask & bit)
+                && (neibs[i]->stuffMask & bit) && (*neibs[i]->stuffLevel[stuff] > 0))
                 {   powerline->anim_counter = POWER_MODULUS + rand()%POWER_MODULUS;}
-                if((powerline->flashing && (neighbors[i]->constructionGroup->group == GROUP_POWER_LINE)))
-                {   ConstructionManager::submitRequest(new PowerLineFlashRequest(neighbors[i]));}
+                if((powerline->flashing && (neibs[i]->constructionGroup->group == GROUP_POWER_LINE)))
+                {   ConstructionManager::submitRequest(new PowerLineFlashRequest(neibs[i]));}
             }
         }
 
-        stuff_it->second += flow; //update center_lvl
+        *stuffLevel[stuff] += flow; //update center_lvl
     } //endfor all different STUFF
+    if (moved)
+    {
+        lastChange = total_time;
+        asleepSince = -1;
+    }
+    else if (!busy)
+    {   asleepSince = total_time;}
+}
+
+bool Construction::asleep()
+{
+    if (!sleeping || asleepSince < 0 || lastChange >= asleepSince)
+    {   return false;}
+    size_t neighsize;
+    Construction **neibs = ::tradeGraph.neighbors(this, &neighsize);
+    for (size_t i = 0; i < neighsize; ++i)
+    {
+        if (neibs[i]->lastChange >= asleepSince)
+        {   return false;}
+    }
+    return true;
+}
+
+void Construction::wake()
+{
+    lastChange = total_time;
+    asleepSince = -1;
+}
+
+void Construction::checkChanges()
+{
+    bool changed = flags != lastFlags || (int)commodityCount.size() != lastStuffCount;
+    lastFlags = flags;
+    lastStuffCount = commodityCount.size();
+    int i = 0;
+    std::map<Commodities, int>::iterator stuff_it;
+    for(stuff_it = commodityCount.begin() ; stuff_it != commodityCount.end() ; stuff_it++, i++ )
+    {
+        if (changed || lastLevels[i] != stuff_it->second)
+        {
+            lastLevels[i] = stuff_it->second;
+            changed = true;
+        }
+    }
+    if (changed)
+    {   lastChange = total_time;}
 }
 
 int Construction::equilibrate_stuff(int *rem_lvl, int rem_cap , int ratio, Commodities stuff_ID, ConstructionGroup * rem_cstGroup)
 {
-    if (commodityCount.count(stuff_ID) ) // we know stuff_id
+    unsigned int bit = 1 << stuff_ID;
+    cacheStuff();
+    if (stuffMask & bit) // we know stuff_id
     {
         int flow, traffic;
         int *loc_lvl;
         int loc_cap;
-        loc_lvl = &(commodityCount[stuff_ID]);
-        loc_cap = constructionGroup->commodityRuleCount[stuff_ID].maxload;
+        ConstructionGroup *cstGroup = constructionGroup;
+        cstGroup->cacheRules();
+        rem_cstGroup->cacheRules();
+        loc_lvl = stuffLevel[stuff_ID];
+        loc_cap = cstGroup->maxload[stuff_ID];
         if (!(flags & FLAG_EVACUATE))
         {
             flow = (ratio * (loc_cap) / TRANSPORT_QUANTA) - (*loc_lvl);
-            if (((flow > 0) && (!(constructionGroup->commodityRuleCount[stuff_ID].take &&
-            rem_cstGroup->commodityRuleCount[stuff_ID].give) ))
-            || ((flow < 0) && !(constructionGroup->commodityRuleCount[stuff_ID].give &&
-            rem_cstGroup->commodityRuleCount[stuff_ID].take) ))
+            if (((flow > 0) && !(cstGroup->takeMask & rem_cstGroup->giveMask & bit))
+            || ((flow < 0) && !(cstGroup->giveMask & rem_cstGroup->takeMask & bit)))
             {   //construction refuses the flow
                 return 0;
             }
@@ -1324,22 +1461,57 @@ int Construction::equilibrate_stuff(int *rem_lvl, int rem_cap , int ratio, Commo
         }
         *loc_lvl += flow;
         *rem_lvl -= flow;
+        if (flow)
+        {   lastChange = total_time;}
         return traffic;
     }
     return -1; //there was nothing to handle
 }
 
+void Construction::refreshStuff()
+{
+    stuffMask = 0;
+    for (int stuff = 0; stuff < STUFF_COUNT; ++stuff)
+    {   stuffLevel[stuff] = NULL;}
+    //map nodes never move, so the pointers stay valid until the map grows
+    std::map<Commodities, int>::iterator stuff_it;
+    for(stuff_it = commodityCount.begin() ; stuff_it != commodityCount.end() ; stuff_it++ )
+    {
+        stuffLevel[stuff_it->first] = &stuff_it->second;
+        stuffMask |= 1 << stuff_it->first;
+    }
+    stuffCached = commodityCount.size();
+}
+
 void Construction::playSound()
 {
     int s = soundGroup->chunks.size();
     if(soundGroup->sounds_loaded && s)
-    {   getSound()->playASound( soundGroup->chunks[ rand()%s ] );}
+    {   getSound()->playASound( soundGroup->chunks[ getSound()->random(s) ] );}
 }
 
 
 
 //ConstructionGroup Declarations
 
+void ConstructionGroup::refreshRules()
+{
+    giveMask = 0;
+    takeMask = 0;
+    for (int stuff = 0; stuff < Construction::STUFF_COUNT; ++stuff)
+    {   maxload[stuff] = 0;}
+    std::map<Construction::Commodities, CommodityRule>::iterator rule_it;
+    for(rule_it = commodityRuleCount.begin() ; rule_it != commodityRuleCount.end() ; rule_it++)
+    {
+        maxload[rule_it->first] = rule_it->second.maxload;
+        if (rule_it->second.give)
+        {   giveMask |= 1 << rule_it->first;}
+        if (rule_it->second.take)
+        {   takeMask |= 1 << rule_it->first;}
+    }
+    rulesCached = commodityRuleCount.size();
+}
+
 int ConstructionGroup::getCosts() {
     return static_cast<int>
         (cost * (1.0f + (cost_mul * tech_level) / static_cast<float>(MAX_TECH_LEVEL)));
@@ -1355,10 +1527,10 @@ int ConstructionGroup::placeItem(int x, int y)
     {
         for (unsigned short j = 0; j < size; j++)
         {
-            if (world(x+j, y+i)->reportingConstruction)
+            if (world(x+j, y+i)->reportingConstruction())
             {
                 ConstructionManager::executeRequest
-                ( new ConstructionDeletionRequest(world(x+j, y+i)->reportingConstruction));
+                ( new ConstructionDeletionRequest(world(x+j, y+i)->reportingConstruction()));
             }
         }
     }
@@ -1379,8 +1551,14 @@ int ConstructionGroup::placeItem(int x, int y)
         tmpConstr->init_resources();
     }
 #endif
+    placeConstruction(tmpConstr);
+    return 0;
+}
 
-
+void ConstructionGroup::placeConstruction(Construction *tmpConstr)
+{
+    int x = tmpConstr->x;
+    int y = tmpConstr->y;
     for (unsigned short i = 0; i < size; i++)
     {
         for (unsigned short j = 0; j < size; j++)
@@ -1391,19 +1569,19 @@ int ConstructionGroup::placeItem(int x, int y)
                 if( !(tmpConstr->flags & FLAG_TRANSPARENT))
                 {
                     world(x + j, y + i)->setTerrain(GROUP_DESERT);
-                    world(x + j, y + i)->flags |= FLAG_INVISIBLE; //hide maptiles
+                    world(x + j, y + i)->addFlags(FLAG_INVISIBLE); //hide maptiles
                 }
                 else
                 {
-                    world(x + j, y + i)->flags &= (~FLAG_INVISIBLE); //always show maptiles
-                    if (world(x + j, y + i)->group != GROUP_DESERT)
+                    world(x + j, y + i)->clearFlags(FLAG_INVISIBLE); //always show maptiles
+                    if (world(x + j, y + i)->group() != GROUP_DESERT)
                     {   world(x + j, y + i)->setTerrain(GROUP_BARE);}
                 }
             }
-            world(x + j, y + i)->reportingConstruction = tmpConstr;
+            world(x + j, y + i)->setReportingConstruction(tmpConstr);
         } //endfor j
     }// endfor i
-    world(x, y)->construction = tmpConstr;
+    world(x, y)->setConstruction(tmpConstr);
     constructionCount.add_construction(tmpConstr); //register for Simulation
 
     //now look for neighbors
@@ -1412,7 +1590,6 @@ int ConstructionGroup::placeItem(int x, int y)
     && (tmpConstr->constructionGroup->group != GROUP_FIRE)
     && (tmpConstr->constructionGroup->group != GROUP_POWER_LINE)    )
     {   tmpConstr->neighborize();}
-    return 0;
 }
 
 extern void ok_dial_box(const char *, int, const char *);
@@ -1475,7 +1652,7 @@ bool ConstructionGroup::is_allowed_here(int x, int y, bool msg)
     case GROUP_PORT:
         for(int j = 0; j < size; j++ )
         {
-            if (!( world(x + size, y + j)->flags & FLAG_IS_RIVER ) )
+            if (!( world(x + size, y + j)->flags() & FLAG_IS_RIVER ) )
             {
                 if (msg)
                     ok_dial_box("warning.mes", BAD, _("Port must be connected to river all along right side."));
@@ -1490,7 +1667,7 @@ bool ConstructionGroup::is_allowed_here(int x, int y, bool msg)
             bool has_ugw = false;
             for (int i = 0; i < size; i++)
                 for (int j = 0; j < size; j++)
-                    has_ugw = has_ugw | (world(x + j,y + i)->flags & FLAG_HAS_UNDERGROUND_WATER);
+                    has_ugw = has_ugw | (world(x + j,y + i)->flags() & FLAG_HAS_UNDERGROUND_WATER);
             if (!has_ugw)
             {
                 if (msg)
@@ -1509,7 +1686,7 @@ bool ConstructionGroup::is_allowed_here(int x, int y, bool msg)
             {
                 for (int j = 0; j < size; j++)
                 {
-                    total_ore += world(x+j, y+i)->ore_reserve;
+                    total_ore += world(x+j, y+i)->ore_reserve();
                 }
             }
             if (total_ore < MIN_ORE_RESERVE_FOR_MINE) {
@@ -1521,7 +1698,7 @@ bool ConstructionGroup::is_allowed_here(int x, int y, bool msg)
 
     //Parkland
     case GROUP_PARKLAND:
-        if (!(world(x, y)->flags & FLAG_HAS_UNDERGROUND_WATER))
+        if (!(world(x, y)->flags() & FLAG_HAS_UNDERGROUND_WATER))
         {
             if (msg)
                 ok_dial_box("warning.mes", BAD, _("You can't build a park here: it is a desert, parks need water"));
@@ -2181,7 +2358,7 @@ void set_map_groups(void)
     const int len = world.len();
     const int area = len * len;
     for (int index = 0; index < area; ++index)
-    {   world(index)->group = get_group_of_type(world(index)->type);}
+    {   world(index)->setGroup(get_group_of_type(world(index)->type()));}
 }
 
 /*
@@ -2197,7 +2374,7 @@ void get_type_name(short type, char *s)
 {
     short g;
     g = get_group_of_type(type);
-    strcpy(s, _(main_groups[g].name));
+    strcpy(s, translated(main_groups[g].name));
 }
 
 int get_type_cost(short type)
@@ -42,6 +42,7 @@ void set_map_groups(void);
 #include <sstream>
 #include <zlib.h>
 #include "ConstructionCount.h"
+#include "ConstructionPool.h"
 #include "engglobs.h"
 #include <SDL_mixer.h>
 #include <SDL.h>
@@ -51,6 +52,7 @@ void set_map_groups(void);
 
 class Construction;
 class ResourceGroup;
+class XMLloadsave;
 
 struct ExtraFrame{
     ExtraFrame(void){
@@ -66,6 +68,19 @@ struct ExtraFrame{
     ResourceGroup *resourceGroup; //overlay frame is choosen from its GraphicsInfoVector
 };
 
+//The overlays of a MapTile. Nodes and lists come from pools, so vehicles,
+//smoke and fire can come and go without calling the general allocator.
+//Each has a ConstructionPool of its own size, they share no blocks with
+//the constructions.
+class ExtraFrameList: public std::list<ExtraFrame, PoolAllocator<ExtraFrame> >
+{
+public:
+    static void *operator new(size_t size)
+    {   return PoolAllocator<ExtraFrameList>::pool().allocate(size);}
+    static void operator delete(void *ptr, size_t size)
+    {   PoolAllocator<ExtraFrameList>::pool().release(ptr, size);}
+};
+
 // Class to count instanced objects of each construction type
 
 template <typename Class>
@@ -121,26 +136,46 @@ public:
 
 class ConstructionGroup;
 
+//A tile of the world. The fields of the tiles are kept in layers of World,
+//a MapTile is only the index of its tile and is passed around by value.
+//Fields are read by their names and written by set..., e.g.
+//world(x, y)->addFlags(FLAG_ALTERED) or tile->setPollution(0).
 class MapTile {
 public:
-    MapTile();
-    ~MapTile();
-    Ground ground;                        //the Ground associated to an instance of MapTile
-    Construction *construction;           //the actual construction (e.g. for simulation)
-    Construction *reportingConstruction;  //the construction covering the tile
-    unsigned short type;                  //type of terrain (underneath constructions)
-    unsigned short group;                 //group of the terrain (underneath constructions)
-    int flags;                            //flags are defined in lin-city.h
-    unsigned short coal_reserve;          //underground coal
-    unsigned short ore_reserve;           //underground ore
-    int pollution;                        //air pollution (under ground pollution is in ground[][])
-    std::list<ExtraFrame> *framesptr;    //Overlays to be rendered on top of type, mostly NULL
-                                          //use memberfunctions to add and remove sprites
+    explicit MapTile(int index)
+    {   this->index = index;}
+    MapTile* operator->()                  //world(x, y)->... as for a pointer
+    {   return this;}
+    int index;                             //of the tile in World
+    const Ground& ground();                //the Ground of this tile, kept in a layer of World
+    Construction* construction();          //the actual construction (e.g. for simulation)
+    Construction* reportingConstruction(); //the construction covering the tile
+    unsigned short type();                 //type of terrain (underneath constructions)
+    unsigned short group();                //group of the terrain (underneath constructions)
+    int flags();                           //flags are defined in lin-city.h
+    unsigned short coal_reserve();         //underground coal
+    unsigned short ore_reserve();          //underground ore
+    int pollution();                       //air pollution (under ground pollution is in Ground)
+    ExtraFrameList* framesptr();           //Overlays to be rendered on top of type, mostly NULL
+                                           //use memberfunctions to add and remove sprites
+    void setConstruction(Construction *cst);
+    void setReportingConstruction(Construction *cst);
+    void setType(unsigned short type);
+    void setGroup(unsigned short group);
+    void setFlags(int flags);
+    void addFlags(int mask);               //sets the flags of mask
+    void clearFlags(int mask);             //clears the flags of mask
+    void setCoalReserve(unsigned short coal);
+    void setOreReserve(unsigned short ore);
+    void setPollution(int pollution);
+    void addPollution(int amount);
 
     void setTerrain(unsigned short group); //places type & group at MapTile
-    std::list<ExtraFrame>::iterator createframe(); //creates new empty ExtraFrames
+    ExtraFrameList::iterator createframe(); //creates new empty ExtraFrames
                                                     //to be used by Contstructions and Vehicles
-    void killframe(std::list<ExtraFrame>::iterator it); //kills an extraframe
+    void killframe(ExtraFrameList::iterator it); //kills an extraframe
+    void clearframes();                          //kills all extraframes
+    void takeframe(MapTile from, ExtraFrameList::iterator it); //moves an extraframe of from here
 
     unsigned short getType();          //type of bare land or the covering construction
     unsigned short getTopType();       //type of bare land or the actual construction
@@ -170,7 +205,10 @@ public:
 class MemberRule{
 public:
     int memberType; //type of ConstructionMember
-    void *ptr; //address of ConstructionMember
+    void *(*locate)(Construction *cst, int arg); //finds the ConstructionMember in a Construction
+    int arg;        //passed to locate, e.g. the commodity
+    void *ptr(Construction *cst) const //address of ConstructionMember
+    {   return locate(cst, arg);}
 };
 
 template <typename MemberType>
@@ -214,6 +252,7 @@ public:
         STUFF_MWH,
         STUFF_WATER
     };
+    static const int STUFF_COUNT = STUFF_WATER + 1;
 
     enum MemberTypes
     {
@@ -225,10 +264,29 @@ public:
     };
 
     std::map<Commodities, int> commodityCount;  //map that holds all kinds of stuff
-    std::map<std::string, MemberRule> memberRuleCount; //what to do with stuff at this construction
     std::vector<Construction*> neighbors;       //adjacent for transport
     std::vector<Construction*> partners;        //remotely for markets
-    std::list<ExtraFrame>::iterator frameIt;
+    int tradeIndex;                             //node of this construction in ::tradeGraph
+    int lastChange;                             //day commodities or flags last changed
+    int asleepSince;                            //day trade() last moved nothing, -1 while awake
+    //flags and commodity levels after the last update(), compared exactly
+    int lastFlags;
+    int lastStuffCount;                         //size of commodityCount then
+    int lastLevels[STUFF_COUNT];                //in the order of commodityCount
+    //dense view of commodityCount for trade(), refreshed when a commodity is added
+    int *stuffLevel[STUFF_COUNT];               //NULL for commodities not in commodityCount
+    unsigned int stuffMask;                     //bit n is set if commodity n is in commodityCount
+    size_t stuffCached;                         //size of commodityCount when stuffLevel was filled
+    void cacheStuff()
+    {
+        if (commodityCount.size() != stuffCached || !denseViews)
+        {   refreshStuff();}
+    }
+    void refreshStuff();
+    //engine settings, set every day from the config
+    static bool denseViews;     //false rebuilds the dense views at every use
+    static bool sleeping;       //false keeps every construction trading
+    ExtraFrameList::iterator frameIt;
     static std::string getStuffName(Commodities stuff_id); //translated name of a commodity
     void init_resources(void);                      //sets sounds and graphics according to constructionGroup
     void list_commodities(int *);                   //prints a sorted list all commodities in report()
@@ -236,15 +294,33 @@ public:
     void initialize_commodities(void);              //sets all commodities to 0 and marks them as saved members
     void bootstrap_commodities(int percentage);     // sets all commodities except STUFF_WASTE to percentage.
     int loadMember(std::string const &xml_tag, std::string const &xml_val);
-    int readbinaryMember(std::string const &xml_tag, gzFile fp);
-    template <typename MemberType>
-    void setMemberSaved(MemberType *ptr, std::string const &xml_tag)
+    int readbinaryMember(std::string const &xml_tag, size_t len, XMLloadsave &in);
+    //the saved members are described once per ConstructionGroup, not per instance
+    const std::map<std::string, MemberRule> &memberRules();
+    //derived classes add their own members to the ones of Construction (flags and commodities)
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules);
+    template <typename ConstructionClass, typename MemberType, MemberType ConstructionClass::*member>
+    static void *locateMember(Construction *cst, int)
+    {   return &(static_cast<ConstructionClass *>(cst)->*member);}
+    template <typename ConstructionClass, typename MemberType, MemberType ConstructionClass::*member>
+    static void setMemberSaved(std::map<std::string, MemberRule> &rules, std::string const &xml_tag)
     {
-        memberRuleCount[xml_tag].memberType = MemberTraits<MemberType>::TYPE_ID;
-        memberRuleCount[xml_tag].ptr = static_cast<void *>(ptr);
+        rules[xml_tag].memberType = MemberTraits<MemberType>::TYPE_ID;
+        rules[xml_tag].locate = &locateMember<ConstructionClass, MemberType, member>;
+        rules[xml_tag].arg = 0;
     }
+    static void *locateCommodity(Construction *cst, int stuff); //NULL if cst lacks stuff
+    static const double missingMember; //all zero bits, stands in for a NULL member
+    //saves give_ and take_ of the commodityRuleCount of ConstructionClass
+    template <typename ConstructionClass>
+    void setCommodityRulesSaved(std::map<std::string, MemberRule> &rules);
+    template <typename ConstructionClass>
+    static void *locateGive(Construction *cst, int stuff)
+    {   return &static_cast<ConstructionClass *>(cst)->commodityRuleCount[static_cast<Commodities>(stuff)].give;}
+    template <typename ConstructionClass>
+    static void *locateTake(Construction *cst, int stuff)
+    {   return &static_cast<ConstructionClass *>(cst)->commodityRuleCount[static_cast<Commodities>(stuff)].take;}
 
-    void setCommodityRulesSaved(std::map<Commodities,CommodityRule> * stuffRuleCount);
     void writeTemplate();      //create xml template for savegame
     void saveMembers(std::ostream *os);        //writes all needed and optionally set Members as XML to stream
     void detach();      //removes all references from world, ::constructionCount
@@ -254,9 +330,14 @@ public:
     void link_to(Construction* other); //establishes mutual connection to neighbor or partner
     int  tellstuff( Commodities stuff_ID, int level); //tell the filling level of commodity
     void trade(); //exchange commodities with neigbhors
+    bool asleep(); //true if neither this nor a neighbor changed since trade() last moved nothing
+    void wake();   //trade again on the next day, e.g. after the user changed something
+    void checkChanges(); //notes changes update() made to commodities or flags
     int equilibrate_stuff(int *rem_lvl, int rem_cap , int ratio, Commodities stuff_ID, ConstructionGroup * rem_cstGroup);
     //equilibrates stuff with an external reservoir (e.g. another construction invoking this method)
     void playSound();//plays random chunk from constructionGroup
+    virtual size_t memoryUsage() = 0; //bytes of the instance and its containers, estimated
+    size_t containerMemory(); //bytes of commodityCount, neighbors and partners, estimated
 };
 
 extern const char *commodityNames[];
@@ -264,6 +345,26 @@ extern const char *commodityNames[];
 extern std::map<Construction::Commodities, int> tstat_capacities;
 extern std::map<Construction::Commodities, int> tstat_census;
 
+template <typename ConstructionClass>
+void Construction::setCommodityRulesSaved(std::map<std::string, MemberRule> &rules)
+{
+    std::map<Commodities, CommodityRule> &stuffRuleCount = static_cast<ConstructionClass *>(this)->commodityRuleCount;
+    std::map<Commodities, CommodityRule>::iterator stuff_it;
+    std::string giveStr = "give_";
+    std::string takeStr = "take_";
+    for( stuff_it = stuffRuleCount.begin() ; stuff_it != stuffRuleCount.end() ; stuff_it++)
+    {
+        MemberRule &give = rules[giveStr + commodityNames[stuff_it->first]];
+        give.memberType = TYPE_BOOL;
+        give.locate = &locateGive<ConstructionClass>;
+        give.arg = stuff_it->first;
+        MemberRule &take = rules[takeStr + commodityNames[stuff_it->first]];
+        take.memberType = TYPE_BOOL;
+        take.locate = &locateTake<ConstructionClass>;
+        take.arg = stuff_it->first;
+    }
+}
+
 #define MEMBER_TYPE_TRAITS(MemberType, TypeId) \
 template <> \
 class MemberTraits<MemberType> { \
@@ -277,6 +378,11 @@ MEMBER_TYPE_TRAITS(unsigned short, Construction::TYPE_USHORT)
 MEMBER_TYPE_TRAITS(double, Construction::TYPE_DOUBLE)
 MEMBER_TYPE_TRAITS(float, Construction::TYPE_FLOAT)
 
+//saves ConstructionClass::member under its own name, used in describeMembers
+#define MEMBER_SAVED(rules, ConstructionClass, member) \
+    Construction::setMemberSaved<ConstructionClass, decltype(ConstructionClass::member), \
+        &ConstructionClass::member>(rules, #member)
+
 class ConstructionGroup;
 
 template <typename ConstructionClass>
@@ -293,13 +399,31 @@ public:
         this->y = y;
         this->ID = Counted<ConstructionClass>::getNextId();
         this->flags = '\0';
-        setMemberSaved(&(this->flags),"flags");
+        this->tradeIndex = -1;
+        this->lastChange = 0;
+        this->asleepSince = -1;
+        this->lastFlags = 0;
+        this->lastStuffCount = 0;
+        this->stuffMask = 0;
+        this->stuffCached = 0;
 #ifdef DEBUG
         neighbors.clear();
         partners.clear();
 #endif
     }
     ~RegisteredConstruction<ConstructionClass>(){}
+    size_t memoryUsage()
+    {   return sizeof(ConstructionClass) + containerMemory();}
+    //constructions of a class are allocated from their own pool
+    static void *operator new(size_t size)
+    {   return pool().allocate(size);}
+    static void operator delete(void *ptr, size_t size)
+    {   pool().release(ptr, size);}
+    static ConstructionPool &pool()
+    {
+        static ConstructionPool *pool = new ConstructionPool(sizeof(ConstructionClass));
+        return *pool;
+    }
 };
 
 class GraphicsInfo
@@ -310,11 +434,15 @@ class GraphicsInfo
         image = (SDL_Surface*)'\0';
         x = 0;
         y = 0;
+        x_default = false;
+        y_default = false;
     }
 
     Texture* texture;
     SDL_Surface* image;
     int x, y;
+    std::string file; //set if the texture is loaded on demand
+    bool x_default, y_default; //x and y still have to be taken from the image
 };
 
 //all instances are added to resMap
@@ -386,6 +514,9 @@ public:
         this->cost = cost;
         this->tech = tech;
         this->range = range;
+        this->giveMask = 0;
+        this->takeMask = 0;
+        this->rulesCached = 0;
         //this->images_loaded = false;
         //this->sounds_loaded = false;
        }
@@ -403,6 +534,18 @@ public:
     }
 
     std::map<Construction::Commodities, CommodityRule> commodityRuleCount;
+    //dense view of commodityRuleCount for trade(), refreshed when a rule is added
+    int maxload[Construction::STUFF_COUNT];
+    unsigned int giveMask;      //bit n is set if commodity n may be given
+    unsigned int takeMask;      //bit n is set if commodity n may be taken
+    size_t rulesCached;         //size of commodityRuleCount when the above were filled
+    void cacheRules()
+    {
+        if (commodityRuleCount.size() != rulesCached || !Construction::denseViews)
+        {   refreshRules();}
+    }
+    void refreshRules();
+    std::map<std::string, MemberRule> memberRuleCount; //saved members of the constructions, see Construction::memberRules
     //std::vector<Mix_Chunk *> chunks;
     //std::vector<GraphicsInfo> graphicsInfoVector;
     int getCosts();
@@ -410,6 +553,7 @@ public:
     //void growGraphicsInfoVector(void);
 
     virtual int placeItem(int x, int y);
+    void placeConstruction(Construction *cst); //claims the site for cst, registers and neighborizes it
 
     // this method must be overriden by the concrete ConstructionGroup classes.
     virtual Construction *createConstruction(int x, int y) = 0;
@@ -523,6 +667,130 @@ struct TYPE {
 };
 
 
+//the fields of MapTile need the layers of World
+#include "world.h"
+
+inline MapTile World::operator()(int x, int y)
+{   return MapTile(x + y * side_len);}
+
+inline MapTile World::operator()(int index)
+{   return MapTile(index);}
+
+//Reads never allocate a chunk of a layer and setters leave unchanged
+//fields alone, so untouched parts of the map stay unallocated. What they
+//change is stamped for World::nextChanged.
+inline const Ground& MapTile::ground()
+{   return world.groundlayer[index];}
+
+inline Construction* MapTile::construction()
+{   return world.constructionlayer[index];}
+
+inline Construction* MapTile::reportingConstruction()
+{   return world.reportinglayer[index];}
+
+inline unsigned short MapTile::type()
+{   return world.terrainlayer[index].type;}
+
+inline unsigned short MapTile::group()
+{   return world.terrainlayer[index].group;}
+
+inline int MapTile::flags()
+{   return world.flaglayer[index];}
+
+inline unsigned short MapTile::coal_reserve()
+{   return world.reservelayer[index].coal;}
+
+inline unsigned short MapTile::ore_reserve()
+{   return world.reservelayer[index].ore;}
+
+inline int MapTile::pollution()
+{   return world.pollutionlayer[index];}
+
+inline ExtraFrameList* MapTile::framesptr()
+{   return world.framelayer[index];}
+
+inline void MapTile::setConstruction(Construction *cst)
+{
+    if (world.constructionlayer[index] != cst)
+    {
+        world.constructionlayer.poke(index) = cst;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::setReportingConstruction(Construction *cst)
+{
+    if (world.reportinglayer[index] != cst)
+    {
+        world.reportinglayer.poke(index) = cst;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::setType(unsigned short type)
+{
+    if (world.terrainlayer[index].type != type)
+    {
+        world.terrainlayer.poke(index).type = type;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::setGroup(unsigned short group)
+{
+    if (world.terrainlayer[index].group != group)
+    {
+        world.terrainlayer.poke(index).group = group;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::setFlags(int flags)
+{
+    if (world.flaglayer[index] != flags)
+    {
+        world.flaglayer.poke(index) = flags;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::addFlags(int mask)
+{   setFlags(flags() | mask);}
+
+inline void MapTile::clearFlags(int mask)
+{   setFlags(flags() & ~mask);}
+
+inline void MapTile::setCoalReserve(unsigned short coal)
+{
+    if (world.reservelayer[index].coal != coal)
+    {
+        world.reservelayer.poke(index).coal = coal;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::setOreReserve(unsigned short ore)
+{
+    if (world.reservelayer[index].ore != ore)
+    {
+        world.reservelayer.poke(index).ore = ore;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::setPollution(int pollution)
+{
+    if (world.pollutionlayer[index] != pollution)
+    {
+        world.pollutionlayer.poke(index) = pollution;
+        world.touch(index);
+    }
+}
+
+inline void MapTile::addPollution(int amount)
+{   setPollution(pollution() + amount);}
+
+
 #endif /* __lintypes_h__ */
 
 /** @file lincity/lintypes.h */
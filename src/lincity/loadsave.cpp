@@ -171,18 +171,18 @@ void save_city_2(std::string xml_file_name)
                            , 0 //MP_INFO(x, y).int_6
                            , 0 //MP_INFO(x, y).int_7
                            , world(x, y)->pollution
-                           , world(x, y)->ground.altitude
-                           , world(x, y)->ground.ecotable
-                           , world(x, y)->ground.wastes
-                           , world(x, y)->ground.pollution
-                           , world(x, y)->ground.water_alt
-                           , world(x, y)->ground.water_pol
-                           , world(x, y)->ground.water_wast
-                           , world(x, y)->ground.water_next
-                           , world(x, y)->ground.int1
-                           , world(x, y)->ground.int2
-                           , world(x, y)->ground.int3
-                           , world(x, y)->ground.int4
+                           , world.ground(x, y)->altitude
+                           , world.ground(x, y)->ecotable
+                           , world.ground(x, y)->wastes
+                           , world.ground(x, y)->pollution
+                           , world.ground(x, y)->water_alt
+                           , world.ground(x, y)->water_pol
+                           , world.ground(x, y)->water_wast
+                           , world.ground(x, y)->water_next
+                           , world.ground(x, y)->int1
+                           , world.ground(x, y)->int2
+                           , world.ground(x, y)->int3
+                           , world.ground(x, y)->int4
                            , 0 //MP_DATE(x,y)   // d1 = date of built
                            , 0 //MP_TECH(x,y)   // d2 = tech at build time
                            , 0 //MP_ANIM(x,y)   // d3 = animation_time (see reset_animation_time mess :)
@@ -249,7 +249,7 @@ void save_city_2(std::string xml_file_name)
 
         for (int x = 0; x < PBAR_DATA_SIZE; x++)
             for (int p = 0; p < NUM_PBARS; p++)
-                gzprintf(ofile, "%d\n", pbars[p].data[x]);
+                gzprintf(ofile, "%d\n", pbar_value(p, x));
 
         for (int p = 0; p < NUM_PBARS; p++) {
             gzprintf(ofile, "%d\n", pbars[p].oldtot);
@@ -357,13 +357,16 @@ void load_city_2(char *cname)
             for (y = 0; y < COMPATIBLE_WORLD_SIDE_LEN; y++)
             {
                 gzgets(gzfile, s, 512);
+                MapTile tile = world(x, y);
+                unsigned short type = 0, coal = 0, ore = 0;
+                int flags = 0, pollution = 0;
                 //         TY  po fl cr  or  i1 i2 i3 i4 i5 i6 i7 PL al ec ws gp wa wp ww wn g1 g2 g3 g4 DA TK AN d4 d5 d6 d7 d8 d9
                 sscanf(s, "%hu %d %i %hu %hu %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d"
-                        , &(world(x, y)->type)
+                        , &type
                         , &dummy //&MP_INFO(x, y).population
-                        , &(world(x, y)->flags)
-                        , &(world(x, y)->coal_reserve)
-                        , &(world(x, y)->ore_reserve)
+                        , &flags
+                        , &coal
+                        , &ore
                         , &dummy //&MP_INFO(x, y).int_1
                         , &dummy //&MP_INFO(x, y).int_2
                         , &dummy //&MP_INFO(x, y).int_3
@@ -371,19 +374,19 @@ void load_city_2(char *cname)
                         , &dummy //&MP_INFO(x, y).int_5
                         , &dummy //&MP_INFO(x, y).int_6
                         , &dummy //&MP_INFO(x, y).int_7
-                        , &(world(x, y)->pollution)
-                        , &world(x, y)->ground.altitude
-                        , &world(x, y)->ground.ecotable
-                        , &world(x, y)->ground.wastes
-                        , &world(x, y)->ground.pollution
-                        , &world(x, y)->ground.water_alt
-                        , &world(x, y)->ground.water_pol
-                        , &world(x, y)->ground.water_wast
-                        , &world(x, y)->ground.water_next
-                        , &world(x, y)->ground.int1
-                        , &world(x, y)->ground.int2
-                        , &world(x, y)->ground.int3
-                        , &world(x, y)->ground.int4
+                        , &pollution
+                        , &world.pokeGround(x, y)->altitude
+                        , &world.pokeGround(x, y)->ecotable
+                        , &world.pokeGround(x, y)->wastes
+                        , &world.pokeGround(x, y)->pollution
+                        , &world.pokeGround(x, y)->water_alt
+                        , &world.pokeGround(x, y)->water_pol
+                        , &world.pokeGround(x, y)->water_wast
+                        , &world.pokeGround(x, y)->water_next
+                        , &world.pokeGround(x, y)->int1
+                        , &world.pokeGround(x, y)->int2
+                        , &world.pokeGround(x, y)->int3
+                        , &world.pokeGround(x, y)->int4
                         , &dummy//&MP_DATE(x,y)   // d1 = date of built
                         , &dummy//&MP_TECH(x,y)   // d2 = tech at build time
                         , &dummy//&MP_ANIM(x,y)   // d3 = animation_time (see reset_animation_time mess :)
@@ -394,7 +397,12 @@ void load_city_2(char *cname)
                         , &dumbint        // d8
                         , &dumbint        // d9
                         );
-                world(x, y)->group = get_group_of_type(world(x, y)->type);
+                tile->setType(type);
+                tile->setGroup(get_group_of_type(type));
+                tile->setFlags(flags);
+                tile->setCoalReserve(coal);
+                tile->setOreReserve(ore);
+                tile->setPollution(pollution);
 
             }
         }
@@ -450,10 +458,10 @@ void load_city_2(char *cname)
         {
             for (y = 0; y < COMPATIBLE_WORLD_SIDE_LEN; y++)
             {
-                unsigned short type = world(x, y)->type;
-                unsigned short group = world(x,y)->group;
-                world(x,y)->flags &= ~VOLATILE_FLAGS;
-                if (world(x, y)->flags & FLAG_IS_RIVER)
+                unsigned short type = world(x, y)->type();
+                unsigned short group = world(x,y)->group();
+                world(x,y)->clearFlags(VOLATILE_FLAGS);
+                if (world(x, y)->flags() & FLAG_IS_RIVER)
                     {   set_river_tile( x, y);}
 
                 if((group == GROUP_TRACK_BRIDGE) || (group == GROUP_ROAD_BRIDGE)
@@ -465,10 +473,10 @@ void load_city_2(char *cname)
                     ConstructionGroup::getConstructionGroup(group)->placeItem(x, y);
                     if(world(x,y)->is_residence())
                     {
-                        Residence *residence = dynamic_cast<Residence*>(world(x,y)->construction);
+                        Residence *residence = dynamic_cast<Residence*>(world(x,y)->construction());
                         residence->local_population = 95 * residence->max_population / 100;
                     }
-                    world(x,y)->construction->bootstrap_commodities(50);
+                    world(x,y)->construction()->bootstrap_commodities(50);
                     constuctionCounter++;
                 }
                 else if(type == CST_USED)
@@ -577,7 +585,32 @@ void load_city_2(char *cname)
         gzclose(gzfile);
         std::cout << "old loaded " << cname << std::endl;
     }
-    /* Update variables calculated from those above */
+    update_loaded_city();
+}
+
+/* Load a savegame from memory, keeps the save format of the player */
+int load_city_buffer(const std::string &savegame)
+{
+    bool old_binary_mode = binary_mode;
+    bool old_seed_compression = seed_compression;
+    clear_game();
+    init_pbars();
+    init_inventory();
+    int r = xml_loadsave.loadXMLbuffer(savegame);
+    binary_mode = old_binary_mode;
+    seed_compression = old_seed_compression;
+    if (r != 0)
+    {   return r;}
+    update_loaded_city();
+    update_avail_modules(0);
+    return 0;
+}
+
+/* Update variables calculated from those in the savegame */
+void update_loaded_city(void)
+{
+    int x, y;
+
     housed_population = tpopulation / ((total_time % NUMOF_DAYS_IN_MONTH) + 1);
 
     /* FIXME: AL1 this is initialisation stuff, should go elsewhere */
@@ -595,13 +628,13 @@ void load_city_2(char *cname)
 
     for ( y = 0; y < world.len(); y++){
         for ( x = 0; x < world.len(); x++) {
-            if (alt_min > world(x, y)->ground.altitude)
+            if (alt_min > world.ground(x, y)->altitude)
             {
-                 alt_min = world(x, y)->ground.altitude;
+                 alt_min = world.ground(x, y)->altitude;
             }
-            if (alt_max < world(x, y)->ground.altitude)
+            if (alt_max < world.ground(x, y)->altitude)
             {
-                 alt_max = world(x, y)->ground.altitude;
+                 alt_max = world.ground(x, y)->altitude;
             }
         }
     }
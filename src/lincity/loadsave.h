@@ -32,6 +32,8 @@
 void save_city(char *);
 void save_city_2(std::string);
 void load_city_2(char *);
+void update_loaded_city(void);
+int load_city_buffer(const std::string &);
 
 extern void load_city_old(char *);
 
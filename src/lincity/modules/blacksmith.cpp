@@ -48,7 +48,7 @@ void Blacksmith::update()
         if ((goods_made += GOODS_MADE_BY_BLACKSMITH) >= BLACKSMITH_BATCH)
         {
             animate = true;
-            world(x,y)->pollution++;
+            world(x,y)->addPollution(1);
             goods_made = 0;
         }
     }
@@ -43,7 +43,7 @@ void Coal_power::update()
         commodityCount[STUFF_JOBS] -= jobs_used;
         commodityCount[STUFF_COAL] -= coal_used;
         commodityCount[STUFF_MWH] += mwh_made;
-        world(x,y)->pollution += POWERS_COAL_POLLUTION *(mwh_made/100)/(mwh_output/100);
+        world(x,y)->addPollution(POWERS_COAL_POLLUTION *(mwh_made/100)/(mwh_output/100));
         working_days += (mwh_made/100);
     }
     //monthly update
@@ -51,7 +51,7 @@ void Coal_power::update()
     {
         busy = working_days / (mwh_output/100);
         animate = (frameIt->resourceGroup->images_loaded);
-        std::list<ExtraFrame>::iterator frit = fr_begin;
+        ExtraFrameList::iterator frit = fr_begin;
         if(animate)
         {
             int active = 8*busy/90;
@@ -91,7 +91,7 @@ void Coal_power::update()
     if (animate && (real_time > anim))
     {
         anim = real_time + SMOKE_ANIM_SPEED;
-        std::list<ExtraFrame>::iterator frit;
+        ExtraFrameList::iterator frit;
         for(frit = fr_begin; frit != fr_end; std::advance(frit, 1))
         {
             if (frit->frame >= 0)
@@ -60,8 +60,8 @@ public:
     {
         this->constructionGroup = cstgrp;
         init_resources();
-        world(x,y)->framesptr->resize(world(x,y)->framesptr->size()+8);
-        std::list<ExtraFrame>::iterator frit = frameIt;
+        world(x,y)->framesptr()->resize(world(x,y)->framesptr()->size()+8);
+        ExtraFrameList::iterator frit = frameIt;
         std::advance(frit, 1);
         fr_begin = frit;
         frit->move_x = 5;
@@ -89,7 +89,7 @@ public:
         frit->move_y = -383;
         std::advance(frit, 1);
         fr_end = frit;
-        for (frit = fr_begin; frit != world(x,y)->framesptr->end() && frit != fr_end; std::advance(frit, 1))
+        for (frit = fr_begin; frit != world(x,y)->framesptr()->end() && frit != fr_end; std::advance(frit, 1))
         {
             frit->resourceGroup = ResourceGroup::resMap["BlackSmoke"];
             frit->frame = -1; // hide smoke
@@ -97,29 +97,30 @@ public:
         this->anim = 0;
         this->animate = false;
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         this->working_days = 0;
         this->busy = 0;
         this->mwh_output = (int)(POWERS_COAL_OUTPUT + (((double)tech_level * POWERS_COAL_OUTPUT) / MAX_TECH_LEVEL));
-        setMemberSaved(&this->mwh_output, "mwh_output");
         initialize_commodities();
     }
     virtual ~Coal_power() //remove 2 or more extraframes
     {
-        if(world(x,y)->framesptr)
+        if(world(x,y)->framesptr())
         {
-            world(x,y)->framesptr->erase(fr_begin, fr_end);
-            if(world(x,y)->framesptr->empty())
-            {
-                delete world(x,y)->framesptr;
-                world(x,y)->framesptr = NULL;
-            }
+            world(x,y)->framesptr()->erase(fr_begin, fr_end);
+            if(world(x,y)->framesptr()->empty())
+            {   world(x,y)->clearframes();}
         }
     }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Coal_power, tech);
+        MEMBER_SAVED(rules, Coal_power, mwh_output);
+    }
 
-    std::list<ExtraFrame>::iterator fr_begin, fr_end;
+    ExtraFrameList::iterator fr_begin, fr_end;
     int anim;
     bool animate;
     int  mwh_output;
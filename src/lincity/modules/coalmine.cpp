@@ -40,7 +40,7 @@ void Coalmine::update()
     for (int yy = ys; yy < ye ; yy++)
     {
         for (int xx = xs; xx < xe ; xx++)
-        {   current_coal_reserve += world(xx,yy)->coal_reserve;}
+        {   current_coal_reserve += world(xx,yy)->coal_reserve();}
     }
     // mine some coal
     if ((current_coal_reserve > 0)
@@ -51,11 +51,11 @@ void Coalmine::update()
         {
             for (int xx = xs; (xx < xe) && !coal_found; xx++)
             {
-                if (world(xx,yy)->coal_reserve > 0)
+                if (world(xx,yy)->coal_reserve() > 0)
                 {
-                    world(xx,yy)->coal_reserve--;
-                    world(xx,yy)->pollution += COALMINE_POLLUTION;
-                    world(xx,yy)->flags |= FLAG_ALTERED;
+                    world(xx,yy)->setCoalReserve(world(xx,yy)->coal_reserve() - 1);
+                    world(xx,yy)->addPollution(COALMINE_POLLUTION);
+                    world(xx,yy)->addFlags(FLAG_ALTERED);
                     commodityCount[STUFF_COAL] += COAL_PER_RESERVE;
                     commodityCount[STUFF_JOBS] -= COALMINE_JOBS;
                     if (current_coal_reserve < initial_coal_reserve)
@@ -73,10 +73,10 @@ void Coalmine::update()
         {
             for (int xx = xs; (xx < xe) && !coal_found; xx++)
             {
-                if (world(xx,yy)->coal_reserve < COAL_RESERVE_SIZE)
+                if (world(xx,yy)->coal_reserve() < COAL_RESERVE_SIZE)
                 {
-                    world(xx,yy)->coal_reserve++;
-                    world(xx,yy)->flags |= FLAG_ALTERED;
+                    world(xx,yy)->setCoalReserve(world(xx,yy)->coal_reserve() + 1);
+                    world(xx,yy)->addFlags(FLAG_ALTERED);
                     commodityCount[STUFF_COAL] -= COAL_PER_RESERVE;
                     commodityCount[STUFF_JOBS] -= COALMINE_JOBS;
                     coal_found = true;
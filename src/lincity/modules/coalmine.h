@@ -78,22 +78,26 @@ public:
         for (int yy = ys; yy < ye ; yy++)
         {
             for (int xx = xs; xx < xe ; xx++)
-            {   coal += world(xx,yy)->coal_reserve;}
+            {   coal += world(xx,yy)->coal_reserve();}
         }
         //always provide some coal so player can
         //store sustainable coal
         if (coal < 20)
         {
-            world(x,y)->coal_reserve += 20-coal;
+            world(x,y)->setCoalReserve(world(x,y)->coal_reserve() + (20-coal));
             coal = 20;
         }
         this->initial_coal_reserve = coal;
-        setMemberSaved(&this->initial_coal_reserve,"initial_coal_reserve");
         this->current_coal_reserve = coal;
     }
     virtual ~Coalmine() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Coalmine, initial_coal_reserve);
+    }
 
     int xs, ys, xe, ye;
     int initial_coal_reserve;
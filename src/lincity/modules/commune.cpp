@@ -66,8 +66,8 @@ void Commune::update()
         {
             int i = x + idx % s;
             int j = y + idx / s;
-            if((i+j)%2==modulus && world(i,j)->pollution)
-            {   --world(i,j)->pollution;}
+            if((i+j)%2==modulus && world(i,j)->pollution())
+            {   world(i,j)->addPollution(-1);}
         }
         if (!steel_made && commodityCount[STUFF_STEEL] + COMMUNE_STEEL_MADE <= MAX_STEEL_AT_COMMUNE)
         {
@@ -136,7 +136,7 @@ void Commune::report()
     mps_store_sd(i++, constructionGroup->name, ID);
     mps_store_sddp(i++, N_("Fertility"), ugwCount, constructionGroup->size * constructionGroup->size);
     mps_store_sfp(i++, N_("busy"), (float)last_month_output / 3.05);
-    mps_store_sd(i++, N_("Pollution"), world(x,y)->pollution);
+    mps_store_sd(i++, N_("Pollution"), world(x,y)->pollution());
     if(lazy_months)
     {   mps_store_sddp(i++, N_("lazy months"), lazy_months, 120);}
     else
@@ -83,7 +83,7 @@ public:
         {
             for (int j = 0; j < constructionGroup->size; j++)
             {
-                if (world(x+j, y+i)->flags & FLAG_HAS_UNDERGROUND_WATER)
+                if (world(x+j, y+i)->flags() & FLAG_HAS_UNDERGROUND_WATER)
                 {    w++;}
             }// end j
         }//end i
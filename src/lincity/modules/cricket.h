@@ -58,13 +58,10 @@ public:
         this->anim = 0;
         this->animate = false;
         this->active = false;
-        setMemberSaved(&(this->active),"active");
         this->busy = 0;
         this->daycount = 0;
         this->working_days = 0;
-        setMemberSaved(&(this->daycount),"daycount");
         this->covercount = 0;
-        setMemberSaved(&(this->covercount),"covercount");
         initialize_commodities();
 
         int tmp;
@@ -82,6 +79,13 @@ public:
     virtual ~Cricket() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Cricket, active);
+        MEMBER_SAVED(rules, Cricket, daycount);
+        MEMBER_SAVED(rules, Cricket, covercount);
+    }
     void cover();
 
     int xs, ys, xe, ye;
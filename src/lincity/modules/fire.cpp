@@ -48,7 +48,7 @@ void Fire::update()
             soundGroup = frameIt->resourceGroup;
         }
         smoking_days++;
-        if (world(x,y)->flags & FLAG_FIRE_COVER)
+        if (world(x,y)->flags() & FLAG_FIRE_COVER)
         {   smoking_days += 4;}
         if (smoking_days > AFTER_FIRE_LENGTH)
         {   ConstructionManager::submitRequest( new ConstructionDeletionRequest(this) ); }
@@ -64,11 +64,11 @@ void Fire::update()
     }
 
     burning_days++;
-    if (world(x,y)->flags & FLAG_FIRE_COVER)
+    if (world(x,y)->flags() & FLAG_FIRE_COVER)
     {   burning_days += 4;}
     days_before_spread--;
     if( !(flags & FLAG_IS_GHOST) )
-    {   world(x,y)->pollution++;}
+    {   world(x,y)->addPollution(1);}
     if (real_time > anim)
     {
         anim = real_time + FIRE_ANIMATION_SPEED;
@@ -106,7 +106,7 @@ void Fire::report()
 
     mps_store_sd(i++,constructionGroup->name, ID);
     i++;
-    mps_store_sd(i++,N_("Air Pollution"), world(x,y)->pollution);
+    mps_store_sd(i++,N_("Air Pollution"), world(x,y)->pollution());
     if (burning_days < FIRE_LENGTH)
     {   mps_store_sddp(i++,N_("burnt down"), burning_days, FIRE_LENGTH);}
     else
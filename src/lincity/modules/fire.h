@@ -47,16 +47,20 @@ public:
         this->constructionGroup = cstgrp;
         init_resources();
         this->burning_days = 0;
-        setMemberSaved(&this->burning_days, "burning_days");
         this->smoking_days = 0;
-        setMemberSaved(&this->smoking_days, "smoking_days");
         this->anim = 0;
         this->days_before_spread = FIRE_DAYS_PER_SPREAD;
-        setMemberSaved(&this->days_before_spread, "days_before_spread");
 
     }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Fire, burning_days);
+        MEMBER_SAVED(rules, Fire, smoking_days);
+        MEMBER_SAVED(rules, Fire, days_before_spread);
+    }
 
     int burning_days;
     int smoking_days;
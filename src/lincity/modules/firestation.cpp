@@ -81,7 +81,7 @@ void FireStation::cover()
     for(int yy = ys; yy < ye; ++yy)
     {
         for(int xx = xs; xx < xe; ++xx)
-        {   world(xx,yy)->flags |= FLAG_FIRE_COVER;}
+        {   world(xx,yy)->addFlags(FLAG_FIRE_COVER);}
     }
 }
 
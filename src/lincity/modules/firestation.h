@@ -58,13 +58,10 @@ public:
         this->anim = 0;
         this->animate = false;
         this->active = false;
-        setMemberSaved(&(this->active),"active");
         this->busy = 0;
         this->working_days = 0;
         this->daycount = 0;
-        setMemberSaved(&(this->daycount),"daycount");
         this->covercount = 0;
-        setMemberSaved(&(this->covercount),"covercount");
         initialize_commodities();
 
         int tmp;
@@ -81,6 +78,13 @@ public:
     virtual ~FireStation() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, FireStation, active);
+        MEMBER_SAVED(rules, FireStation, daycount);
+        MEMBER_SAVED(rules, FireStation, covercount);
+    }
     void cover();
 
     int xs, ys, xe, ye;
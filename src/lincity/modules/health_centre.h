@@ -54,13 +54,10 @@ public:
         this->constructionGroup = cstgrp;
         init_resources();
         this->active = false;
-        setMemberSaved(&(this->active),"active");
         this->busy = 0;
         this->daycount = 0;
         this->working_days = 0;
-        setMemberSaved(&(this->daycount),"daycount");
         this->covercount = 0;
-        setMemberSaved(&(this->covercount),"covercount");
         initialize_commodities();
 
         int tmp;
@@ -77,6 +74,13 @@ public:
     virtual ~HealthCentre() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, HealthCentre, active);
+        MEMBER_SAVED(rules, HealthCentre, daycount);
+        MEMBER_SAVED(rules, HealthCentre, covercount);
+    }
     void cover();
 
     int xs, ys, xe, ye;
@@ -90,12 +90,12 @@ void IndustryHeavy::update()
             commodityCount[STUFF_STEEL] += steel;
             steel_this_month += steel;
             //cause some pollution and waste depending on bonuses
-            world(x,y)->pollution += (int)(((double)(POL_PER_STEEL_MADE * steel) * (1 - bonus)));
+            world(x,y)->addPollution((int)(((double)(POL_PER_STEEL_MADE * steel) * (1 - bonus))));
             commodityCount[STUFF_WASTE] += (int)(((double)(POL_PER_STEEL_MADE * steel) * bonus)*(1-extra_bonus));
             // if the trash bin is full reburn the filterd pollution
             if (commodityCount[STUFF_WASTE] > MAX_WASTE_AT_INDUSTRY_H)
             {
-                world(x,y)->pollution += (commodityCount[STUFF_WASTE] - MAX_WASTE_AT_INDUSTRY_H);
+                world(x,y)->addPollution(commodityCount[STUFF_WASTE] - MAX_WASTE_AT_INDUSTRY_H);
                 commodityCount[STUFF_WASTE] = MAX_WASTE_AT_INDUSTRY_H;
             }
         }//endif steel still > 0
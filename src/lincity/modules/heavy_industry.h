@@ -78,16 +78,13 @@ public:
         constructionGroup = cstgrp;
         init_resources();
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         this->output_level = 0;
         this->steel_this_month = 0;
         this->anim = 0;
         initialize_commodities();
          //check for pollution bonus
         this->bonus = 0;
-        setMemberSaved(&this->bonus, "bonus");
         this->extra_bonus = 0;
-        setMemberSaved(&this->extra_bonus, "extra_bonus");
         if (tech > MAX_TECH_LEVEL)
         {
             bonus = (tech - MAX_TECH_LEVEL);
@@ -106,6 +103,13 @@ public:
     }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, IndustryHeavy, tech);
+        MEMBER_SAVED(rules, IndustryHeavy, bonus);
+        MEMBER_SAVED(rules, IndustryHeavy, extra_bonus);
+    }
 
     int  tech;
     double bonus, extra_bonus;
@@ -46,12 +46,12 @@ void IndustryLight::update()
         commodityCount[STUFF_ORE] -= INDUSTRY_L_ORE_USED;
         goods_today = INDUSTRY_L_MAKE_GOODS;
         //make some pollution and waste
-        world(x,y)->pollution += (int)(((double)(INDUSTRY_L_POL_PER_GOOD * goods_today) * (1 - bonus)));
+        world(x,y)->addPollution((int)(((double)(INDUSTRY_L_POL_PER_GOOD * goods_today) * (1 - bonus))));
         commodityCount[STUFF_WASTE] += (int)(((double)(INDUSTRY_L_POL_PER_GOOD * goods_today) * bonus)*(1-extra_bonus));
         // if the trash bin is full reburn the filterd pollution
         if (commodityCount[STUFF_WASTE] > MAX_WASTE_AT_INDUSTRY_L)
             {
-                world(x,y)->pollution += (commodityCount[STUFF_WASTE] - MAX_WASTE_AT_INDUSTRY_L);
+                world(x,y)->addPollution(commodityCount[STUFF_WASTE] - MAX_WASTE_AT_INDUSTRY_L);
                 commodityCount[STUFF_WASTE] = MAX_WASTE_AT_INDUSTRY_L;
             }
         //now double goods_today if there are more jobs and steel
@@ -120,7 +120,7 @@ void IndustryLight::update()
         {   active = 2;}
         else if (output_level > 5)
         {   active = 1;}
-        std::list<ExtraFrame>::iterator frit = fr_begin;
+        ExtraFrameList::iterator frit = fr_begin;
 
         for(int i = 0; i < 2 && frit != fr_end; ++i, std::advance(frit, 1))
         {
@@ -140,7 +140,7 @@ void IndustryLight::update()
     if ((real_time >= anim) && goods_today)
     {
         anim = real_time + INDUSTRY_L_ANIM_SPEED;
-        std::list<ExtraFrame>::iterator frit = fr_begin;
+        ExtraFrameList::iterator frit = fr_begin;
 
         for(size_t i = 0; i < 2; ++i, std::advance(frit, 1))
         {
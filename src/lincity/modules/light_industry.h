@@ -79,8 +79,8 @@ public:
     {
         this->constructionGroup = cstgrp;
         init_resources();
-        world(x,y)->framesptr->resize(world(x,y)->framesptr->size()+2);
-        std::list<ExtraFrame>::iterator frit = frameIt;
+        world(x,y)->framesptr()->resize(world(x,y)->framesptr()->size()+2);
+        ExtraFrameList::iterator frit = frameIt;
         std::advance(frit, 1);
         fr_begin = frit;
 
@@ -93,7 +93,7 @@ public:
         frit->move_y = -198;
         std::advance(frit, 1);
         fr_end = frit;
-        for (frit = fr_begin; frit != world(x,y)->framesptr->end() && frit != fr_end; std::advance(frit, 1))
+        for (frit = fr_begin; frit != world(x,y)->framesptr()->end() && frit != fr_end; std::advance(frit, 1))
         {
             frit->resourceGroup = ResourceGroup::resMap["GraySmoke"];
             frit->frame = -1; // hide smoke
@@ -101,16 +101,13 @@ public:
 
 
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         this->working_days = 0;
         this->busy = 0;
         this->goods_this_month = 0;
         this->anim = 0;
         initialize_commodities();
         this->bonus = 0;
-        setMemberSaved(&this->bonus, "bonus");
         this->extra_bonus = 0;
-        setMemberSaved(&this->extra_bonus, "extra_bonus");
         if (tech > MAX_TECH_LEVEL)
         {
             bonus = (tech - MAX_TECH_LEVEL);
@@ -130,20 +127,24 @@ public:
 
     virtual ~IndustryLight() //remove 2 or more extraframes
     {
-        if(world(x,y)->framesptr)
+        if(world(x,y)->framesptr())
         {
-            world(x,y)->framesptr->erase(fr_begin, fr_end);
-            if(world(x,y)->framesptr->empty())
-            {
-                delete world(x,y)->framesptr;
-                world(x,y)->framesptr = NULL;
-            }
+            world(x,y)->framesptr()->erase(fr_begin, fr_end);
+            if(world(x,y)->framesptr()->empty())
+            {   world(x,y)->clearframes();}
         }
     }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, IndustryLight, tech);
+        MEMBER_SAVED(rules, IndustryLight, bonus);
+        MEMBER_SAVED(rules, IndustryLight, extra_bonus);
+    }
 
-    std::list<ExtraFrame>::iterator fr_begin, fr_end;
+    ExtraFrameList::iterator fr_begin, fr_end;
     int  tech;
     double bonus, extra_bonus;
     int  working_days;
@@ -39,7 +39,8 @@ void Market::update()
     int lvl, market_lvl;
     int cap, market_cap;
     int market_ratio = 0;
-    const size_t partsize = partners.size();
+    size_t partsize;
+    Construction **parts = ::tradeGraph.partners(this, &partsize);
     bool lvls[partsize];
     Commodities stuff_ID;
     std::map<Commodities, int>::iterator stuff_it;
@@ -64,7 +65,7 @@ void Market::update()
         for(unsigned int i = 0; i < partsize; ++i)
         {
             lvls[i] = false;
-            Construction *pear = partners[i];
+            Construction *pear = parts[i];
             if(pear->commodityCount.count(stuff_ID))
             {
                 int lvlsi = pear->commodityCount[stuff_ID];
@@ -91,7 +92,7 @@ void Market::update()
         for(unsigned int i = 0; i < partsize; ++i)
         {
             if(lvls[i])
-            {   partners[i]->equilibrate_stuff(&market_lvl, market_cap, trade_ratio, stuff_ID, constructionGroup);}
+            {   parts[i]->equilibrate_stuff(&market_lvl, market_cap, trade_ratio, stuff_ID, constructionGroup);}
         }
         stuff_it->second = market_lvl;
     }
@@ -140,29 +141,29 @@ void Market::update()
         }
         soundGroup = frameIt->resourceGroup;
     }
-    if (commodityCount[STUFF_WASTE] >= (85 * MAX_WASTE_IN_MARKET / 100) && !world(x+1,y+1)->construction)
+    if (commodityCount[STUFF_WASTE] >= (85 * MAX_WASTE_IN_MARKET / 100) && !world(x+1,y+1)->construction())
     {
         anim = real_time + 6 * WASTE_BURN_TIME;
-        world(x+1,y+1)->pollution += MAX_WASTE_IN_MARKET/20;
+        world(x+1,y+1)->addPollution(MAX_WASTE_IN_MARKET/20);
         commodityCount[STUFF_WASTE] -= (7 * MAX_WASTE_IN_MARKET) / 10;
-        if(!world(x+1,y+1)->construction)
+        if(!world(x+1,y+1)->construction())
         {
             Construction *fire = fireConstructionGroup.createConstruction(x+1, y+1);
-            world(x+1,y+1)->construction = fire;
-            world(x+1,y+1)->reportingConstruction = fire;
+            world(x+1,y+1)->setConstruction(fire);
+            world(x+1,y+1)->setReportingConstruction(fire);
             //waste burning never spreads
             (dynamic_cast<Fire*>(fire))->flags |= FLAG_IS_GHOST;
             ::constructionCount.add_construction(fire);
 
         }
     }
-    else if ( real_time > anim && world(x+1,y+1)->construction)
+    else if ( real_time > anim && world(x+1,y+1)->construction())
     {
-        ::constructionCount.remove_construction(world(x+1,y+1)->construction);
-        world(x+1,y+1)->killframe(world(x+1,y+1)->construction->frameIt);
-        delete world(x+1,y+1)->construction;
-        world(x+1,y+1)->construction = NULL;
-        world(x+1,y+1)->reportingConstruction = this;
+        ::constructionCount.remove_construction(world(x+1,y+1)->construction());
+        world(x+1,y+1)->killframe(world(x+1,y+1)->construction()->frameIt);
+        delete world(x+1,y+1)->construction();
+        world(x+1,y+1)->setConstruction(NULL);
+        world(x+1,y+1)->setReportingConstruction(this);
     }
 
     if(refresh_cover)
@@ -174,7 +175,7 @@ void Market::cover()
     for(int yy = ys; yy < ye; yy++)
     {
         for(int xx = xs; xx < xe; xx++)
-        {   world(xx,yy)->flags |= FLAG_MARKET_COVER;}
+        {   world(xx,yy)->addFlags(FLAG_MARKET_COVER);}
     }
 }
 
@@ -233,6 +234,7 @@ void Market::toggleEvacuation()
     flags &= ~FLAG_EVACUATE;
     if(!evacuate)
     {   flags |= FLAG_EVACUATE;}
+    wake();
 }
 
 /** @file lincity/modules/market.cpp */
@@ -80,7 +80,6 @@ public:
         init_resources();
         //local copy of commodityRuCount
         commodityRuleCount = constructionGroup->commodityRuleCount;
-        setCommodityRulesSaved(&commodityRuleCount);
         initialize_commodities();
         this->jobs = JOBS_MARKET_EMPTY;
         this->anim = 0;
@@ -101,6 +100,11 @@ public:
     }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        setCommodityRulesSaved<Market>(rules);
+    }
     void cover();
     void toggleEvacuation();
 
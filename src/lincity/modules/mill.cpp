@@ -42,7 +42,7 @@ void Mill::update()
         ++working_days;
         animate = true;
         if ((++pol_count %= 7) == 0)
-        {   world(x,y)->pollution++;}
+        {   world(x,y)->addPollution(1);}
     }
     else
     {
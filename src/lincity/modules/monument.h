@@ -51,14 +51,10 @@ public:
         this->busy = 0;
         this->working_days = 0;
         this->tech_made = 0;
-        setMemberSaved(&this->tech_made, "tech_made");
         this->tail_off = 0;
-        setMemberSaved(&this->tail_off, "tail_off");
         this->completion = 0;
-        setMemberSaved(&this->completion, "completion");
         this->completed = false; //dont save this one
         this->jobs_consumed = 0;
-        setMemberSaved(&this->jobs_consumed, "jobs_consumed");
         initialize_commodities();
 
     }
@@ -66,6 +62,14 @@ public:
     virtual ~Monument() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Monument, tech_made);
+        MEMBER_SAVED(rules, Monument, tail_off);
+        MEMBER_SAVED(rules, Monument, completion);
+        MEMBER_SAVED(rules, Monument, jobs_consumed);
+    }
 
     int  working_days, busy;
     int  tech_made;
@@ -44,10 +44,10 @@ void Oremine::update()
         {
             for (xx = x; (xx < x + constructionGroup->size) && !animate; xx++)
             {
-                if (world(xx,yy)->ore_reserve > 0)
+                if (world(xx,yy)->ore_reserve() > 0)
                 {
-                    world(xx,yy)->ore_reserve--;
-                    world(xx,yy)->flags |= FLAG_ALTERED;
+                    world(xx,yy)->setOreReserve(world(xx,yy)->ore_reserve() - 1);
+                    world(xx,yy)->addFlags(FLAG_ALTERED);
                     total_ore_reserve--;
                     commodityCount[STUFF_ORE] += ORE_PER_RESERVE;
                     commodityCount[STUFF_JOBS] -= OREMINE_JOBS;
@@ -69,10 +69,10 @@ void Oremine::update()
         {
             for (xx = x; (xx < x + constructionGroup->size) && !animate; xx++)
             {
-                if (world(xx,yy)->ore_reserve < (3 * ORE_RESERVE/2))
+                if (world(xx,yy)->ore_reserve() < (3 * ORE_RESERVE/2))
                 {
-                    world(xx,yy)->ore_reserve++;
-                    world(xx,yy)->flags |= FLAG_ALTERED;
+                    world(xx,yy)->setOreReserve(world(xx,yy)->ore_reserve() + 1);
+                    world(xx,yy)->addFlags(FLAG_ALTERED);
                     total_ore_reserve++;
                     commodityCount[STUFF_ORE] -= ORE_PER_RESERVE;
                     commodityCount[STUFF_JOBS] -= OREMINE_JOBS;
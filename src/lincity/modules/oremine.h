@@ -66,16 +66,20 @@ public:
         for (int yy = y; (yy < y + constructionGroup->size) ; yy++)
         {
             for (int xx = x; (xx < x + constructionGroup->size); xx++)
-            {   ore += world(xx,yy)->ore_reserve;}
+            {   ore += world(xx,yy)->ore_reserve();}
         }
         if (ore < 1)
         { ore = 1;}
         this->total_ore_reserve = ore;
-        setMemberSaved(&this->total_ore_reserve, "total_ore_reserve");
     }
     virtual ~Oremine() {}
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Oremine, total_ore_reserve);
+    }
 
 
     int total_ore_reserve;
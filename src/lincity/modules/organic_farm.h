@@ -77,9 +77,7 @@ public:
         this->constructionGroup = cstgrp;
         init_resources();
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         this->tech_bonus = int( ((long long int)tech_level * ORGANIC_FARM_FOOD_OUTPUT) / MAX_TECH_LEVEL );
-        setMemberSaved(&this->tech_bonus, "tech_bonus");
         this->crop_rotation_key = (rand() % 4) + 1;
         this->month_stagger = rand() % 100;
         this->food_this_month = 0;
@@ -94,7 +92,7 @@ public:
             {
                 for (int j = 0; j < constructionGroup->size; j++)
                 {
-                    if (world(x + j, y + i)->flags & FLAG_HAS_UNDERGROUND_WATER)
+                    if (world(x + j, y + i)->flags() & FLAG_HAS_UNDERGROUND_WATER)
                         w++;
                 }// end j
             }//end i
@@ -108,6 +106,12 @@ public:
     virtual ~Organic_farm() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Organic_farm, tech);
+        MEMBER_SAVED(rules, Organic_farm, tech_bonus);
+    }
 
     int  ugwCount;
     int  max_foodprod;
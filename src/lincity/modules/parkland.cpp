@@ -43,8 +43,8 @@ Construction *ParklandConstructionGroup::createConstruction(int x, int y) {
 
 void Parkland::update()
 {
-    if (world(x,y)->pollution > 10 && (total_time & 1) == 0)
-        world(x,y)->pollution --;
+    if (world(x,y)->pollution() > 10 && (total_time & 1) == 0)
+        world(x,y)->addPollution(-1);
 }
 
 void Parkland::report()
@@ -53,7 +53,7 @@ void Parkland::report()
 
     mps_store_sd(i++, constructionGroup->name, ID);
     i++;
-    mps_store_sd(i++, N_("Air Pollution"), world(x,y)->pollution);
+    mps_store_sd(i++, N_("Air Pollution"), world(x,y)->pollution());
 }
 
 /** @file lincity/modules/parkland.cpp */
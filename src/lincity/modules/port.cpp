@@ -78,7 +78,7 @@ void Port::update()
         if (daily_ic || daily_et)
         {
             commodityCount[STUFF_JOBS] -= PORT_JOBS;
-            world(x,y)->pollution += PORT_POLLUTION;
+            world(x,y)->addPollution(PORT_POLLUTION);
             sust_port_flag = 0;
             tech_made++;
             tech_level++;
@@ -102,7 +102,6 @@ public:
         this->working_days = 0;
         this->busy = 0;
         this->tech_made = 0;
-        setMemberSaved(&this->tech_made, "tech_made");
         initialize_commodities();
         //local copy of commodityRuleCount
         commodityRuleCount = constructionGroup->commodityRuleCount;
@@ -118,11 +117,16 @@ public:
         commodityRuleCount[Construction::STUFF_ORE].give = false;
         commodityRuleCount[Construction::STUFF_STEEL].take = false;
         commodityRuleCount[Construction::STUFF_STEEL].give = false;
-        setCommodityRulesSaved(&commodityRuleCount);
     }
     virtual ~Port() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Port, tech_made);
+        setCommodityRulesSaved<Port>(rules);
+    }
     int buy_stuff(Commodities stuff_ID);
     int sell_stuff(Commodities stuff_ID);
     void trade_connection();
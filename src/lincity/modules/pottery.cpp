@@ -48,7 +48,7 @@ void Pottery::update()
 
         animate = true;
         if(!((working_days++)%10))
-        {   world(x,y)->pollution++;}
+        {   world(x,y)->addPollution(1);}
     }
     else
     {
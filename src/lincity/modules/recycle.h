@@ -70,20 +70,24 @@ public:
         this->busy = 0;
         this->working_days = 0;
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         initialize_commodities();
         int efficiency;
         efficiency = ( WASTE_RECYCLED * (10 + ( (50 * tech) / MAX_TECH_LEVEL)) ) / 100;
         if (efficiency > (WASTE_RECYCLED * 8) / 10)
         {   efficiency = (WASTE_RECYCLED * 8) / 10;}
         this->make_ore = efficiency;
-        setMemberSaved(&this->make_ore, "make_ore");
         this->make_steel = efficiency / 50;
-        setMemberSaved(&this->make_steel, "make_steel");
     }
     virtual ~Recycle() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Recycle, tech);
+        MEMBER_SAVED(rules, Recycle, make_ore);
+        MEMBER_SAVED(rules, Recycle, make_steel);
+    }
 
     int  tech;
     int  make_ore;
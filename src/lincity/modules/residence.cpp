@@ -114,16 +114,16 @@ void Residence::update()
     //int pol_death = 0;             //sometimes pollution kills
 
     /*Determine Health,Fire,Cricket cover*/
-    if ((hc = world(x,y)->flags & FLAG_HEALTH_COVER))
+    if ((hc = world(x,y)->flags() & FLAG_HEALTH_COVER))
     {
         brm = RESIDENCE_BRM_HEALTH;
         good += 15;
     }
-    if (world(x,y)->flags & FLAG_FIRE_COVER)
+    if (world(x,y)->flags() & FLAG_FIRE_COVER)
     {   good += 15;}
     else
     {   bad += 5;}
-    if (world(x,y)->flags & FLAG_CRICKET_COVER)
+    if (world(x,y)->flags() & FLAG_CRICKET_COVER)
     {
         good += 20;
         cc = CRICKET_JOB_SWING;
@@ -277,7 +277,7 @@ void Residence::update()
     if (drm > RESIDENCE_BASE_DR - 1)
     {   drm = RESIDENCE_BASE_DR - 1;}
     /* normal deaths + pollution deaths */
-    po = ((world(x,y)->pollution / 16) + 1);
+    po = ((world(x,y)->pollution() / 16) + 1);
     pol_deaths = po>100?95:po-5>0?po-5:1;
     deaths = (RESIDENCE_BASE_DR - drm - 3*po);
     if (deaths < 1) deaths = 1;
@@ -319,7 +319,7 @@ void Residence::update()
 
     /* people_pool stuff */
     //bad += local_population / 2;
-    bad += world(x,y)->pollution / 20;
+    bad += world(x,y)->pollution() / 20;
     good += people_pool / 27; //27
     desireability = good-bad;
     r = rand() % ((good + bad) * RESIDENCE_PPM);
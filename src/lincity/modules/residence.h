@@ -176,7 +176,6 @@ public:
         this->constructionGroup = cstgrp;
         init_resources();
         this->local_population = 0;
-        setMemberSaved(&(this->local_population),"local_population");
         this->job_swingometer = 0;
         this->desireability = 0;
         this->births = 120000;
@@ -209,6 +208,11 @@ public:
     }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Residence, local_population);
+    }
 
     int local_population;
     int max_population;
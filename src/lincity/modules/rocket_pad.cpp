@@ -116,6 +116,7 @@ void RocketPad::update()
 void RocketPad::launch_rocket()
 {
     int i, r, xx, yy, xxx, yyy;
+    journal.record(Journal::OP_LAUNCH_ROCKET, x, y);
     rockets_launched++;
     frameIt->frame = 7;
     busy = 0;
@@ -70,23 +70,27 @@ public:
         this->busy = 0;
         this->anim = 0;
         this->completion = 0;
-        setMemberSaved(&this->completion, "completion");
         this->step = 0;
-        setMemberSaved(&this->step, "step");
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         this->goods_stored = 0;
-        setMemberSaved(&this->goods_stored, "goods_stored");
         this->jobs_stored = 0;
-        setMemberSaved(&this->jobs_stored, "jobs_stored");
         this->steel_stored = 0;
-        setMemberSaved(&this->steel_stored, "steel_stored");
         initialize_commodities();
     }
 
     virtual ~RocketPad() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, RocketPad, completion);
+        MEMBER_SAVED(rules, RocketPad, step);
+        MEMBER_SAVED(rules, RocketPad, tech);
+        MEMBER_SAVED(rules, RocketPad, goods_stored);
+        MEMBER_SAVED(rules, RocketPad, jobs_stored);
+        MEMBER_SAVED(rules, RocketPad, steel_stored);
+    }
     void launch_rocket();
     void remove_people(int num);
     int working_days, busy;
@@ -58,9 +58,9 @@ public:
     {
         this->constructionGroup = cstgrp;
         init_resources();
-        //std::list<ExtraFrame>::iterator frit = world(x,y)->createframe();
+        //ExtraFrameList::iterator frit = world(x,y)->createframe();
         //CK ?? Why the hell is the variant above unsafe?
-        world(x,y)->framesptr->resize(world(x,y)->framesptr->size()+1);
+        world(x,y)->framesptr()->resize(world(x,y)->framesptr()->size()+1);
         frit = frameIt;
         std::advance(frit, 1);
         frit->resourceGroup = ResourceGroup::resMap["ChildOnSwing"]; //host of the swing
@@ -70,26 +70,27 @@ public:
         this->working_days = 0;
         this->busy = 0;
         this->total_tech_made = 0;
-        setMemberSaved(&this->total_tech_made, "total_tech_made");
         initialize_commodities();
     }
 
     virtual ~School() //remove the one extraframe
     {
-        if(world(x,y)->framesptr)
+        if(world(x,y)->framesptr())
         {
-            world(x,y)->framesptr->erase(frit);
-            if(world(x,y)->framesptr->empty())
-            {
-                delete world(x,y)->framesptr;
-                world(x,y)->framesptr = NULL;
-            }
+            world(x,y)->framesptr()->erase(frit);
+            if(world(x,y)->framesptr()->empty())
+            {   world(x,y)->clearframes();}
         }
     }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, School, total_tech_made);
+    }
 
-    std::list<ExtraFrame>::iterator frit;
+    ExtraFrameList::iterator frit;
     int  anim;
     bool animate;
     int total_tech_made;
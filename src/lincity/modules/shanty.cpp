@@ -117,7 +117,7 @@ void update_shanty(void)
             }
             y = r / len;
             x = r % len;
-            ConstructionManager::executeRequest(new BurnDownRequest(world(x,y)->reportingConstruction));
+            ConstructionManager::executeRequest(new BurnDownRequest(world(x,y)->reportingConstruction()));
         }
     }
 }
@@ -151,27 +151,27 @@ void Shanty::update()
     {   commodityCount[STUFF_ORE] -= SHANTY_GET_ORE;}
     if (commodityCount[STUFF_STEEL] >= SHANTY_GET_STEEL)
     {   commodityCount[STUFF_STEEL] -= SHANTY_GET_STEEL;}
-    if ((commodityCount[STUFF_WASTE]+= SHANTY_PUT_WASTE) >= MAX_WASTE_AT_SHANTY && !world(x+1,y+1)->construction)
+    if ((commodityCount[STUFF_WASTE]+= SHANTY_PUT_WASTE) >= MAX_WASTE_AT_SHANTY && !world(x+1,y+1)->construction())
     {
         anim = real_time + 3 * WASTE_BURN_TIME;
-        world(x+1,y+1)->pollution += commodityCount[STUFF_WASTE];
+        world(x+1,y+1)->addPollution(commodityCount[STUFF_WASTE]);
         commodityCount[STUFF_WASTE] = 0;
-        if(!world(x+1,y+1)->construction)
+        if(!world(x+1,y+1)->construction())
         {
             Construction *fire = fireConstructionGroup.createConstruction(x+1, y+1);
-            world(x+1,y+1)->construction = fire;
-            world(x+1,y+1)->reportingConstruction = fire;
+            world(x+1,y+1)->setConstruction(fire);
+            world(x+1,y+1)->setReportingConstruction(fire);
             dynamic_cast<Fire*>(fire)->flags |= FLAG_IS_GHOST;
             ::constructionCount.add_construction(fire);
         }
     }
-    else if ( real_time > anim && world(x+1,y+1)->construction)
+    else if ( real_time > anim && world(x+1,y+1)->construction())
     {
-        ::constructionCount.remove_construction(world(x+1,y+1)->construction);
-        world(x+1,y+1)->killframe(world(x+1,y+1)->construction->frameIt);
-        delete world(x+1,y+1)->construction;
-        world(x+1,y+1)->construction = NULL;
-        world(x+1,y+1)->reportingConstruction = this;
+        ::constructionCount.remove_construction(world(x+1,y+1)->construction());
+        world(x+1,y+1)->killframe(world(x+1,y+1)->construction()->frameIt);
+        delete world(x+1,y+1)->construction();
+        world(x+1,y+1)->setConstruction(NULL);
+        world(x+1,y+1)->setReportingConstruction(this);
     }
 }
 
@@ -179,7 +179,7 @@ void Shanty::report()
 {
     int i = 0;
     mps_store_sd(i++, constructionGroup->name, ID);
-    mps_store_sd(i++, N_("Air Pollution"), world(x,y)->pollution);
+    mps_store_sd(i++, N_("Air Pollution"), world(x,y)->pollution());
     i++;
     list_commodities(&i);
 }
@@ -51,16 +51,20 @@ public:
         init_resources();
         this->flags |= FLAG_NEVER_EVACUATE;
         this->total_waste = 0;
-        setMemberSaved(&this->total_waste,"total_waste");
         this->working_days = 0;
         this->busy = 0;
         this->degration_days = 0;
-        setMemberSaved(&this->degration_days,"degration_days");
         initialize_commodities();
     }
     virtual ~Tip() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Tip, total_waste);
+        MEMBER_SAVED(rules, Tip, degration_days);
+    }
 
     int  working_days, busy;
     int  total_waste;
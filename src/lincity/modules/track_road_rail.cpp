@@ -115,7 +115,7 @@ void Transport::update()
         case GROUP_ROAD_BRIDGE:
             ++transport_cost;
             if (total_time % DAYS_PER_ROAD_POLLUTION == 0)
-                world(x,y)->pollution += ROAD_POLLUTION;
+                world(x,y)->addPollution(ROAD_POLLUTION);
             if ((total_time & ROAD_GOODS_USED_MASK) == 0 && commodityCount[STUFF_GOODS] > 0)
             {
                 --commodityCount[STUFF_GOODS];
@@ -126,7 +126,7 @@ void Transport::update()
         case GROUP_RAIL_BRIDGE:
             transport_cost += 3;
             if (total_time % DAYS_PER_RAIL_POLLUTION == 0)
-                world(x,y)->pollution += RAIL_POLLUTION;
+                world(x,y)->addPollution(RAIL_POLLUTION);
             if ((total_time & RAIL_GOODS_USED_MASK) == 0 && commodityCount[STUFF_GOODS] > 0)
             {
                 --commodityCount[STUFF_GOODS];
@@ -152,13 +152,13 @@ void Transport::update()
     {
         anim = real_time + WASTE_BURN_TIME;
         commodityCount[STUFF_WASTE] -= WASTE_BURN_ON_TRANSPORT;
-        world(x,y)->pollution += WASTE_BURN_ON_TRANSPORT_POLLUTE;
+        world(x,y)->addPollution(WASTE_BURN_ON_TRANSPORT_POLLUTE);
         if(!burning_waste)
         {
             burning_waste = true;
             //Fire sets frameIt manually
             Construction *fire = fireConstructionGroup.createConstruction(x, y);
-            world(x,y)->construction = fire;
+            world(x,y)->setConstruction(fire);
             //waste burning never spreads
             (dynamic_cast<Fire*>(fire))->flags |= FLAG_IS_GHOST;
             ::constructionCount.add_construction(fire);
@@ -167,13 +167,13 @@ void Transport::update()
     else if(burning_waste && (real_time > anim))
     {
         burning_waste = false;
-        ::constructionCount.remove_construction(world(x,y)->construction);
+        ::constructionCount.remove_construction(world(x,y)->construction());
 #ifdef DEBUG
         assert(world(x,y)->construction->neighbors.empty());
 #endif
-        world(x,y)->framesptr->erase(world(x,y)->construction->frameIt);
-        delete world(x,y)->construction;
-        world(x,y)->construction = this;
+        world(x,y)->framesptr()->erase(world(x,y)->construction()->frameIt);
+        delete world(x,y)->construction();
+        world(x,y)->setConstruction(this);
     }
 }
 
@@ -220,14 +220,14 @@ void Transport::playSound()
             {   avg /= trafficCount.size();}
             int num_sounds = soundGroup->chunks.size()/2;
             if(avg > 5)
-            {   getSound()->playASound(soundGroup->chunks[rand()%num_sounds]);}
+            {   getSound()->playASound(soundGroup->chunks[getSound()->random(num_sounds)]);}
             else
-            {   getSound()->playASound(soundGroup->chunks[num_sounds+rand()%num_sounds]);}
+            {   getSound()->playASound(soundGroup->chunks[num_sounds+getSound()->random(num_sounds)]);}
         }
         else
         {
             int s = soundGroup->chunks.size();
-            getSound()->playASound(soundGroup->chunks[rand()%s]);
+            getSound()->playASound(soundGroup->chunks[getSound()->random(s)]);
         }
     }
 }
@@ -18,9 +18,9 @@ void mps_water(int x, int y)
     mps_store_sdd(i++, waterConstructionGroup.name, x, y);
     i++;
 
-    if ( world(x,y)->flags & FLAG_IS_LAKE )
+    if ( world(x,y)->flags() & FLAG_IS_LAKE )
     {   p = N_("Lake");}
-    else if ( world(x,y)->flags & FLAG_IS_RIVER )
+    else if ( world(x,y)->flags() & FLAG_IS_RIVER )
     {   p = N_("River");}
     else
     {   p = N_("Pond");}
@@ -29,9 +29,9 @@ void mps_water(int x, int y)
 #ifdef DEBUG
     mps_store_sd(10, "x", x);
     mps_store_sd(11, "y", y);
-    mps_store_sd(12, "altitude", world(x,y)->ground.altitude);
+    mps_store_sd(12, "altitude", world.ground(x,y)->altitude);
 
-    fprintf(stderr, "water x %i, y %i, Alt %i\n", x, y, world(x,y)->ground.altitude);
+    fprintf(stderr, "water x %i, y %i, Alt %i\n", x, y, world.ground(x,y)->altitude);
 #endif
 */
 }
@@ -55,17 +55,21 @@ public:
         this->anim = 0;
         this->animate = false;
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         this->working_days = 0;
         this->busy = 0;
         this->kwh_output = (int)(WINDMILL_KWH + (((double)tech_level * WINDMILL_KWH) / MAX_TECH_LEVEL));
-        setMemberSaved(&this->kwh_output, "kwh_output");
         initialize_commodities();
     }
 
     virtual ~Windmill() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Windmill, tech);
+        MEMBER_SAVED(rules, Windmill, kwh_output);
+    }
 
     int  kwh_output;
     int  tech;
@@ -58,16 +58,20 @@ public:
         this->anim = 0;
         this->animate = false;
         this->tech = tech_level;
-        setMemberSaved(&this->tech, "tech");
         this->working_days = 0;
         this->busy = 0;
         this->mwh_output = (int)(WIND_POWER_MWH + (((double)tech_level * WIND_POWER_MWH) / MAX_TECH_LEVEL));
-        setMemberSaved(&this->mwh_output, "mwh_output");
         initialize_commodities();
     }
     virtual ~Windpower() { }
     virtual void update();
     virtual void report();
+    virtual void describeMembers(std::map<std::string, MemberRule> &rules)
+    {
+        Construction::describeMembers(rules);
+        MEMBER_SAVED(rules, Windpower, tech);
+        MEMBER_SAVED(rules, Windpower, mwh_output);
+    }
 
     int  mwh_output;
     int  tech;
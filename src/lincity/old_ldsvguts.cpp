@@ -166,22 +166,27 @@ void load_city_old(char *cname)
     for (x = 0; x < world.len(); x++) {
         for (y = 0; y < world.len(); y++) {
             int dummy; //FIXME hack to pretend reading obsolete data
+            int flags = 0;
+            unsigned short coal = 0, ore = 0;
             for (z = 0; z < sizeof(int); z++) {
                 sscanf(gzgets(gzfile, s, 256), "%d", &n);
                 *(((unsigned char *)&dummy) + z) = n;
             }
             for (z = 0; z < sizeof(int); z++) {
                 sscanf(gzgets(gzfile, s, 256), "%d", &n);
-                *(((unsigned char *)&world(x, y)->flags) + z) = n;
+                *(((unsigned char *)&flags) + z) = n;
             }
             for (z = 0; z < sizeof(unsigned short); z++) {
                 sscanf(gzgets(gzfile, s, 256), "%d", &n);
-                *(((unsigned char *)&world(x, y)->coal_reserve) + z) = n;
+                *(((unsigned char *)&coal) + z) = n;
             }
             for (z = 0; z < sizeof(unsigned short); z++) {
                 sscanf(gzgets(gzfile, s, 256), "%d", &n);
-                *(((unsigned char *)&world(x, y)->ore_reserve) + z) = n;
+                *(((unsigned char *)&ore) + z) = n;
             }
+            world(x, y)->setFlags(flags);
+            world(x, y)->setCoalReserve(coal);
+            world(x, y)->setOreReserve(ore);
             for (z = 0; z < sizeof(int); z++) { //int1
                 sscanf(gzgets(gzfile, s, 256), "%d", &n);
                 *(((unsigned char *)&dummy) + z) = n;
@@ -211,9 +216,9 @@ void load_city_old(char *cname)
                 *(((unsigned char *)&dummy) + z) = n;
             }
             sscanf(gzgets(gzfile, s, 256), "%d", &n);
-            world(x, y)->pollution = (unsigned short)n;
+            world(x, y)->setPollution((unsigned short)n);
             sscanf(gzgets(gzfile, s, 256), "%d", &n);
-            world(x, y)->type = (short)n;
+            world(x, y)->setType((short)n);
 
         }
         if (((93 * x) / world.len()) % 3 == 0)
@@ -393,22 +398,22 @@ void load_city_old(char *cname)
         for (x = 0; x < world.len(); x++) {
             for (y = 0; y < world.len(); y++) {
                 gzgets(gzfile, s, 200);
-                sscanf(s,"%d %d %d %d %d %d %d %d %d %d %d %d",&(world(x, y)->ground.altitude)
-                        , &world(x, y)->ground.ecotable
-                        , &world(x, y)->ground.wastes
-                        , &world(x, y)->ground.pollution
-                        , &world(x, y)->ground.water_alt
-                        , &world(x, y)->ground.water_pol
-                        , &world(x, y)->ground.water_wast
-                        , &world(x, y)->ground.water_next
-                        , &world(x, y)->ground.int1
-                        , &world(x, y)->ground.int2
-                        , &world(x, y)->ground.int3
-                        , &world(x, y)->ground.int4
+                sscanf(s,"%d %d %d %d %d %d %d %d %d %d %d %d",&(world.pokeGround(x, y)->altitude)
+                        , &world.pokeGround(x, y)->ecotable
+                        , &world.pokeGround(x, y)->wastes
+                        , &world.pokeGround(x, y)->pollution
+                        , &world.pokeGround(x, y)->water_alt
+                        , &world.pokeGround(x, y)->water_pol
+                        , &world.pokeGround(x, y)->water_wast
+                        , &world.pokeGround(x, y)->water_next
+                        , &world.pokeGround(x, y)->int1
+                        , &world.pokeGround(x, y)->int2
+                        , &world.pokeGround(x, y)->int3
+                        , &world.pokeGround(x, y)->int4
                         );
 #ifdef DEBUG
                 if (x == 10 && y == 10)
-                    fprintf(stderr," alt %d, int4 %d \n", world(x, y)->ground.altitude, world(x, y)->ground.int4);
+                    fprintf(stderr," alt %d, int4 %d \n", world.ground(x, y)->altitude, world.ground(x, y)->int4);
 #endif
             }
         }
@@ -555,13 +560,21 @@ void check_endian(void)
     for (y = 0; y < world.len(); y++) {
         for (x = 0; x < world.len(); x++) {
             //eswap32(&(map.info[x][y].population));
-            eswap32(&(world(x, y)->flags));
+            int flags = world(x, y)->flags();
+            unsigned short coal = world(x, y)->coal_reserve();
+            unsigned short ore = world(x, y)->ore_reserve();
+            eswap32(&flags);
+            world(x, y)->setFlags(flags);
             if (sizeof(short) == 2) {
-                eswap16(&(world(x, y)->coal_reserve));
-                eswap16(&(world(x, y)->ore_reserve));
+                eswap16(&coal);
+                eswap16(&ore);
+                world(x, y)->setCoalReserve(coal);
+                world(x, y)->setOreReserve(ore);
             } else if (sizeof(short) == 4) {
-                eswap32((int *)&(world(x, y)->coal_reserve));
-                eswap32((int *)&(world(x, y)->ore_reserve));
+                eswap32((int *)&coal);
+                eswap32((int *)&ore);
+                world(x, y)->setCoalReserve(coal);
+                world(x, y)->setOreReserve(ore);
             } else {
                 /* prevent gcc warning on amd64: argument 2 has type 'long unsigned int' !!! */
                 printf("Strange size (%d) for short, please mail me.\n", (int) sizeof(short));
@@ -613,11 +626,11 @@ void upgrade_to_v2 (void)
     // Grey border (not visible on the map, x = 0 , x = 99, y = 0, y = 99)
     for (x = 0; x < world.len(); x++)
         for (y = 0; y < world.len(); y++) {
-            world(x, y)->ground.altitude = 0;
+            world.pokeGround(x, y)->altitude = 0;
             if ( !world(x, y)->is_bare()) {
                 /* be nice, put water under all existing builings / farms / parks ... */
                 /* This may change according to global_aridity and distance_to_river */
-                world(x, y)->flags |= FLAG_HAS_UNDERGROUND_WATER;
+                world(x, y)->addFlags(FLAG_HAS_UNDERGROUND_WATER);
             }
         }
 
@@ -49,7 +49,9 @@
 #include "engine.h"
 #include "engglobs.h"
 #include "../lincity-ng/GameView.hpp"
+#include "../lincity-ng/Config.hpp"
 #include "Vehicles.h"
+#include "Profiler.h"
 
 
 /* extern resources */
@@ -85,6 +87,7 @@ static int sust_fire_cover(void);
  * ---------------------------------------------------------------------- */
 void do_time_step(void)
 {
+    PROFILE_ZONE("do_time_step");
     if (flag_warning) {
         flag_warning = false;
         /* FIXME use blocking_dialog_open instead */
@@ -112,16 +115,25 @@ void do_time_step(void)
     {   init_yearly();}
 
     /* execute yesterdays requests OR treat loadgame requests*/
-    ConstructionManager::executePendingRequests();
+    {
+        PROFILE_PHASE(PHASE_REQUESTS, "executePendingRequests");
+        ConstructionManager::executePendingRequests();
+    }
 
     /* Run through simulation equations for each farm, residence, etc. */
     simulate_mappoints();
 
     /* Remove all too old cars*/
-    Vehicle::cleanVehicleList();
+    {
+        PROFILE_PHASE(PHASE_VEHICLES, "cleanVehicleList");
+        Vehicle::cleanVehicleList();
+    }
 
     /* Now do the stuff that happens once a year, once a month, etc. */
     do_periodic_events();
+
+    /* Keep the day in the statistics history */
+    statsHistory.sampleDay();
 }
 
 /* ---------------------------------------------------------------------- *
@@ -131,16 +143,25 @@ void do_time_step(void)
 static void do_periodic_events(void)
 {
     add_daily_to_monthly();
-    do_daily_ecology();
+    {
+        PROFILE_PHASE(PHASE_ECOLOGY, "do_daily_ecology");
+        do_daily_ecology();
+    }
 
     if ((total_time % NUMOF_DAYS_IN_YEAR) == 0)
     {   start_of_year_update();}
     if ((total_time % DAYS_PER_POLLUTION) == 3)
-    {   do_pollution();}
+    {
+        PROFILE_PHASE(PHASE_POLLUTION, "do_pollution");
+        do_pollution();
+    }
     if ((total_time % (DAYS_BETWEEN_FIRES*100/world.len()*100/world.len() )) == 9 && tech_level > (GROUP_FIRESTATION_TECH * MAX_TECH_LEVEL / 1000))
     {   do_random_fire(-1, -1, 1);}
     if ((total_time % DAYS_BETWEEN_COVER) == 75)
-    {   do_fire_health_cricket_power_cover();} //constructions will call ::cover()
+    {
+        PROFILE_PHASE(PHASE_COVER, "do_fire_health_cricket_power_cover");
+        do_fire_health_cricket_power_cover(); //constructions will call ::cover()
+    }
     else //constructions will not call ::cover()
     {   refresh_cover = false;}
     if ((total_time % DAYS_BETWEEN_SHANTY) == 15 && tech_level > (GROUP_HEALTH_TECH * MAX_TECH_LEVEL / 1000))
@@ -154,7 +175,10 @@ static void do_periodic_events(void)
 static void end_of_month_update(void)
 {
     //update queque of polluted tiles
-    scan_pollution();
+    {
+        PROFILE_PHASE(PHASE_POLLUTION, "scan_pollution");
+        scan_pollution();
+    }
     //fetch remaining textures in order loader thread can exit
     if(getGameView()->textures_ready && getGameView()->remaining_images)
     {   getGameView()->fetchTextures();}
@@ -195,6 +219,8 @@ static void end_of_month_update(void)
         {   constructionCount[i]->report_commodities();}
     }
     update_pbars_monthly();
+    if (metricsSink)
+    {   metricsSink->reportMonth();}
 }
 
 static void start_of_year_update(void)
@@ -280,17 +306,75 @@ static void end_of_year_update(void)
 
 static void simulate_mappoints(void)
 {
+    PROFILE_ZONE("simulate_mappoints");
     Construction *construction;
     constructionCount.shuffle();
+    powerGrid.enabled = getConfig()->powerGrid;
+    tradeGraph.enabled = getConfig()->tradeGraph;
+    Construction::sleeping = getConfig()->sleeping;
+    Construction::denseViews = getConfig()->denseTrade;
+    groupCosts.enabled = getConfig()->groupCosts;
+    if (groupCosts.enabled)
+    {   ++groupCosts.days;}
+    if (powerGrid.enabled)
+    {
+        PROFILE_PHASE(PHASE_TRADE, "PowerGrid::balance");
+        powerGrid.balance();
+    }
+    //consecutive clock readings split the loop into trade and update,
+    //without zones or group costs only every TRADE_SAMPLE-th construction
+    //is clocked and its split apportions the time of the whole loop
+    const int TRADE_SAMPLE = 16;
+    bool timed = groupCosts.enabled;
+#ifdef ENABLE_ZONES
+    timed = true;
+#endif
+    long long start = Profiler::now();
+    long long mark = start;
+    long long sampledTrade = 0, sampledUpdate = 0;
     for (int i = 0; i < constructionCount.size(); i++)
     {
         construction = constructionCount[i];
         if (construction)
         {
-            construction->trade();
+            bool clocked = timed || i % TRADE_SAMPLE == 0;
+            if (!timed && clocked)
+            {   mark = Profiler::now();}
+            //trading is skipped while nothing around would move
+            if (!construction->asleep())
+            {   construction->trade();}
+            if (!clocked)
+            {
+                construction->update();
+                construction->checkChanges();
+                continue;
+            }
+            long long traded = Profiler::now();
             construction->update();
+            construction->checkChanges();
+            long long updated = Profiler::now();
+            if (!timed)
+            {
+                sampledTrade += traded - mark;
+                sampledUpdate += updated - traded;
+                continue;
+            }
+            Profiler::addPhase(Profiler::PHASE_TRADE, traded - mark);
+            Profiler::addPhase(Profiler::PHASE_UPDATE, updated - traded);
+            if (groupCosts.enabled)
+            {   groupCosts.add(construction->constructionGroup->group, traded - mark, updated - traded);}
+            mark = updated;
         }
     }
+    if (!timed)
+    {
+        long long total = Profiler::now() - start;
+        long long sampled = sampledTrade + sampledUpdate;
+        long long trade = sampled ? total * sampledTrade / sampled : 0;
+        Profiler::addPhase(Profiler::PHASE_TRADE, trade);
+        Profiler::addPhase(Profiler::PHASE_UPDATE, total - trade);
+    }
+    PROFILE_PHASE(PHASE_VEHICLES, "Vehicle::update");
     for(std::list<Vehicle*>::iterator it = Vehicle::vehicleList.begin();
         it != Vehicle::vehicleList.end();
         std::advance(it,1))
@@ -380,7 +464,7 @@ static int sust_fire_cover(void)
             {   continue;}
             int x = constructionCount[i]->x;
             int y = constructionCount[i]->y;
-            if(!(world(x, y)->flags & FLAG_FIRE_COVER))
+            if(!(world(x, y)->flags() & FLAG_FIRE_COVER))
             {   return(0);}
         }
     }
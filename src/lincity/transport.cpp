@@ -50,7 +50,7 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
         for (int x = originx; x <= lastx; ++x)
         {
             // First, set up a mask according to directions
-            cstr = world(x, y)->construction;
+            cstr = world(x, y)->construction();
             int* frame = cstr ? &(cstr->frameIt->frame) : NULL;
             int mask = 0;
             switch (world(x, y)->getGroup())
@@ -59,121 +59,121 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
             {
                 bool far = false;
                 int mwh = -1;
-                world(x,y)->reportingConstruction->deneighborize();
+                world(x,y)->reportingConstruction()->deneighborize();
                 /* up -- (ThMO) */
-                mwh = world(x, y-1)->reportingConstruction?
-                world(x, y-1)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;
+                mwh = world(x, y-1)->reportingConstruction()?
+                world(x, y-1)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;
                 if ((far = ((y > 1) && (world(x, y-1)->is_water() || world(x, y-1)->is_transport()))))
                 {
-                    mwh = world(x, y-2)->reportingConstruction?
-                    world(x, y-2)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;
+                    mwh = world(x, y-2)->reportingConstruction()?
+                    world(x, y-2)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;
                 }
                 if(mwh != -1)
                 {
                     if (far) //suspended cables
                     {
                         //opposite edge
-                        if (!world(x, y-2)->reportingConstruction->countPowercables(1))
+                        if (!world(x, y-2)->reportingConstruction()->countPowercables(1))
                         {
-                            world(x, y-1)->flags |= FLAG_POWER_CABLES_0;
-                            cstr->link_to(world(x,y-2)->reportingConstruction);
+                            world(x, y-1)->addFlags(FLAG_POWER_CABLES_0);
+                            cstr->link_to(world(x,y-2)->reportingConstruction());
                             mask |=8;
                         }
                     }
                     else
                     {
-                        cstr->link_to(world(x,y-1)->reportingConstruction);
+                        cstr->link_to(world(x,y-1)->reportingConstruction());
                         mask |=8;
                     }
                 }
                 else
-                {   world(x, y-1)->flags &= ~FLAG_POWER_CABLES_0;}
+                {   world(x, y-1)->clearFlags(FLAG_POWER_CABLES_0);}
 
                 /* left -- (ThMO) */
-                mwh = world(x-1, y)->reportingConstruction?
-                world(x-1, y)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;
+                mwh = world(x-1, y)->reportingConstruction()?
+                world(x-1, y)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;
                 if((far = ((x > 1) && (world(x-1, y)->is_water() || world(x-1, y)->is_transport()))))
                 {
-                    mwh = world(x-2, y)->reportingConstruction?
-                    world(x-2, y)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;
+                    mwh = world(x-2, y)->reportingConstruction()?
+                    world(x-2, y)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;
                 }
                 if(mwh != -1)
                 {
                     if (far) //suspended cables
                     {
                         //opposite edge
-                        if ( !world(x-2, y)->reportingConstruction->countPowercables(2) )
+                        if ( !world(x-2, y)->reportingConstruction()->countPowercables(2) )
                         {
-                            cstr->link_to(world(x-2,y)->reportingConstruction);
-                            world(x-1, y)->flags |= FLAG_POWER_CABLES_90;
+                            cstr->link_to(world(x-2,y)->reportingConstruction());
+                            world(x-1, y)->addFlags(FLAG_POWER_CABLES_90);
                             mask |=4;
                         }
                     }
                     else
                     {
-                        cstr->link_to(world(x-1,y)->reportingConstruction);
+                        cstr->link_to(world(x-1,y)->reportingConstruction());
                         mask |=4;
                     }
                 }
                 else
-                {   world(x-1, y)->flags &= ~FLAG_POWER_CABLES_90;}
+                {   world(x-1, y)->clearFlags(FLAG_POWER_CABLES_90);}
 
                 /* right -- (ThMO) */
-                mwh = world(x+1, y)->reportingConstruction?
-                world(x+1, y)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;
+                mwh = world(x+1, y)->reportingConstruction()?
+                world(x+1, y)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;
                 if ((far = ((x < world.len() - 2) && (world(x+1, y)->is_water() || world(x+1, y)->is_transport()))))
                 {
-                    mwh = world(x+2, y)->reportingConstruction?
-                    world(x+2, y)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;
+                    mwh = world(x+2, y)->reportingConstruction()?
+                    world(x+2, y)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;
                 }
                 if(mwh != -1)
                 {
                     if (far) //suspended cables
                     {
                         //opposite edge
-                        if ( !world(x+2, y)->reportingConstruction->countPowercables(4) )
+                        if ( !world(x+2, y)->reportingConstruction()->countPowercables(4) )
                         {
-                            cstr->link_to(world(x+2,y)->reportingConstruction);
-                            world(x+1, y)->flags |= FLAG_POWER_CABLES_90;
+                            cstr->link_to(world(x+2,y)->reportingConstruction());
+                            world(x+1, y)->addFlags(FLAG_POWER_CABLES_90);
                             mask |=2;
                         }
                     }
                     else
                     {
-                        cstr->link_to(world(x+1,y)->reportingConstruction);
+                        cstr->link_to(world(x+1,y)->reportingConstruction());
                         mask |=2;
                     }
                 }
                 else
-                {   world(x+1, y)->flags &= ~FLAG_POWER_CABLES_90;}
+                {   world(x+1, y)->clearFlags(FLAG_POWER_CABLES_90);}
 
                 /* down -- (ThMO) */
-                mwh = world(x, y+1)->reportingConstruction?
-                world(x, y+1)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;
+                mwh = world(x, y+1)->reportingConstruction()?
+                world(x, y+1)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;
                 if ((far = (y < world.len() - 2) && (world(x, y+1)->is_water() || world(x, y+1)->is_transport())))
                 {
-                    mwh = world(x, y+2)->reportingConstruction?
-                    world(x, y+2)->reportingConstruction->tellstuff(Construction::STUFF_MWH, -2):-1;}
+                    mwh = world(x, y+2)->reportingConstruction()?
+                    world(x, y+2)->reportingConstruction()->tellstuff(Construction::STUFF_MWH, -2):-1;}
                 if(mwh != -1)
                 {
                     if (far) //suspended cables
                     {
                         //opposite edge
-                        if ( !world(x, y+2)->reportingConstruction->countPowercables(8) )
+                        if ( !world(x, y+2)->reportingConstruction()->countPowercables(8) )
                         {
-                            cstr->link_to(world(x,y+2)->reportingConstruction);
-                            world(x, y+1)->flags |= FLAG_POWER_CABLES_0;
+                            cstr->link_to(world(x,y+2)->reportingConstruction());
+                            world(x, y+1)->addFlags(FLAG_POWER_CABLES_0);
                             mask |=1;
                         }
                     }
                     else
                     {
-                        cstr->link_to(world(x,y+1)->reportingConstruction);
+                        cstr->link_to(world(x,y+1)->reportingConstruction());
                         mask |=1;
                     }
                 }
                 else
-                {   world(x, y+1)->flags &= ~FLAG_POWER_CABLES_0;}
+                {   world(x, y+1)->clearFlags(FLAG_POWER_CABLES_0);}
 
                 *frame = power_table[mask];
                 break;
@@ -258,7 +258,7 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                          check_group(x, y-1) == GROUP_TRACK)
                 {
                     railConstructionGroup.placeItem(x,y);
-                    cstr = world(x,y)->construction;
+                    cstr = world(x,y)->construction();
                     frame = &(cstr->frameIt->frame);
                     *frame = 21;
                     //rewind the loops
@@ -276,7 +276,7 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                          check_group(x-1, y) == GROUP_TRACK)
                 {
                     railConstructionGroup.placeItem(x,y);
-                    cstr = world(x,y)->construction;
+                    cstr = world(x,y)->construction();
                     frame = &(cstr->frameIt->frame);
                     *frame = 22;
                     //rewind the loops
@@ -293,12 +293,12 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                 if (*frame >= 11 && *frame <= 12)
                 {
                     cstr->flags |= FLAG_TRANSPARENT;
-                    world(x,y)->flags &= (~FLAG_INVISIBLE);
+                    world(x,y)->clearFlags(FLAG_INVISIBLE);
                 }
                 else
                 {
                    cstr->flags &= (~FLAG_TRANSPARENT);
-                   world(x,y)->flags |= FLAG_INVISIBLE;
+                   world(x,y)->addFlags(FLAG_INVISIBLE);
                 }
                 break;
 
@@ -319,7 +319,7 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                 else //a lonely bridge tile
                 {   *frame = 1;}
                 cstr->flags |= FLAG_TRANSPARENT;
-                world(x,y)->flags &= (~FLAG_INVISIBLE);
+                world(x,y)->clearFlags(FLAG_INVISIBLE);
                 break;
 
             case GROUP_ROAD:
@@ -408,7 +408,7 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                          check_group(x, y-1) == GROUP_ROAD)
                 {
                     railConstructionGroup.placeItem(x,y);
-                    cstr = world(x,y)->construction;
+                    cstr = world(x,y)->construction();
                     frame = &(cstr->frameIt->frame);
                     *frame = 23;
                     //rewind the loops
@@ -425,7 +425,7 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                          check_group(x-1, y) == GROUP_ROAD)
                 {
                     railConstructionGroup.placeItem(x,y);
-                    cstr = world(x,y)->construction;
+                    cstr = world(x,y)->construction();
                     frame = &(cstr->frameIt->frame);
                     *frame = 24;
                     //rewind the loops
@@ -441,12 +441,12 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                 if(*frame >= 11 && *frame <= 16)
                 {
                     cstr->flags |= FLAG_TRANSPARENT;
-                    world(x,y)->flags &= (~FLAG_INVISIBLE);
+                    world(x,y)->clearFlags(FLAG_INVISIBLE);
                 }
                 else
                 {
                    cstr->flags &= (~FLAG_TRANSPARENT);
-                   world(x,y)->flags |= FLAG_INVISIBLE;
+                   world(x,y)->addFlags(FLAG_INVISIBLE);
                 }
                 break;
 
@@ -548,12 +548,12 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                 if(*frame >= 11 && *frame <= 16)
                 {
                     cstr->flags |= FLAG_TRANSPARENT;
-                    world(x,y)->flags &= (~FLAG_INVISIBLE);
+                    world(x,y)->clearFlags(FLAG_INVISIBLE);
                 }
                 else
                 {
                        cstr->flags &= (~FLAG_TRANSPARENT);
-                       world(x,y)->flags |= FLAG_INVISIBLE;
+                       world(x,y)->addFlags(FLAG_INVISIBLE);
                 }
                 break;
 
@@ -568,7 +568,7 @@ void connect_transport(int originx, int originy, int lastx, int lasty)
                 else
                 {   *frame = 1;}
                 cstr->flags |= FLAG_TRANSPARENT;
-                world(x,y)->flags &= (~FLAG_INVISIBLE);
+                world(x,y)->clearFlags(FLAG_INVISIBLE);
                 break;
             }                   /* end switch */
         }                       /* end for y*/
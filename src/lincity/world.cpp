@@ -13,7 +13,9 @@
 
 World::World(int map_len)
 {
-    maptile.resize(map_len * map_len);
+    side_len = map_len;
+    generation = 0;
+    resizeLayers(map_len);
     dirty = false;
     world.climate = -1;
     world.old_setup_ground = -1;
@@ -22,44 +24,56 @@ World::World(int map_len)
 
 World::~World()
 {
-    maptile.clear();
+    releaseTiles();
 }
 
-
-void World::len(int new_len)
+void World::releaseTiles()
 {
-    if (new_len < 50)
-    {   new_len = 50;}
-    if (dirty) {clear_game();}
-    bool job_done = false;
-
-    while (!job_done)
+    const int area = side_len * side_len;
+    for (int index = 0; index < area; ++index)
     {
-        try
-        {
-            this->side_len = new_len;
-            job_done = true;
-            maptile.resize(new_len * new_len);
-        }
-        catch(...)
+        //Here the order matters
+        MapTile tile(index);
+        if (tile.construction())
         {
-            new_len -= 25;
-            std::cout << "failed to allocate world. shrinking edge to " << new_len << " tiles" << std::endl;
-            job_done = false;
-            if (new_len < 50) //Ok we give up, but should crash very soon anyways.
-            {   return;}
+            delete tile.construction();
+            tile.setConstruction(NULL);
         }
+        tile.clearframes();
     }
 }
 
-MapTile* World::operator()(int x, int y)
+void World::resizeLayers(int new_len)
 {
-    return &(maptile[x + y * side_len]);
+    const int area = new_len * new_len;
+    flaglayer.resize(area);
+    terrainlayer.resize(area);
+    pollutionlayer.resize(area);
+    constructionlayer.resize(area);
+    reportinglayer.resize(area);
+    framelayer.resize(area);
+    reservelayer.resize(area);
+    groundlayer.resize(area);
+    stamplayer.resize(area);
+    chunkstamps.assign((area + ChunkedLayer<int>::CHUNK_MASK) >> ChunkedLayer<int>::CHUNK_SHIFT, 0);
+    cleared = ++generation;
 }
 
-MapTile* World::operator()(int index)
+void World::clear()
 {
-    return &(maptile[index]);
+    releaseTiles();
+    resizeLayers(side_len);
+}
+
+void World::len(int new_len)
+{
+    if (new_len < 50)
+    {   new_len = 50;}
+    if (dirty) {clear_game();}
+    releaseTiles();
+    //chunks of tiles are only allocated once written
+    side_len = new_len;
+    resizeLayers(new_len);
 }
 
 bool World::is_inside(int x, int y)
@@ -92,19 +106,39 @@ bool World::is_visible(int x, int y)
     return (x > 0 && y > 0 && x < side_len-1 && y < side_len -1);
 }
 
-int World::map_x(MapTile * tile)
+int World::map_x(MapTile tile)
+{
+    return tile.index % side_len;
+}
+
+int World::map_y(MapTile tile)
 {
-    return (tile-&maptile[0]) % side_len;
+    return tile.index / side_len;
 }
 
-int World::map_y(MapTile * tile)
+int World::map_index(MapTile tile)
 {
-    return (tile-&maptile[0]) / side_len;
+    return tile.index;
 }
 
-int World::map_index(MapTile * tile)
+const Ground* World::ground(int x, int y)
 {
-    return (tile-&maptile[0]);
+    return &groundlayer[x + y * side_len];
+}
+
+const Ground* World::ground(int index)
+{
+    return &groundlayer[index];
+}
+
+Ground* World::pokeGround(int x, int y)
+{
+    return &groundlayer.poke(x + y * side_len);
+}
+
+Ground* World::pokeGround(int index)
+{
+    return &groundlayer.poke(index);
 }
 
 int World::len()
@@ -128,39 +162,39 @@ void World::seed( int new_seed)
 
 bool World::maximum(int x , int y)
 {
-    int alt = maptile[x + y * side_len].ground.altitude;
+    int alt = groundlayer[x + y * side_len].altitude;
     bool is_max = true;
     for (int i=0; i<8; i++)
     {
         int tx = x + dxo[i];
         int ty = y + dyo[i];
-        is_max &= (alt >= maptile[tx + ty * side_len].ground.altitude);
+        is_max &= (alt >= groundlayer[tx + ty * side_len].altitude);
     }
     return is_max;
 }
 
 bool World::minimum(int x , int y)
 {
-    int alt = maptile[x + y * side_len].ground.altitude;
+    int alt = groundlayer[x + y * side_len].altitude;
     bool is_min = true;
     for (int i=0; i<8; i++)
     {
         int tx = x + dxo[i];
         int ty = y + dyo[i];
-        is_min &= (alt <= maptile[tx + ty * side_len].ground.altitude);
+        is_min &= (alt <= groundlayer[tx + ty * side_len].altitude);
     }
     return is_min;
 }
 
 bool World::saddlepoint(int x , int y)
 {
-    int alt = maptile[x + y * side_len].ground.altitude;
+    int alt = groundlayer[x + y * side_len].altitude;
     int dips = 0;
-    bool dip_new = alt > maptile[x + dxo[7] + (y + dyo[7])*side_len ].ground.altitude;
+    bool dip_new = alt > groundlayer[x + dxo[7] + (y + dyo[7]) * side_len].altitude;
     bool dip_old = dip_new;
     for (int i=0; i<8; i++)
     {
-        dip_new = alt > maptile[x + dxo[i]+ (y + dyo[i])*side_len].ground.altitude;
+        dip_new = alt > groundlayer[x + dxo[i] + (y + dyo[i]) * side_len].altitude;
         if (dip_new && !dip_old) //We just stepped into a valley
         {
                 dips++;
@@ -172,27 +206,47 @@ bool World::saddlepoint(int x , int y)
 
 bool World::checkEdgeMin(int x , int y)
 {
-    int alt = maptile[x + y * side_len].ground.altitude;
+    int alt = groundlayer[x + y * side_len].altitude;
     if (x==1 || x == side_len-2)
     {
-        return alt < maptile[x+1 + y * side_len].ground.altitude
-            && alt < maptile[x-1 + y * side_len].ground.altitude;
+        return alt < groundlayer[x+1 + y * side_len].altitude
+            && alt < groundlayer[x-1 + y * side_len].altitude;
     }
     else if (y==1 || y == side_len-2)
     {
-        return alt < maptile[x + (y+1) * side_len].ground.altitude
-            && alt < maptile[x + (y-1) * side_len].ground.altitude;
+        return alt < groundlayer[x + (y+1) * side_len].altitude
+            && alt < groundlayer[x + (y-1) * side_len].altitude;
     }
     else
         return false;
 }
 
+int World::nextChanged(int index, int since)
+{
+    const int area = side_len * side_len;
+    if (since <= cleared)
+    {   return index < area ? index : area;}
+    while (index < area)
+    {
+        int chunk = index >> ChunkedLayer<int>::CHUNK_SHIFT;
+        if (chunkstamps[chunk] < since)
+        {
+            index = (chunk + 1) << ChunkedLayer<int>::CHUNK_SHIFT;
+            continue;
+        }
+        if (stamplayer[index] >= since)
+        {   return index;}
+        ++index;
+    }
+    return area;
+}
+
 int World::count_altered(void)
 {
     int count = 0;
-    for (size_t i = 0; i < maptile.size(); ++i)
+    for (int i = 0; i < side_len * side_len; ++i)
     {
-        if(maptile[i].flags & FLAG_ALTERED)
+        if(flaglayer[i] & FLAG_ALTERED)
         {   ++count;}
     }
     return count;
@@ -6,7 +6,6 @@
 #ifndef __world_h__
 #define __world_h__
 
-#include "lintypes.h"
 #include <vector>
 #include <deque>
 #include <set>
@@ -53,26 +52,102 @@ protected:
     int lenx, leny;
     std::vector<T> matrix;
 };
+//ChunkedLayer holds one item per tile, indexed like the tiles, in chunks of
+//CHUNK_AREA consecutive items. Chunks are only allocated when an item in
+//them is first written, until then they share one chunk of zeroes, so
+//blank parts of the map cost nothing. Only the last chunk is trimmed.
+template <class T>
+class ChunkedLayer
+{
+public:
+    enum { CHUNK_SHIFT = 12, CHUNK_AREA = 1 << CHUNK_SHIFT, CHUNK_MASK = CHUNK_AREA - 1 };
+
+    ChunkedLayer()
+    {   area = 0;}
+    ~ChunkedLayer()
+    {   release();}
+    //drops all items, every item reads zero until written again
+    void resize(int new_area)
+    {
+        release();
+        chunks.resize((new_area + CHUNK_MASK) >> CHUNK_SHIFT, zeroes());
+        area = new_area;
+    }
+    //reads never allocate
+    const T& operator[](int index) const
+    {   return chunks[index >> CHUNK_SHIFT][index & CHUNK_MASK];}
+    //for writing, allocates the chunk of index on first use, may throw bad_alloc
+    T& poke(int index)
+    {
+        T *&chunk = chunks[index >> CHUNK_SHIFT];
+        if (chunk == zeroes())
+        {
+            int n = area - (index & ~CHUNK_MASK);
+            chunk = new T[n < CHUNK_AREA ? n : CHUNK_AREA]();
+        }
+        return chunk[index & CHUNK_MASK];
+    }
+
+private:
+    ChunkedLayer(const ChunkedLayer&);
+    ChunkedLayer& operator=(const ChunkedLayer&);
+    static T* zeroes()
+    {
+        static T items[CHUNK_AREA];
+        return items;
+    }
+    void release()
+    {
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            if (chunks[i] != zeroes())
+            {   delete[] chunks[i];}
+        }
+        chunks.clear();
+        area = 0;
+    }
+    int area;
+    std::vector<T*> chunks;
+};
 
 
 class MapTile;
+class Ground;
+class Construction;
+class ExtraFrameList;
+
+struct Terrain
+{
+    unsigned short type;
+    unsigned short group;
+};
+
+struct Reserves
+{
+    unsigned short coal;
+    unsigned short ore;
+};
 
 class World
 {
 public:
     World(int map_len);
     ~World();
-    MapTile* operator()(int x, int y);
-    MapTile* operator()(int index);
+    MapTile operator()(int x, int y);
+    MapTile operator()(int index);
     bool is_inside(int x, int y);
     bool is_inside(int index);
     bool is_border(int x, int y);
     bool is_border(int index);
     bool is_edge(int x, int y);
     bool is_visible(int x, int y);
-    int map_x(MapTile *tile);// returns x
-    int map_y(MapTile *tile);// returns y
-    int map_index(MapTile *tile);// returns index
+    int map_x(MapTile tile);// returns x
+    int map_y(MapTile tile);// returns y
+    int map_index(MapTile tile);// returns index
+    const Ground* ground(int x, int y); //reading never allocates
+    const Ground* ground(int index);
+    Ground* pokeGround(int x, int y);   //for writers, allocates its chunk
+    Ground* pokeGround(int index);
     int len(void); //tells the actual world.side_len
     void len(int new_len); //resizes the world by edge
     bool maximum(int x , int y);
@@ -80,6 +155,15 @@ public:
     bool saddlepoint(int x , int y);
     bool checkEdgeMin(int x , int y);
     int count_altered();
+    void clear(); //deletes constructions and overlays, all tiles turn bare green
+    //Change stamps: the setters of MapTile stamp the tiles they change with
+    //the current generation, the ground and the overlays are not stamped.
+    //A reader keeps what nextGeneration() returned when it last looked and
+    //walks the tiles changed since with nextChanged(). After a reset of the
+    //layers every tile counts as changed.
+    int nextGeneration()
+    {   return ++generation;}
+    int nextChanged(int index, int since); //first changed index from index on, area if none
     bool dirty;
     int seed(void); //tells recreation seed
     void seed(int new_seed); //sets the seed
@@ -91,9 +175,40 @@ public:
 protected:
     int id;
     int side_len;
-    std::vector<MapTile> maptile;
+    //The fields of the tiles, a layer each and all indexed alike, so a
+    //sweep over the map only reads the fields it needs. MapTile is the
+    //index into them.
+    ChunkedLayer<int> flaglayer;
+    ChunkedLayer<Terrain> terrainlayer;
+    ChunkedLayer<int> pollutionlayer;
+    ChunkedLayer<Construction*> constructionlayer;
+    ChunkedLayer<Construction*> reportinglayer;
+    ChunkedLayer<ExtraFrameList*> framelayer;
+    ChunkedLayer<Reserves> reservelayer;
+    ChunkedLayer<Ground> groundlayer;
+    ChunkedLayer<int> stamplayer;
+    std::vector<int> chunkstamps;   //newest stamp in every chunk of stamplayer
+    int generation;
+    int cleared;                    //generation of the last reset
+    void touch(int index)
+    {
+        stamplayer.poke(index) = generation;
+        chunkstamps[index >> ChunkedLayer<int>::CHUNK_SHIFT] = generation;
+    }
+    friend class MapTile;
+
+private:
+    World(const World&);
+    World& operator=(const World&);
+    void releaseTiles();            //deletes what is left of constructions and overlays
+    void resizeLayers(int new_len); //may throw bad_alloc
 };
 
+extern World world;
+
+//MapTile is defined after World and reaches into its layers
+#include "lintypes.h"
+
 
 
 
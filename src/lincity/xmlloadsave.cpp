@@ -1,5 +1,7 @@
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
+#include <algorithm>
 #include "gui_interface/shared_globals.h"
 #include "gui_interface/pbar_interface.h"
 #include "fileutil.h"
@@ -9,6 +11,7 @@
 #include "xmlloadsave.h"
 #include "engglobs.h"
 #include "init_game.h"
+#include "Profiler.h"
 
 std::map <std::string, XMLTemplate*> xml_template_libary;
 std::map <unsigned short, XMLTemplate*> bin_template_libary;
@@ -85,12 +88,10 @@ std::string const & XMLTemplate::getTag()
     return tag_sequence[cur_index];
 }
 
-/*
 size_t XMLTemplate::getNumChars()
 {
     return binlen_sequence[cur_index];
 }
-*/
 
 void XMLTemplate::fillLine(std::string *entry)
 {
@@ -119,6 +120,14 @@ bool XMLTemplate::reached_end()
 void XMLTemplate::putTag(std::string const &xml_tag)
 {
     tag_sequence.push_back(xml_tag);
+    binlen_sequence.push_back(0);
+}
+
+void XMLTemplate::putTag(std::string const &xml_tag, size_t chunk)
+{
+    tag_sequence.push_back(xml_tag);
+    binlen_sequence.push_back(chunk);
+    char_len += chunk;
 }
 
 void XMLTemplate::putVal(std::string const &xml_val)
@@ -139,6 +148,11 @@ bool XMLTemplate::validate()
 XMLloadsave::XMLloadsave()
 {
     cur_template = NULL;
+    buffer_out = NULL;
+    buffer_layout = NULL;
+    buffer_since = 0;
+    buffer_in = NULL;
+    buffer_pos = 0;
     line.clear();
     xml_tag.clear();
     xml_val.clear();
@@ -198,6 +212,7 @@ void XMLloadsave::fillXMLlibary()
 
 int XMLloadsave::saveXMLfile(std::string xml_file_name)
 {
+    PROFILE_ZONE("XMLloadsave::saveXMLfile");
     std::string gz_name;
     gz_xml_file = gzopen(xml_file_name.c_str(), "wb");
 
@@ -208,6 +223,33 @@ int XMLloadsave::saveXMLfile(std::string xml_file_name)
     }
     std::cout << "gz saving " << xml_file_name << " ... ";
     std::cout.flush();
+    saveXML();
+    gzclose(gz_xml_file);
+    std::cout << "done" << std::endl;
+    return 0;
+}
+
+int XMLloadsave::saveXMLbuffer(std::string &buffer, SaveLayout *layout, int since)
+{
+    PROFILE_ZONE("XMLloadsave::saveXMLbuffer");
+    buffer.clear();
+    buffer_out = &buffer;
+    buffer_layout = layout;
+    buffer_since = since;
+    if (layout)
+    {
+        layout->tiles.clear();
+        layout->constructions.clear();
+    }
+    saveXML();
+    buffer_out = NULL;
+    buffer_layout = NULL;
+    buffer_since = 0;
+    return 0;
+}
+
+void XMLloadsave::saveXML()
+{
     clearXMLlibary();
     xml_file_out.str("");
     ldsv_version = XML_LOADSAVE_VERSION;
@@ -228,14 +270,12 @@ int XMLloadsave::saveXMLfile(std::string xml_file_name)
     saveConstructions();
     xml_file_out<<"</SaveGame>"<<std::endl;
     flush_gz_output();
-    gzclose(gz_xml_file);
     clearXMLlibary();
-    std::cout << "done" << std::endl;
-    return 0;
 }
 
 int XMLloadsave::loadXMLfile(std::string xml_file_name)
 {
+    PROFILE_ZONE("XMLloadsave::loadXMLfile");
     //std::string gz_name;
     //xml_file_in.open (xml_file_name.c_str(), std::fstream::in);
     //gz_name = xml_file_name;//+=".gz";
@@ -249,11 +289,31 @@ int XMLloadsave::loadXMLfile(std::string xml_file_name)
 
     std::cout << "gz loading " << xml_file_name << " ... ";
     std::cout.flush();
+    int r = loadXML();
+    gzclose(gz_xml_file);
+    if (r == 0)
+    {   std::cout << "done" << std::endl;}
+    return r;
+}
+
+int XMLloadsave::loadXMLbuffer(const std::string &buffer)
+{
+    PROFILE_ZONE("XMLloadsave::loadXMLbuffer");
+    buffer_in = &buffer;
+    buffer_pos = 0;
+    int r = loadXML();
+    buffer_in = NULL;
+    return r;
+}
+
+int XMLloadsave::loadXML()
+{
     clearXMLlibary();
     globalCount = 0;
     mapTileCount = 0;
     memberCount = 0;
     constructionCount = 0;
+    loadedConstructions.clear();
     globalSection = false;
     mapTileSection = false;
     constructionSection = false;
@@ -261,7 +321,7 @@ int XMLloadsave::loadXMLfile(std::string xml_file_name)
     templateDefinition = false;
     templateSection = false;
 
-    while (/*!xml_file_in.eof() &&*/ !gzeof(gz_xml_file))
+    while (/*!xml_file_in.eof() &&*/ !at_end())
     {
         //std::getline(xml_file_in, line);
 
@@ -350,11 +410,10 @@ int XMLloadsave::loadXMLfile(std::string xml_file_name)
                 get_raw_line();//eat extra newline in binary modes
                 //std::cout << "loaded binary constructions" << std::endl;
             }
+            placeConstructions();
             constructionSection = false;
         }
     }
-    gzclose(gz_xml_file);
-    std::cout << "done" << std::endl;
     //std::cout << "read " << globalCount << " global vars from XML" << std::endl;
     if (!seed_compression && (mapTileCount != world.len() * world.len()) )
     {   std::cout << "Warning number of MapTiles ("<<mapTileCount<<") and world_side_len² ("<< world.len() <<")² dont match" << std::endl;}
@@ -369,7 +428,7 @@ void XMLloadsave::readTemplateSection()
 {
     do
     {   get_interpreted_line();}
-    while (line!="</TemplateSection>" && !gzeof(gz_xml_file));
+    while (line!="</TemplateSection>" && !at_end());
 }
 
 
@@ -419,17 +478,26 @@ void XMLloadsave::loadTemplateValues()
 void XMLloadsave::saveConstructions()
 {
     xml_file_out<<"<ConstructionSection>"<<std::endl;
+    flush_gz_output();
+    if (buffer_layout)
+    {   buffer_layout->constructionsBegin = buffer_out->size();}
     ::constructionCount.sort();
     for (int i = 0; i < ::constructionCount.size(); i++)
     {
         //use pos() here because we dont want them shuffeled
-        if (::constructionCount.pos(i))
+        Construction *cst = ::constructionCount.pos(i);
+        if (cst)
         {
             //we dont save ghosts like temporary fires on transport
-            if(::constructionCount.pos(i)->flags & FLAG_IS_GHOST)
+            if(cst->flags & FLAG_IS_GHOST)
             {   continue;}
-            ::constructionCount.pos(i)->saveMembers(&xml_file_out);
+            cst->saveMembers(&xml_file_out);
             flush_gz_output();
+            if (buffer_layout)
+            {
+                SaveRecord record = {cst->x + cst->y * world.len(), buffer_out->size()};
+                buffer_layout->constructions.push_back(record);
+            }
         }
     }
     if (binary_mode)
@@ -475,7 +543,7 @@ void XMLloadsave::loadConstructions()
         if ( !prescan && inside_construction )
         {
             if (r == 2 && xml_val.length())
-            {   memberCount += world(x,y)->construction->loadMember(xml_tag, xml_val);}
+            {   memberCount += world(x,y)->construction()->loadMember(xml_tag, xml_val);}
         }
         if (inside_construction && line == "</Construction>")
         {
@@ -486,7 +554,7 @@ void XMLloadsave::loadConstructions()
                     constructionCount++;
                     //std::cout << "placing " << main_groups[group].name << " as " <<main_groups[get_group_of_type(type)].name << "...";
                     std::cout.flush();
-                    ConstructionGroup::getConstructionGroup(group)->placeItem(x, y);
+                    createConstruction(group, x, y);
                     //std::cout << "ok" <<std::endl;
                     rewind();
                     prescan = false;
@@ -506,11 +574,78 @@ void XMLloadsave::loadConstructions()
             group = NOT_SET;
         }
     }
-    while (line!="</ConstructionSection>" && /*!xml_file_in.eof() &&*/ !gzeof(gz_xml_file));
+    while (line!="</ConstructionSection>" && /*!xml_file_in.eof() &&*/ !at_end());
     //constructionSection = false;
 }
 
 
+void
+XMLloadsave::createConstruction(unsigned short group, int x, int y)
+{
+    ConstructionGroup *constructionGroup = ConstructionGroup::getConstructionGroup(group);
+    //the site is already taken by something that was not loaded from this file
+    for (unsigned short i = 0; i < constructionGroup->size; i++)
+    {
+        for (unsigned short j = 0; j < constructionGroup->size; j++)
+        {
+            if (world.is_inside(x + j, y + i) && world(x + j, y + i)->reportingConstruction())
+            {
+                constructionGroup->placeItem(x, y);
+                return;
+            }
+        }
+    }
+    //like placeItem, a later construction replaces an earlier one at the same place
+    Construction *old = world(x,y)->construction();
+    if (old)
+    {
+        std::vector<Construction *>::iterator it =
+            std::find(loadedConstructions.begin(), loadedConstructions.end(), old);
+        if (it != loadedConstructions.end())
+        {   loadedConstructions.erase(it);}
+        world(x,y)->killframe(old->frameIt);
+        delete old;
+    }
+    //only the construction itself is made, surroundings are settled in placeConstructions()
+    Construction *cst = constructionGroup->createConstruction(x, y);
+    world(x,y)->setConstruction(cst);
+    loadedConstructions.push_back(cst);
+}
+
+static bool map_order(Construction *a, Construction *b)
+{
+    return (a->y < b->y) || (a->y == b->y && a->x < b->x);
+}
+
+void
+XMLloadsave::placeConstructions()
+{
+    //placing row by row keeps the tiles looked at by neighborize() in cache
+    std::sort(loadedConstructions.begin(), loadedConstructions.end(), map_order);
+    for (size_t n = 0; n < loadedConstructions.size(); ++n)
+    {
+        Construction *cst = loadedConstructions[n];
+        int size = cst->constructionGroup->size;
+        bool overlap = false;
+        for (int i = 0; i < size && !overlap; i++)
+        {
+            for (int j = 0; j < size && !overlap; j++)
+            {   overlap = world(cst->x + j, cst->y + i)->reportingConstruction();}
+        }
+        if (overlap)
+        {
+            std::cout << "dropping overlapping " << cst->constructionGroup->name
+            << " at " << cst->x << ", " << cst->y << std::endl;
+            world(cst->x, cst->y)->killframe(cst->frameIt);
+            world(cst->x, cst->y)->setConstruction(NULL);
+            delete cst;
+            continue;
+        }
+        cst->constructionGroup->placeConstruction(cst);
+    }
+    loadedConstructions.clear();
+}
+
 void
 XMLloadsave::loadTileTemplates()
 {
@@ -522,15 +657,20 @@ XMLloadsave::loadTileTemplates()
     int last_i = seed_compression?altered_tiles:area;
     for(int i=0; i<last_i; ++i)
     {
-        gzread(gz_xml_file, (char *)&head, sizeof(head));
-        gzread(gz_xml_file, (char *)&group, sizeof(group));
-        gzread(gz_xml_file, (char *)&type, sizeof(type));
-        gzread(gz_xml_file, (char *)&idx, sizeof(idx));
+        read((char *)&head, sizeof(head));
+        read((char *)&group, sizeof(group));
+        read((char *)&type, sizeof(type));
+        read((char *)&idx, sizeof(idx));
 
         cur_template->rewind();
-        MapTile *cur_tile = world(idx);
-        cur_tile->group = group;
-        cur_tile->type = type;
+        MapTile cur_tile = world(idx);
+        Ground *cur_ground = world.pokeGround(idx);
+        cur_tile->setGroup(group);
+        cur_tile->setType(type);
+        int flags = 0;
+        int pollution = 0;
+        unsigned short ore_reserve = 0;
+        unsigned short coal_reserve = 0;
         size_t cm = 0;
         while(!cur_template->reached_end())
         {
@@ -538,23 +678,23 @@ XMLloadsave::loadTileTemplates()
             //size_t len = cur_template->getNumChars();
 
             //mapTile
-            if (xml_tag == "flags")                  {cm += gzread(gz_xml_file, (char*)&cur_tile->flags, sizeof( cur_tile->flags));}
-            else if (xml_tag == "air_pol")           {cm += gzread(gz_xml_file, (char*)&cur_tile->pollution,  sizeof( cur_tile->pollution ));}
-            else if (xml_tag == "ore")               {cm += gzread(gz_xml_file, (char*)&cur_tile->ore_reserve,  sizeof( cur_tile->ore_reserve ));}
-            else if (xml_tag == "coal")              {cm += gzread(gz_xml_file, (char*)&cur_tile->coal_reserve,  sizeof( cur_tile->coal_reserve ));}
+            if (xml_tag == "flags")                  {cm += read((char*)&flags, sizeof( flags));}
+            else if (xml_tag == "air_pol")           {cm += read((char*)&pollution,  sizeof( pollution ));}
+            else if (xml_tag == "ore")               {cm += read((char*)&ore_reserve,  sizeof( ore_reserve ));}
+            else if (xml_tag == "coal")              {cm += read((char*)&coal_reserve,  sizeof( coal_reserve ));}
             //ground
-            else if (xml_tag == "altitude")          {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.altitude, sizeof( cur_tile->ground.altitude ));}
-            else if (xml_tag == "ecotable")          {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.ecotable, sizeof( cur_tile->ground.ecotable ));}
-            else if (xml_tag == "wastes")            {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.wastes, sizeof( cur_tile->ground.wastes ));}
-            else if (xml_tag == "grd_pol")           {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.pollution, sizeof( cur_tile->ground.pollution ));}
-            else if (xml_tag == "water_alt")         {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.water_alt, sizeof( cur_tile->ground.water_alt ));}
-            else if (xml_tag == "water_pol")         {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.water_pol, sizeof( cur_tile->ground.water_pol ));}
-            else if (xml_tag == "water_wast")        {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.water_wast, sizeof( cur_tile->ground.water_wast ));}
-            else if (xml_tag == "water_next")        {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.water_next, sizeof( cur_tile->ground.water_next ));}
-            else if (xml_tag == "int1")              {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.int1, sizeof( cur_tile->ground.int1 ));}
-            else if (xml_tag == "int2")              {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.int2, sizeof( cur_tile->ground.int2 ));}
-            else if (xml_tag == "int3")              {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.int3, sizeof( cur_tile->ground.int3 ));}
-            else if (xml_tag == "int4")              {cm += gzread(gz_xml_file, (char*)&cur_tile->ground.int4, sizeof( cur_tile->ground.int4 ));}
+            else if (xml_tag == "altitude")          {cm += read((char*)&cur_ground->altitude, sizeof( cur_ground->altitude ));}
+            else if (xml_tag == "ecotable")          {cm += read((char*)&cur_ground->ecotable, sizeof( cur_ground->ecotable ));}
+            else if (xml_tag == "wastes")            {cm += read((char*)&cur_ground->wastes, sizeof( cur_ground->wastes ));}
+            else if (xml_tag == "grd_pol")           {cm += read((char*)&cur_ground->pollution, sizeof( cur_ground->pollution ));}
+            else if (xml_tag == "water_alt")         {cm += read((char*)&cur_ground->water_alt, sizeof( cur_ground->water_alt ));}
+            else if (xml_tag == "water_pol")         {cm += read((char*)&cur_ground->water_pol, sizeof( cur_ground->water_pol ));}
+            else if (xml_tag == "water_wast")        {cm += read((char*)&cur_ground->water_wast, sizeof( cur_ground->water_wast ));}
+            else if (xml_tag == "water_next")        {cm += read((char*)&cur_ground->water_next, sizeof( cur_ground->water_next ));}
+            else if (xml_tag == "int1")              {cm += read((char*)&cur_ground->int1, sizeof( cur_ground->int1 ));}
+            else if (xml_tag == "int2")              {cm += read((char*)&cur_ground->int2, sizeof( cur_ground->int2 ));}
+            else if (xml_tag == "int3")              {cm += read((char*)&cur_ground->int3, sizeof( cur_ground->int3 ));}
+            else if (xml_tag == "int4")              {cm += read((char*)&cur_ground->int4, sizeof( cur_ground->int4 ));}
             else
             {
                 std::cout<<"Invalid format while reading binary tiles "<<std::endl;
@@ -562,7 +702,10 @@ XMLloadsave::loadTileTemplates()
             cur_template->step();
         }
         //assert (cm == cur_template->len());
-        cur_tile->flags &= ~VOLATILE_FLAGS;
+        cur_tile->setFlags(flags & ~VOLATILE_FLAGS);
+        cur_tile->setPollution(pollution);
+        cur_tile->setOreReserve(ore_reserve);
+        cur_tile->setCoalReserve(coal_reserve);
         mapTileCount++;
     }
 }
@@ -574,20 +717,20 @@ XMLloadsave::loadConstructionTemplates()
     unsigned short group, head, type;
     int idx;
 
-    gzread(gz_xml_file, (char *)&head, sizeof(head));
-    gzread(gz_xml_file, (char *)&group, sizeof(group));
+    read((char *)&head, sizeof(head));
+    read((char *)&group, sizeof(group));
     if(ldsv_version < 1328)
-    {   gzread(gz_xml_file, (char *)&type, sizeof(type));}
-    gzread(gz_xml_file, (char *)&idx, sizeof(idx));
+    {   read((char *)&type, sizeof(type));}
+    read((char *)&idx, sizeof(idx));
     //std::cout << "binary construction header: " << group << " | " << type << " | " << idx << "...";
     //std::cout.flush();
     int x = idx % world.len();
     int y = idx / world.len();
     //std::cout << head << " aka " << group << " at " << x << ", " << y << std::endl;
-    ConstructionGroup::getConstructionGroup(head)->placeItem(x, y);
+    createConstruction(head, x, y);
     if (!bin_template_libary.count(head))
     {
-        world(x,y)->construction->writeTemplate();
+        world(x,y)->construction()->writeTemplate();
     }
     cur_template = bin_template_libary[head];
     //assert(cur_template);
@@ -596,7 +739,7 @@ XMLloadsave::loadConstructionTemplates()
     size_t cm = 0;
     while (!cur_template->reached_end())
     {
-        cm += world(x,y)->construction->readbinaryMember(cur_template->getTag(),gz_xml_file);
+        cm += world(x,y)->construction()->readbinaryMember(cur_template->getTag(), cur_template->getNumChars(), *this);
         cur_template->step();
     }
     //assert(cm = cur_template->len());
@@ -711,14 +854,8 @@ void XMLloadsave::saveGlobals()
     xml_file_out << "<sust_old_tech>"              << sust_old_tech            << "</sust_old_tech>" << std::endl;
     xml_file_out << "<sustain_flag>"               << sustain_flag             << "</sustain_flag>" << std::endl;
 
-    xml_file_out << "<monthgraph_size>"            << monthgraph_size          << "</monthgraph_size>" << std::endl;
-
-    writeArray("monthgraph_pop",      monthgraph_pop,     monthgraph_size);
-    writeArray("monthgraph_starve",   monthgraph_starve,  monthgraph_size);
-    writeArray("monthgraph_nojobs",   monthgraph_nojobs,  monthgraph_size);
-    writeArray("monthgraph_ppool",    monthgraph_ppool,   monthgraph_size);
-
     flush_gz_output();
+    writeStatsHistory();
     for (int p = 0; p < NUM_PBARS; p++)
     {
         std::ostringstream pbarname;
@@ -726,7 +863,10 @@ void XMLloadsave::saveGlobals()
         xml_file_out << "<ID>"     << p << "</ID>"                   << std::endl;
         xml_file_out << "<oldtot>" << pbars[p].oldtot << "</oldtot>" << std::endl;
         xml_file_out << "<diff>"   << pbars[p].diff   << "</diff>"   << std::endl;
-        writeArray("array", pbars[p].data, PBAR_DATA_SIZE);
+        int data[PBAR_DATA_SIZE];
+        for (int i = 0; i < PBAR_DATA_SIZE; i++)
+        {   data[i] = pbar_value(p, i);}
+        writeArray("array", data, PBAR_DATA_SIZE);
         xml_file_out << "</pbar>"                                    << std::endl;
         flush_gz_output();
     }
@@ -738,8 +878,9 @@ void XMLloadsave::saveGlobals()
 
 void XMLloadsave::loadGlobals()
 {
-    int r, monthgraph_size_in_file;
+    int r, monthgraph_size_in_file = 0;
     int new_world_len;
+    std::vector<int> monthgraph[MONTHGRAPH_COUNT]; //of saves before statsHistory
     binary_mode = false; //set save default for old files
     seed_compression = false; //set save default for old files
     do
@@ -871,15 +1012,17 @@ void XMLloadsave::loadGlobals()
         {
             globalCount++;
             if (xml_tag == "monthgraph_pop")
-            {    readArray(monthgraph_pop, monthgraph_size_in_file, monthgraph_size);}
+            {    readMonthgraph(monthgraph[MONTHGRAPH_POP], monthgraph_size_in_file);}
             else if (xml_tag == "monthgraph_starve")
-            {    readArray(monthgraph_starve, monthgraph_size_in_file, monthgraph_size);}
+            {    readMonthgraph(monthgraph[MONTHGRAPH_STARVE], monthgraph_size_in_file);}
             else if (xml_tag == "monthgraph_nojobs")
-            {    readArray(monthgraph_nojobs, monthgraph_size_in_file, monthgraph_size);}
+            {    readMonthgraph(monthgraph[MONTHGRAPH_NOJOBS], monthgraph_size_in_file);}
             else if (xml_tag == "monthgraph_ppool")
-            {    readArray(monthgraph_ppool, monthgraph_size_in_file, monthgraph_size);}
+            {    readMonthgraph(monthgraph[MONTHGRAPH_PPOOL], monthgraph_size_in_file);}
             else if (xml_tag == "pbar")
             {    readPbar();}
+            else if (xml_tag == "StatsHistory")
+            {    readStatsHistory();}
             else if (xml_tag == "Pollution")
             {    readPollution();}
             else
@@ -893,7 +1036,9 @@ void XMLloadsave::loadGlobals()
             std::cout << "Unknown XML closing " << line << " while reading <GlobalVariables>"<<std::endl;
         }
     }
-    while (line != "</GlobalVariables>" && !gzeof(gz_xml_file));
+    while (line != "</GlobalVariables>" && !at_end());
+    if (!statsHistory.count(StatsHistory::MONTHLY))
+    {   migrateMonthgraph(monthgraph);}
     ly_other_cost = ly_university_cost + ly_recycle_cost + ly_deaths_cost
         + ly_health_cost + ly_rocket_pad_cost + ly_school_cost
         + ly_interest + ly_windmill_cost + ly_fire_cost + ly_cricket_cost;
@@ -904,14 +1049,24 @@ void XMLloadsave::loadGlobals()
 void XMLloadsave::saveMapTiles()
 {
     xml_file_out << "<MapTileSection>" << std::endl;
+    flush_gz_output();
+    if (buffer_layout)
+    {   buffer_layout->tilesBegin = buffer_out->size();}
     const int len = world.len();
     const int area = len * len;
-    for (int index = 0; index<area; index++)
+    //every tile unless buffer_since asks for the changed ones
+    for (int index = world.nextChanged(0, buffer_since); index < area;
+        index = world.nextChanged(index + 1, buffer_since))
     {
-        if(!seed_compression || (world(index)->flags & FLAG_ALTERED))
+        if(!seed_compression || (world(index)->flags() & FLAG_ALTERED))
         {
             world(index)->saveMembers(&xml_file_out);
             flush_gz_output();
+            if (buffer_layout)
+            {
+                SaveRecord record = {index, buffer_out->size()};
+                buffer_layout->tiles.push_back(record);
+            }
         }
     }
     if (binary_mode)
@@ -924,8 +1079,11 @@ void XMLloadsave::loadMapTiles()
 {
     int x, y, r;
     unsigned int value;
+    int ival;
+    unsigned short sval;
     bool inside_MapTile;
-    MapTile *cur_tile = world(0);
+    MapTile cur_tile = world(0);
+    Ground *cur_ground = world.pokeGround(0);
 
     prescan = true;
     inside_MapTile = false;
@@ -959,25 +1117,25 @@ void XMLloadsave::loadMapTiles()
                 if (xml_tag == "map_x");//ignore map_x
                 else if (xml_tag == "map_y");//ignore map_y
                 //mapTile
-                else if (xml_tag == "flags")             {sscanf(xml_val.c_str(),"%d",&cur_tile->flags);}
-                else if (xml_tag == "type")              {sscanf(xml_val.c_str(),"%hu",&cur_tile->type);}
-                else if (xml_tag == "group")             {sscanf(xml_val.c_str(),"%hu",&cur_tile->group);}
-                else if (xml_tag == "air_pol")           {sscanf(xml_val.c_str(),"%d",&cur_tile->pollution);}
-                else if (xml_tag == "ore")               {sscanf(xml_val.c_str(),"%hu",&cur_tile->ore_reserve);}
-                else if (xml_tag == "coal")              {sscanf(xml_val.c_str(),"%hu",&cur_tile->coal_reserve);}
+                else if (xml_tag == "flags")             {if (sscanf(xml_val.c_str(),"%d",&ival) == 1) {cur_tile->setFlags(ival);}}
+                else if (xml_tag == "type")              {if (sscanf(xml_val.c_str(),"%hu",&sval) == 1) {cur_tile->setType(sval);}}
+                else if (xml_tag == "group")             {if (sscanf(xml_val.c_str(),"%hu",&sval) == 1) {cur_tile->setGroup(sval);}}
+                else if (xml_tag == "air_pol")           {if (sscanf(xml_val.c_str(),"%d",&ival) == 1) {cur_tile->setPollution(ival);}}
+                else if (xml_tag == "ore")               {if (sscanf(xml_val.c_str(),"%hu",&sval) == 1) {cur_tile->setOreReserve(sval);}}
+                else if (xml_tag == "coal")              {if (sscanf(xml_val.c_str(),"%hu",&sval) == 1) {cur_tile->setCoalReserve(sval);}}
                 //ground
-                else if (xml_tag == "altitude")          {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.altitude);}
-                else if (xml_tag == "ecotable")          {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.ecotable);}
-                else if (xml_tag == "wastes")            {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.wastes);}
-                else if (xml_tag == "grd_pol")           {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.pollution);}
-                else if (xml_tag == "water_alt")         {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.water_alt);}
-                else if (xml_tag == "water_pol")         {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.water_pol);}
-                else if (xml_tag == "water_wast")        {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.water_wast);}
-                else if (xml_tag == "water_next")        {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.water_next);}
-                else if (xml_tag == "int1")              {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.int1);}
-                else if (xml_tag == "int2")              {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.int2);}
-                else if (xml_tag == "int3")              {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.int3);}
-                else if (xml_tag == "int4")              {sscanf(xml_val.c_str(),"%d",&cur_tile->ground.int4);}
+                else if (xml_tag == "altitude")          {sscanf(xml_val.c_str(),"%d",&cur_ground->altitude);}
+                else if (xml_tag == "ecotable")          {sscanf(xml_val.c_str(),"%d",&cur_ground->ecotable);}
+                else if (xml_tag == "wastes")            {sscanf(xml_val.c_str(),"%d",&cur_ground->wastes);}
+                else if (xml_tag == "grd_pol")           {sscanf(xml_val.c_str(),"%d",&cur_ground->pollution);}
+                else if (xml_tag == "water_alt")         {sscanf(xml_val.c_str(),"%d",&cur_ground->water_alt);}
+                else if (xml_tag == "water_pol")         {sscanf(xml_val.c_str(),"%d",&cur_ground->water_pol);}
+                else if (xml_tag == "water_wast")        {sscanf(xml_val.c_str(),"%d",&cur_ground->water_wast);}
+                else if (xml_tag == "water_next")        {sscanf(xml_val.c_str(),"%d",&cur_ground->water_next);}
+                else if (xml_tag == "int1")              {sscanf(xml_val.c_str(),"%d",&cur_ground->int1);}
+                else if (xml_tag == "int2")              {sscanf(xml_val.c_str(),"%d",&cur_ground->int2);}
+                else if (xml_tag == "int3")              {sscanf(xml_val.c_str(),"%d",&cur_ground->int3);}
+                else if (xml_tag == "int4")              {sscanf(xml_val.c_str(),"%d",&cur_ground->int4);}
                 else
                 {
                     std::cout<<"Unknown XML entry "<< line << " while reading <MapTile>"<<std::endl;
@@ -996,10 +1154,11 @@ void XMLloadsave::loadMapTiles()
                 mapTileCount++;
                 rewind();
                 cur_tile = world(x, y);
+                cur_ground = world.pokeGround(x, y);
                 prescan = false;
                 continue;
             }
-            cur_tile->flags &= ~VOLATILE_FLAGS;
+            cur_tile->clearFlags(VOLATILE_FLAGS);
             interpreting_template = false;
             inside_MapTile = false;
             prescan = true;
@@ -1007,18 +1166,22 @@ void XMLloadsave::loadMapTiles()
             y = -1;
         }
     }
-    while (line != "</MapTileSection>" && !gzeof(gz_xml_file));
+    while (line != "</MapTileSection>" && !at_end());
 
     mapTileSection = false;
 }
 
-void XMLloadsave::writeArray(std::string aryname, int ary[], int len)
+void XMLloadsave::writeArray(std::string aryname, int ary[], int len, int per_line)
 {
     int i;
     xml_file_out << "<"<<aryname<<">" << std::endl;
     xml_file_out << "<int>";
     for (i=0;i<len;i++)
-    {   xml_file_out << ary[i] << "\t";}
+    {
+        if (per_line && i && i % per_line == 0)
+        {   xml_file_out << "</int>" << std::endl << "<int>";}
+        xml_file_out << ary[i] << "\t";
+    }
     xml_file_out << "</int>" << std::endl;
     xml_file_out << "</"<<aryname<<">" << std::endl;
     flush_gz_output();
@@ -1056,7 +1219,7 @@ void XMLloadsave::readArray(int ary[], int max_len, int len)
             return;
         }
     }
-    while (r == 2 && !gzeof(gz_xml_file)); //read as long as their a pairs of identical xmltags
+    while (r == 2 && !at_end()); //read as long as their a pairs of identical xmltags
     while (i < len)
     {
         //std::cout << 0;
@@ -1095,7 +1258,7 @@ void XMLloadsave::writePollution(void)
             xml_file_out << "</int>" << std::endl << "<int>";
             items = 0;
         }
-        xml_file_out << world(*it)->pollution << "\t";
+        xml_file_out << world(*it)->pollution() << "\t";
         ++items;
     }
     xml_file_out << "</int>" << std::endl;
@@ -1137,7 +1300,7 @@ void XMLloadsave::readPollution(void)
                 return;
             }
         }
-        while (r == 2 && !gzeof(gz_xml_file)); //read as long as there a pairs of identical xmltags
+        while (r == 2 && !at_end()); //read as long as there a pairs of identical xmltags
     }
     get_interpreted_line();
     r = sliceXMLline();
@@ -1154,8 +1317,9 @@ void XMLloadsave::readPollution(void)
                 {
                     pos = xml_val.find("\t");
                     val = xml_val.substr(0, pos);
-                    //int value = 0;
-                    sscanf(val.c_str(),"%d",&(world(*it++)->pollution));
+                    int value = world(*it)->pollution();
+                    sscanf(val.c_str(),"%d",&value);
+                    world(*it++)->setPollution(value);
                     xml_val.erase(0, pos);
                     xml_val.erase(0,1);
                 }
@@ -1168,7 +1332,7 @@ void XMLloadsave::readPollution(void)
             if(it == world.polluted.end() && (!xml_val.empty()))
             {   std::cout << "warning places and air_pollution dont match" << std::endl;}
         }
-        while (r == 2 && !gzeof(gz_xml_file)); //read as long as there a pairs of identical xmltags
+        while (r == 2 && !at_end()); //read as long as there a pairs of identical xmltags
     }
     get_interpreted_line();
     r = sliceXMLline();
@@ -1178,6 +1342,169 @@ void XMLloadsave::readPollution(void)
 
 
 
+//slots on a line of the history, short lines keep the changes of a day local
+#define STATS_PER_LINE 100
+
+void XMLloadsave::writeStatsHistory()
+{
+    xml_file_out << "<StatsHistory>" << std::endl;
+    xml_file_out << "<month_days>" << statsHistory.monthDays << "</month_days>" << std::endl;
+    xml_file_out << "<year_days>"  << statsHistory.yearDays  << "</year_days>"  << std::endl;
+    xml_file_out << "<month_sums>";
+    for (int c = 0; c < StatsHistory::COLUMN_COUNT; ++c)
+    {   xml_file_out << statsHistory.monthSums[c] << "\t";}
+    xml_file_out << "</month_sums>" << std::endl;
+    xml_file_out << "<year_sums>";
+    for (int c = 0; c < StatsHistory::COLUMN_COUNT; ++c)
+    {   xml_file_out << statsHistory.yearSums[c] << "\t";}
+    xml_file_out << "</year_sums>" << std::endl;
+    for (int r = 0; r < StatsHistory::RESOLUTION_COUNT; ++r)
+    {
+        StatsHistory::Series &series = statsHistory.series[r];
+        xml_file_out << "<series>" << std::endl;
+        xml_file_out << "<resolution>" << r                  << "</resolution>" << std::endl;
+        xml_file_out << "<capacity>"   << series.capacity()  << "</capacity>"   << std::endl;
+        xml_file_out << "<head>"       << series.head        << "</head>"       << std::endl;
+        xml_file_out << "<size>"       << series.size        << "</size>"       << std::endl;
+        writeArray("day", &series.days[0], series.capacity(), STATS_PER_LINE);
+        for (int c = 0; c < StatsHistory::COLUMN_COUNT; ++c)
+        {   writeArray(StatsHistory::columnName(c), &series.columns[c][0], series.capacity(), STATS_PER_LINE);}
+        xml_file_out << "</series>" << std::endl;
+    }
+    xml_file_out << "</StatsHistory>" << std::endl;
+    flush_gz_output();
+}
+
+void XMLloadsave::readMonthgraph(std::vector<int> &graph, int len)
+{
+    graph.assign(std::max(len, 0), 0);
+    if (len > 0)
+    {   readArray(&graph[0], len, len);}
+}
+
+//the graph was log scaled to 0..63, 10^5.3 at the top
+static int monthgraphValue(int y)
+{   return (y > 0) ? (int)(exp(y * 5.3 * log(10.) / 64) + 0.5) : 0;}
+
+void XMLloadsave::migrateMonthgraph(const std::vector<int> *monthgraph)
+{
+    size_t months = 0;
+    for (int g = 0; g < MONTHGRAPH_COUNT; ++g)
+    {   months = std::max(months, monthgraph[g].size());}
+    //slot 0 was the month that ended last
+    int lastDay = total_time - total_time % NUMOF_DAYS_IN_MONTH - 1;
+    for (int age = months - 1; age >= 0; --age)
+    {
+        int day = lastDay - age * NUMOF_DAYS_IN_MONTH;
+        if (day < 0)
+        {   continue;}
+        int y[MONTHGRAPH_COUNT];
+        for (int g = 0; g < MONTHGRAPH_COUNT; ++g)
+        {   y[g] = ((size_t)age < monthgraph[g].size()) ? monthgraph[g][age] : 0;}
+        int values[StatsHistory::COLUMN_COUNT] = {0};
+        values[StatsHistory::HOUSED] = monthgraphValue(y[MONTHGRAPH_POP]);
+        values[StatsHistory::STARVING] = monthgraphValue(y[MONTHGRAPH_STARVE]);
+        values[StatsHistory::UNEMPLOYED] = monthgraphValue(y[MONTHGRAPH_NOJOBS]);
+        //share of the people pool in 64ths of the population
+        int share = std::max(0, std::min(y[MONTHGRAPH_PPOOL], 63));
+        values[StatsHistory::PEOPLE_POOL] = values[StatsHistory::HOUSED] * share / (64 - share);
+        values[StatsHistory::POPULATION] = values[StatsHistory::HOUSED] + values[StatsHistory::PEOPLE_POOL];
+        statsHistory.series[StatsHistory::MONTHLY].push(day, values);
+    }
+}
+
+static void readSums(const std::string &val, long long *sums)
+{
+    std::istringstream in(val);
+    for (int c = 0; c < StatsHistory::COLUMN_COUNT && (in >> sums[c]); ++c) {}
+}
+
+void XMLloadsave::readStatsHistory()
+{
+    int r;
+    do
+    {
+        get_interpreted_line();
+        r = sliceXMLline();
+        if (r == 2)
+        {
+            if (xml_tag == "month_days")        {sscanf(xml_val.c_str(),"%d",&statsHistory.monthDays);}
+            else if (xml_tag == "year_days")    {sscanf(xml_val.c_str(),"%d",&statsHistory.yearDays);}
+            else if (xml_tag == "month_sums")   {readSums(xml_val, statsHistory.monthSums);}
+            else if (xml_tag == "year_sums")    {readSums(xml_val, statsHistory.yearSums);}
+            else
+            {   std::cout << "Unknown XML entry " << line << " while reading <StatsHistory>" << std::endl;}
+        }
+        else if (r == 1 && xml_tag == "series")
+        {   readStatsSeries();}
+    }
+    while (line != "</StatsHistory>" && !at_end());
+}
+
+void XMLloadsave::readStatsSeries()
+{
+    //read as saved, then pushed oldest first in case the capacity changed
+    StatsHistory::Series in;
+    int resolution = -1;
+    int capacity = 0;
+    in.head = 0;
+    in.size = 0;
+    int r;
+    do
+    {
+        get_interpreted_line();
+        r = sliceXMLline();
+        if (r == 2)
+        {
+            if (xml_tag == "resolution")    {sscanf(xml_val.c_str(),"%d",&resolution);}
+            else if (xml_tag == "capacity")
+            {
+                sscanf(xml_val.c_str(),"%d",&capacity);
+                capacity = std::max(capacity, 1);
+                in.days.assign(capacity, 0);
+                for (int c = 0; c < StatsHistory::COLUMN_COUNT; ++c)
+                {   in.columns[c].assign(capacity, 0);}
+            }
+            else if (xml_tag == "head")     {sscanf(xml_val.c_str(),"%d",&in.head);}
+            else if (xml_tag == "size")     {sscanf(xml_val.c_str(),"%d",&in.size);}
+        }
+        else if (r == 1 && capacity)
+        {
+            int *ary = 0;
+            if (xml_tag == "day")
+            {   ary = &in.days[0];}
+            for (int c = 0; c < StatsHistory::COLUMN_COUNT; ++c)
+            {
+                if (xml_tag == StatsHistory::columnName(c))
+                {   ary = &in.columns[c][0];}
+            }
+            if (ary)
+            {   readArray(ary, capacity, capacity);}
+            else
+            {   std::cout << "Unknown XML opening " << line << " while reading <series>" << std::endl;}
+        }
+    }
+    while (line != "</series>" && !at_end());
+
+    if (resolution < 0 || resolution >= StatsHistory::RESOLUTION_COUNT || !capacity
+        || in.head < 0 || in.head >= capacity || in.size < 0 || in.size > capacity)
+    {
+        std::cout << "Warning: stumbled across corrupted statistics history" << std::endl;
+        return;
+    }
+    StatsHistory::Series &series = statsHistory.series[resolution];
+    series.head = 0;
+    series.size = 0;
+    int values[StatsHistory::COLUMN_COUNT];
+    for (int age = std::min(in.size, series.capacity()) - 1; age >= 0; --age)
+    {
+        int slot = in.slot(age);
+        for (int c = 0; c < StatsHistory::COLUMN_COUNT; ++c)
+        {   values[c] = in.columns[c][slot];}
+        series.push(in.days[slot], values);
+    }
+}
+
 void XMLloadsave::readPbar()
 {
     int r;
@@ -1215,10 +1542,11 @@ void XMLloadsave::readPbar()
         {
             //std::cout << "reading data of pbar" << ID <<std::endl;
             readArray(pbars[ID].data, PBAR_DATA_SIZE, PBAR_DATA_SIZE);
+            pbars[ID].first = 0;
             data_ok = true;
         }
     }
-    while (!((line == "</pbar>") &&/* !xml_file_in.eof() &&*/ !gzeof(gz_xml_file)));
+    while (!((line == "</pbar>") &&/* !xml_file_in.eof() &&*/ !at_end()));
     interpreting_template = false;
     if (!(data_ok && diff_ok && oldtot_ok && ID_ok))
         std::cout << "Warning: stumpled accross corrupted pbar" << std::endl;
@@ -1321,7 +1649,7 @@ int XMLloadsave::get_interpreted_line()
                 }
 
             }
-            while (line != "</Template>" &&/* !xml_file_in.eof() &&*/ !gzeof(gz_xml_file));
+            while (line != "</Template>" &&/* !xml_file_in.eof() &&*/ !at_end());
             templateDefinition = false;
         }
         else if ((r == 2) && xml_template_libary.count(xml_tag))
@@ -1364,7 +1692,7 @@ int XMLloadsave::get_interpreted_line()
                 }
             }
             while (  (xml_tag != "Construction") && (xml_tag != "MapTile") &&
-                    (xml_tag != "pbar" )  && !gzeof(gz_xml_file));
+                    (xml_tag != "pbar" )  && !at_end());
             cur_template->rewind();
             interpreting_template = true;
             //cur_template->validate();
@@ -1385,29 +1713,78 @@ void XMLloadsave::get_raw_line()
 {
     //std::cout << "get line: ";
     //std::cout.flush();
-    if (gzgets(gz_xml_file, buffer_line, sizeof(buffer_line)-1) != Z_NULL)
+    if (buffer_in)
     {
-        line = buffer_line;
-        if (!line.empty() && line[line.length()-1] == '\n')
+        if (buffer_pos < buffer_in->size())
         {
-            line.erase(line.length()-1);
-        }
-        if (!line.empty() && line[line.length()-1] == '\r')
-        {
-            line.erase(line.length()-1);
+            size_t end = buffer_in->find('\n', buffer_pos);
+            end = (end == std::string::npos) ? buffer_in->size() : end + 1;
+            line.assign(*buffer_in, buffer_pos, end - buffer_pos);
+            buffer_pos = end;
         }
+        else
+        {   line.clear();}
+    }
+    else if (gzgets(gz_xml_file, buffer_line, sizeof(buffer_line)-1) != Z_NULL)
+    {
+        line = buffer_line;
     }
     else
     {
         line.clear();
     }
+    if (!line.empty() && line[line.length()-1] == '\n')
+    {
+        line.erase(line.length()-1);
+    }
+    if (!line.empty() && line[line.length()-1] == '\r')
+    {
+        line.erase(line.length()-1);
+    }
+}
+
+int XMLloadsave::read(void *data, unsigned len)
+{
+    if (!buffer_in)
+    {   return gzread(gz_xml_file, data, len);}
+    if (len > buffer_in->size() - buffer_pos)
+    {   len = buffer_in->size() - buffer_pos;}
+    memcpy(data, buffer_in->data() + buffer_pos, len);
+    buffer_pos += len;
+    return len;
+}
+
+int XMLloadsave::skip(unsigned len)
+{
+    char chunk[64];
+    int done = 0;
+    while (len)
+    {
+        unsigned n = (len < sizeof(chunk)) ? len : sizeof(chunk);
+        int got = read(chunk, n);
+        if (got <= 0)
+        {   break;}
+        done += got;
+        len -= got;
+    }
+    return done;
+}
+
+bool XMLloadsave::at_end()
+{
+    if (buffer_in)
+    {   return buffer_pos >= buffer_in->size();}
+    return gzeof(gz_xml_file);
 }
 
 void XMLloadsave::flush_gz_output()
 {
     xml_file_out.flush();
     //std::cout << "flushing gz output: " << xml_file_out.str() ;
-    gzwrite(gz_xml_file, (char*)&(xml_file_out.str()[0]), xml_file_out.tellp());
+    if (buffer_out)
+    {   buffer_out->append(xml_file_out.str());}
+    else
+    {   gzwrite(gz_xml_file, (char*)&(xml_file_out.str()[0]), xml_file_out.tellp());}
     xml_file_out.str("");
     //xml_file_out.clear();
 }
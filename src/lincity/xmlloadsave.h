@@ -20,6 +20,7 @@
 #include <zlib.h>
 
 class XMLTemplate;
+class Construction;
 extern std::map <std::string, XMLTemplate*> xml_template_libary;
 extern std::map <unsigned short, XMLTemplate*> bin_template_libary;
 
@@ -32,10 +33,11 @@ public:
     void clearVal();                     //clears val_sequence
     std::string const &getTag();         //returns current xml_tag
     std::string const &getVal();         //returns current xml_val
-    //size_t getNumChars();                //returns the bytes in current entry
+    size_t getNumChars();                //returns the bytes in current entry, 0 if unknown
     void fillLine(std::string *line);    //writes xml formated entry to line
     int step();                          //increases cur_index and returns its new value
     void putTag(std::string const &xml_tag);    //appends another xml_tag to the tag_sequence
+    void putTag(std::string const &xml_tag, size_t chunk); //same for a binary member of chunk chars
     void putVal(std::string const &xml_val);    //appends another value to the val_sequence
     bool reached_end();                  //returns true after last tag has been got
     bool validate();                     //checks if cur_index == 0 and there are as many val as tags ready for interpreting
@@ -49,10 +51,26 @@ private:
     unsigned int cur_index;                //the current index
     std::vector<std::string> tag_sequence; //the sequence of tags in an xml template
     std::vector<std::string> val_sequence; //the sequence of values for reading an xml template
+    std::vector<size_t> binlen_sequence;   //the binary length of every tag
     size_t char_len;                       //the total binary length including the 2 char head
 };
 
 
+//where the records of a savegame written to a buffer are
+struct SaveRecord
+{
+    int index;      //world index of the tile or construction
+    size_t end;     //offset after the record, it begins where the previous one ends
+};
+
+struct SaveLayout
+{
+    size_t tilesBegin;
+    size_t constructionsBegin;
+    std::vector<SaveRecord> tiles;
+    std::vector<SaveRecord> constructions;
+};
+
 class XMLloadsave
 {
 public:
@@ -60,9 +78,19 @@ public:
     ~XMLloadsave();
     int saveXMLfile(std::string xml_file_name);
     int loadXMLfile(std::string xml_file_name);
+    //same as a file without compression, with since > 0 only the tiles changed since that generation of World
+    int saveXMLbuffer(std::string &buffer, SaveLayout *layout = NULL, int since = 0);
+    int loadXMLbuffer(const std::string &buffer);
+    int read(void *data, unsigned len);            //reads binary data from the file or buffer
+    int skip(unsigned len);                        //reads and drops binary data
 private:
     std::ostringstream xml_file_out;
     gzFile gz_xml_file;
+    std::string *buffer_out;         //saving to memory if set
+    SaveLayout *buffer_layout;       //filled while saving to memory if set
+    int buffer_since;                //generation of World the saved tiles changed since
+    const std::string *buffer_in;    //loading from memory if set
+    size_t buffer_pos;
     XMLTemplate * cur_template;
     std::map <std::string, XMLTemplate*>::iterator template_it;
     std::string line, xml_tag, xml_val;
@@ -80,7 +108,11 @@ private:
     int mapTileCount;
     int altered_tiles;
     int totalConstructions;
+    std::vector<Construction *> loadedConstructions; //created while loading, placed afterwards
 
+    void saveXML();                  //writes the savegame to file or buffer
+    int loadXML();                   //reads the savegame from file or buffer
+    bool at_end();                   //true at the end of file or buffer
     bool no_Section();               //true if not inside global mapTile or constructionSection
     void clearXMLlibary();           //clears all previous template definitions
     void fillXMLlibary();            //creates all templates needed for current mode
@@ -93,10 +125,19 @@ private:
     void loadTileTemplates();        //reads an construction from a stream of binary data
     void loadConstructions();        //reads constructions and template definitions from xml_file_in
     void loadConstructionTemplates();//reads an construction from a stream of binary data
+    void createConstruction(unsigned short group, int x, int y); //creates a construction to be placed later
+    void placeConstructions();       //places all loaded constructions in one sweep over the map
     void readTemplateSection();      //reads the optional dedicated TemplateSection
     void readPbar();                 //reads a Pbar (inside GlobalSection)
     void readArray(int ary[], int max_len, int len); //reads an array of ints <int>%d</int>
-    void writeArray(std::string aryname, int ary[], int len);
+    void writeArray(std::string aryname, int ary[], int len, int per_line = 0); //0 for one line
+
+    void writeStatsHistory();        //writes statsHistory (inside GlobalSection)
+    void readStatsHistory();         //reads statsHistory
+    void readStatsSeries();          //reads one resolution of statsHistory
+    enum { MONTHGRAPH_POP, MONTHGRAPH_STARVE, MONTHGRAPH_NOJOBS, MONTHGRAPH_PPOOL, MONTHGRAPH_COUNT };
+    void readMonthgraph(std::vector<int> &graph, int len); //reads a history graph of old saves
+    void migrateMonthgraph(const std::vector<int> *monthgraph); //turns them into monthly statsHistory
 
     void writePollution();           //writes Air pollution to file
     void readPollution();            //reads Air pollution from file
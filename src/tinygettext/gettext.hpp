@@ -5,17 +5,38 @@
 
 extern tinygettext::DictionaryManager* dictionaryManager;
 
-#ifdef NEED_GETTEXT_CHARHACK
-static inline char* _(const char* message)
+/** The translation of any string, looked up every time. */
+static inline const char* translated(const char* message)
 {
-    return const_cast<char*>
-        (dictionaryManager->get_dictionary().translate(message));
+    return dictionaryManager->get_dictionary().translate(message);
 }
-#else
-static inline const char* _(const char* message)
+
+/** A translation kept by its caller until the dictionary changes. */
+struct CachedTranslation
 {
-    return dictionaryManager->get_dictionary().translate(message);
+    unsigned int revision;
+    const char* msgstr;
+};
+
+static inline const char* translated(CachedTranslation& cache, const char* message)
+{
+    if (cache.revision != dictionaryManager->get_revision()) {
+        cache.msgstr = translated(message);
+        cache.revision = dictionaryManager->get_revision();
+    }
+    return cache.msgstr;
 }
+
+/* _() only takes string literals. Every call site keeps its translation,
+   so texts drawn each frame cost a compare instead of a lookup. */
+#define GETTEXT_CACHED(message) \
+    ([]() -> const char* { \
+        static CachedTranslation cache = { 0, 0 }; \
+        return translated(cache, "" message); }())
+#ifdef NEED_GETTEXT_CHARHACK
+#define _(message) const_cast<char*>(GETTEXT_CACHED(message))
+#else
+#define _(message) GETTEXT_CACHED(message)
 #endif
 
 #define N_(s)      s
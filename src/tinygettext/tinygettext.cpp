@@ -22,9 +22,12 @@
 #include <sys/types.h>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <algorithm>
+#include <iterator>
 #include <ctype.h>
 #include <errno.h>
+#include <stdint.h>
 
 #include "SDL.h"
 
@@ -193,7 +196,7 @@ get_language_def(const std::string& name)
 }
 
 DictionaryManager::DictionaryManager()
-  : current_dict(&empty_dict)
+  : current_dict(&empty_dict), revision(1)
 {
   parseLocaleAliases();
   // Environment variable LINCITY_LANG overrides language settings.
@@ -307,8 +310,7 @@ DictionaryManager::get_dictionary(const std::string& spec)
                   //log_debug << "Loading dictionary for language \"" << lang << "\" from \"" << filename << "\"" << std::endl;
                   std::string pofile = *p + "/" + *filename;
                   try {
-                      IFileStream in(pofile);
-                      read_po_file(dict, in);
+                      load_po_file(dict, pofile);
                   } catch(std::exception& e) {
                       std::cerr << "Error: Failure file opening: " << pofile << std::endl;
                       std::cerr << e.what() << "\n";
@@ -323,6 +325,55 @@ DictionaryManager::get_dictionary(const std::string& spec)
     }
 }
 
+// modification time and size of a .po, its catalog has to match them exactly
+static std::string po_stamp(const std::string& pofile)
+{
+  std::ostringstream stamp;
+  stamp << PHYSFS_getLastModTime(pofile.c_str()) << " ";
+  PHYSFS_file* file = PHYSFS_openRead(pofile.c_str());
+  if (file)
+    {
+      stamp << PHYSFS_fileLength(file);
+      PHYSFS_close(file);
+    }
+  else
+    stamp << -1;
+  return stamp.str();
+}
+
+void
+DictionaryManager::load_po_file(Dictionary& dict, const std::string& pofile)
+{
+  std::string mofile = pofile.substr(0, pofile.length() - 3) + ".mo";
+  std::string stamp = po_stamp(pofile);
+  if (PHYSFS_exists(mofile.c_str()))
+    {
+      try {
+        IFileStream in(mofile);
+        if (read_mo_file(dict, in, stamp))
+          return;
+      } catch(std::exception& e) {
+        std::cerr << e.what() << "\n";
+      }
+      std::cerr << "Warning: ignoring stale or broken catalog " << mofile << std::endl;
+    }
+
+  IFileStream in(pofile);
+  read_po_file(dict, in);
+
+  // compile it into the write directory, so the next start can skip parsing
+  std::string dir = pofile.substr(0, pofile.rfind('/'));
+  if (PHYSFS_getWriteDir() != 0 && PHYSFS_mkdir(dir.c_str()))
+    {
+      try {
+        OFileStream out(mofile);
+        write_mo_file(dict, out, stamp);
+      } catch(std::exception& e) {
+        std::cerr << "Warning: Couldn't write " << mofile << ": " << e.what() << std::endl;
+      }
+    }
+}
+
 std::set<std::string>
 DictionaryManager::get_languages()
 {
@@ -356,6 +407,7 @@ DictionaryManager::set_language(const std::string& lang)
   language = get_language_from_spec(lang);
   //log_debug << "==> \"" << language << "\"" << std::endl;
   current_dict = & (get_dictionary(language));
+  ++revision;
 }
 
 const std::string&
@@ -787,6 +839,194 @@ void read_po_file(Dictionary& dict_, std::istream& in)
   POFileReader reader(in, dict_);
 }
 
+//---------------------------------------------------------------------------
+// GNU .mo catalogs: a header of 32 bit words, two tables with the length and
+// offset of every msgid and msgstr, then the NUL terminated strings.
+
+static const uint32_t mo_magic = 0x950412de;
+static const uint32_t mo_magic_swapped = 0xde120495;
+static const uint32_t mo_header_size = 28;
+
+static uint32_t mo_word(const std::string& data, size_t pos, bool swapped)
+{
+  uint32_t value;
+  memcpy(&value, data.data() + pos, sizeof(value));
+  if (swapped)
+    value = (value >> 24) | ((value >> 8) & 0xff00)
+      | ((value << 8) & 0xff0000) | (value << 24);
+  return value;
+}
+
+static bool mo_string(const std::string& data, uint32_t table, uint32_t i,
+                      bool swapped, std::string& str)
+{
+  uint32_t len = mo_word(data, table + 8 * i, swapped);
+  uint32_t offset = mo_word(data, table + 8 * i + 4, swapped);
+  if ((uint64_t) offset + len >= data.size() || data[offset + len] != 0)
+    return false;
+  str.assign(data, offset, len);
+  return true;
+}
+
+static void mo_put(std::ostream& out, uint32_t value)
+{
+  out.write((const char*) &value, sizeof(value));
+}
+
+bool read_mo_file(Dictionary& dict, std::istream& in, const std::string& source)
+{
+  std::string data((std::istreambuf_iterator<char>(in)),
+                   std::istreambuf_iterator<char>());
+  if (data.size() < mo_header_size)
+    return false;
+
+  uint32_t magic = mo_word(data, 0, false);
+  bool swapped = (magic == mo_magic_swapped);
+  if (magic != mo_magic && !swapped)
+    return false;
+  uint32_t count = mo_word(data, 8, swapped);
+  uint32_t originals = mo_word(data, 12, swapped);
+  uint32_t translations = mo_word(data, 16, swapped);
+  if ((uint64_t) originals + 8 * (uint64_t) count > data.size()
+      || (uint64_t) translations + 8 * (uint64_t) count > data.size())
+    return false;
+
+  // check all strings before anything goes into the dictionary
+  std::vector<std::pair<std::string, std::string> > strings(count);
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      if (!mo_string(data, originals, i, swapped, strings[i].first)
+          || !mo_string(data, translations, i, swapped, strings[i].second))
+        return false;
+    }
+
+  std::string from_charset;
+  std::string to_charset = dict.get_charset();
+  std::string stamp;
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      if (!strings[i].first.empty())
+        continue;
+      const std::string& header = strings[i].second;
+      const std::string key = "Content-Type: text/plain; charset=";
+      std::string::size_type pos = header.find(key);
+      if (pos != std::string::npos)
+        {
+          pos += key.length();
+          from_charset = header.substr(pos, header.find('\n', pos) - pos);
+        }
+      const std::string source_key = "X-Source-Stamp: ";
+      pos = header.find(source_key);
+      if (pos != std::string::npos)
+        {
+          pos += source_key.length();
+          stamp = header.substr(pos, header.find('\n', pos) - pos);
+        }
+    }
+  if (!source.empty() && stamp != source)
+    return false;
+  if (from_charset.empty())
+    from_charset = to_charset;
+  if (to_charset.empty())
+    {
+      dict.set_charset(from_charset);
+      to_charset = from_charset;
+    }
+
+  for (uint32_t i = 0; i < count; ++i)
+    {
+      const std::string& msgid = strings[i].first;
+      const std::string& msgstr = strings[i].second;
+      if (msgid.empty())
+        continue;
+      std::string::size_type nul = msgid.find('\0');
+      if (nul == std::string::npos)
+        {
+          dict.add_translation(msgid, convert(msgstr, from_charset, to_charset));
+          continue;
+        }
+      // plural forms are separated by NUL, in msgid as well as in msgstr
+      std::map<int, std::string> msgstrs;
+      std::string::size_type start = 0;
+      for (int num = 0; start <= msgstr.length(); ++num)
+        {
+          std::string::size_type end = msgstr.find('\0', start);
+          if (end == std::string::npos)
+            end = msgstr.length();
+          if (end > start)
+            msgstrs[num] = convert(msgstr.substr(start, end - start),
+                                   from_charset, to_charset);
+          start = end + 1;
+        }
+      dict.add_translation(msgid.substr(0, nul), msgid.substr(nul + 1), msgstrs);
+    }
+  return true;
+}
+
+void write_mo_file(const Dictionary& dict, std::ostream& out, const std::string& source)
+{
+  // sorted like msgfmt does it
+  std::map<std::string, std::string> strings;
+  strings[""] = "Content-Type: text/plain; charset=" + dict.charset + "\n";
+  if (!source.empty())
+    strings[""] += "X-Source-Stamp: " + source + "\n";
+  for (Dictionary::Entries::const_iterator i = dict.entries.begin();
+       i != dict.entries.end(); ++i)
+    {
+      if (!i->first.empty() && !i->second.empty())
+        strings[i->first] = i->second;
+    }
+  for (Dictionary::PluralEntries::const_iterator i = dict.plural_entries.begin();
+       i != dict.plural_entries.end(); ++i)
+    {
+      if (i->second.empty())
+        continue;
+      // the plural msgid isn't kept, only the singular one is looked up
+      std::string msgstr;
+      int forms = i->second.rbegin()->first + 1;
+      for (int num = 0; num < forms; ++num)
+        {
+          if (num > 0)
+            msgstr += '\0';
+          std::map<int, std::string>::const_iterator form = i->second.find(num);
+          if (form != i->second.end())
+            msgstr += form->second;
+        }
+      strings[i->first + '\0'] = msgstr;
+    }
+
+  uint32_t count = strings.size();
+  uint32_t originals = mo_header_size;
+  uint32_t translations = originals + 8 * count;
+  uint32_t offset = translations + 8 * count;
+
+  mo_put(out, mo_magic);
+  mo_put(out, 0); // revision
+  mo_put(out, count);
+  mo_put(out, originals);
+  mo_put(out, translations);
+  mo_put(out, 0); // no hash table
+  mo_put(out, offset);
+
+  std::map<std::string, std::string>::iterator i;
+  for (i = strings.begin(); i != strings.end(); ++i)
+    {
+      mo_put(out, i->first.length());
+      mo_put(out, offset);
+      offset += i->first.length() + 1;
+    }
+  for (i = strings.begin(); i != strings.end(); ++i)
+    {
+      mo_put(out, i->second.length());
+      mo_put(out, offset);
+      offset += i->second.length() + 1;
+    }
+  for (i = strings.begin(); i != strings.end(); ++i)
+    out.write(i->first.c_str(), i->first.length() + 1);
+  for (i = strings.begin(); i != strings.end(); ++i)
+    out.write(i->second.c_str(), i->second.length() + 1);
+}
+
 } // namespace TinyGetText
 
 /* EOF */
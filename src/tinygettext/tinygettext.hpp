@@ -21,9 +21,11 @@
 #define HEADER_TINYGETTEXT_H
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <set>
 #include <string>
+#include <iosfwd>
 
 namespace tinygettext {
 
@@ -46,10 +48,10 @@ struct LanguageDef {
 class Dictionary
 {
 private:
-  typedef std::map<std::string, std::string> Entries;
+  typedef std::unordered_map<std::string, std::string> Entries;
   Entries entries;
 
-  typedef std::map<std::string, std::map<int, std::string> > PluralEntries;
+  typedef std::unordered_map<std::string, std::map<int, std::string> > PluralEntries;
   PluralEntries plural_entries;
 
   LanguageDef language;
@@ -79,7 +81,8 @@ public:
 
   /** Translate the string \a msgid. */
   std::string translate(const std::string& msgid);
-  /** Translate the string \a msgid. */
+  /** Translate the string \a msgid. The result stays valid as long as
+      the dictionary isn't changed. */
   const char* translate(const char* msgid);
 
   /** Add a translation from \a msgid to \a msgstr to the dictionary,
@@ -93,6 +96,8 @@ public:
   /** Add a translation from \a msgid to \a msgstr to the
       dictionary */
   void add_translation(const std::string& msgid, const std::string& msgstr);
+
+  friend void write_mo_file(const Dictionary& dict, std::ostream& out, const std::string& source);
 };
 
 /** Manager class for dictionaries, you give it a bunch of directories
@@ -111,6 +116,7 @@ private:
   std::string language;
   Dictionary* current_dict;
   Dictionary empty_dict;
+  unsigned int revision;
 
 public:
   DictionaryManager();
@@ -126,6 +132,11 @@ public:
   /** Set a language based on a four? letter country code */
   void set_language(const std::string& langspec);
 
+  /** Changes whenever the current dictionary does, translations kept
+      by the callers are stale then */
+  unsigned int get_revision() const
+  { return revision; }
+
   /** returns the (normalized) country code of the currently used language */
   const std::string& get_language() const;
 
@@ -143,6 +154,8 @@ public:
 
 private:
   void parseLocaleAliases();
+  /// load \a pofile into \a dict, through its compiled catalog if it is current
+  void load_po_file(Dictionary& dict, const std::string& pofile);
   /// returns the language part in a language spec (like de_DE.UTF-8 -> de)
   std::string get_language_from_spec(const std::string& spec);
 };
@@ -150,6 +163,12 @@ private:
 /** Read the content of the .po file given as \a in into the
     dictionary given as \a dict */
 void read_po_file(Dictionary& dict, std::istream& in);
+/** Read a compiled gettext .mo catalog, returns false if \a in isn't one
+    or, given a \a source stamp, wasn't compiled from that source */
+bool read_mo_file(Dictionary& dict, std::istream& in, const std::string& source = "");
+/** Write all translations of \a dict as a .mo catalog, noting the
+    \a source stamp in its header */
+void write_mo_file(const Dictionary& dict, std::ostream& out, const std::string& source = "");
 LanguageDef& get_language_def(const std::string& name);
 
 } // namespace TinyGetText